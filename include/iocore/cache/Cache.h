@@ -30,6 +30,8 @@
 #include "iocore/cache/Store.h"
 #include "iocore/cache/HttpConfigAccessor.h"
 
+#include <string_view>
+
 static constexpr ts::ModuleVersion CACHE_MODULE_VERSION(1, 0);
 
 #define CACHE_WRITE_OPT_OVERWRITE      0x0001
@@ -60,6 +62,13 @@ using CacheHTTPHdr  = HTTPHdr;
 using CacheURL      = URL;
 using CacheHTTPInfo = HTTPInfo;
 
+/// The outcome of a purge through the purge index.
+struct CachePurgeResult {
+  int64_t    indexed = 0; ///< Objects the purge index had.
+  int64_t    purged  = 0; ///< Objects found in the cache and removed.
+  ink_hrtime time    = 0; ///< Time taken.
+};
+
 struct CacheProcessor : public Processor {
   CacheProcessor()
     : min_stripe_version(CACHE_DB_MAJOR_VERSION, CACHE_DB_MINOR_VERSION),
@@ -116,6 +125,21 @@ struct CacheProcessor : public Processor {
   */
   bool has_online_storage() const;
 
+  /** Purge the objects written with the surrogate key @a tag.
+
+      The objects are found in the purge index and their directory entries
+      deleted, without reading them from disk.
+
+      @return @c false if the purge index is not enabled.
+  */
+  bool purge_surrogate_key(std::string_view tag, CachePurgeResult &result);
+
+  /** Purge the objects with URLs starting with @a prefix.
+
+      The scheme and port of @a prefix are ignored, see @c purge_surrogate_key.
+  */
+  bool purge_url_prefix(std::string_view prefix, CachePurgeResult &result);
+
   static int IsCacheEnabled();
 
   static bool IsCacheReady(CacheFragType type);
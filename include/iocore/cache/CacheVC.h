@@ -42,6 +42,7 @@
 
 class Stripe;
 class HttpConfigAccessor;
+class CacheFanout;
 
 struct CacheVC : public CacheVConnection {
   CacheVC();
@@ -237,7 +238,8 @@ struct CacheVC : public CacheVConnection {
   Ptr<IOBufferBlock>  blocks; // data available to write
   Ptr<IOBufferBlock>  writer_buf;
 
-  OpenDirEntry       *od = nullptr;
+  OpenDirEntry       *od     = nullptr;
+  CacheFanout        *fanout = nullptr; // fragments shared by a writer with its readers
   AIOCallbackInternal io;
   int                 alternate_index = CACHE_ALT_INDEX_DEFAULT; // preferred position in vector
   LINK(CacheVC, opendir_link);
@@ -255,11 +257,12 @@ struct CacheVC : public CacheVConnection {
   CacheHTTPInfo            *info;
   CacheHTTPInfoVector      *write_vector;
   const HttpConfigAccessor *params;
-  int                       header_len;   // for communicating with agg_copy
-  int                       frag_len;     // for communicating with agg_copy
-  uint32_t                  write_len;    // for communicating with agg_copy
-  uint32_t                  agg_len;      // for communicating with aggWrite
-  uint32_t                  write_serial; // serial of the final write for SYNC
+  int                       header_len;    // for communicating with agg_copy
+  int                       frag_len;      // for communicating with agg_copy
+  uint32_t                  write_len;     // for communicating with agg_copy
+  uint32_t                  agg_len;       // for communicating with aggWrite
+  uint32_t                  write_serial;  // serial of the final write for SYNC
+  int                       fragment_size; // data in a fragment of this object, chosen as it is first written
   StripeSM                 *stripe;
   Dir                      *last_collision;
   Event                    *trigger;
@@ -57,6 +57,13 @@ public:
   static float calculate_quality_of_match(const HttpConfigAccessor *http_config_params, HTTPHdr *client_request,
                                           HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response);
 
+  static float calculate_quality_of_accept_headers(const HttpConfigAccessor *http_config_params, HTTPHdr *client_request,
+                                                   HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response);
+
+  static uint32_t calculate_vary_fingerprint(HTTPHdr *request, HTTPHdr *response);
+
+  static uint32_t calculate_alternate_vary_fingerprint(HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response);
+
   static float calculate_quality_of_accept_match(MIMEField *accept_field, MIMEField *content_field);
 
   static float calculate_quality_of_accept_charset_match(MIMEField *accept_field, MIMEField *content_field,
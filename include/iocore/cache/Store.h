@@ -81,6 +81,7 @@ struct Span {
   span_diskid_t disk_id;
   int           forced_volume_num = -1;    ///< Force span in to specific volume.
   bool          file_pathname     = false; // the pathname is a file
+  bool          fast_tier         = false; ///< Span is in the fast storage tier.
   // v- used as a magic location for copy constructor.
   // we memcpy everything before this member and do explicit assignment for the rest.
   ats_scoped_str pathname;
@@ -106,6 +107,8 @@ struct Span {
   void hash_base_string_set(const char *s);
   /// Set the volume number.
   void volume_number_set(int n);
+  /// Set the storage tier.
+  void tier_set(bool fast);
 
   Span() { disk_id[0] = disk_id[1] = 0; }
 
@@ -166,6 +169,7 @@ struct Store {
   /// Additional configuration key values.
   static const char VOLUME_KEY[];
   static const char HASH_BASE_STRING_KEY[];
+  static const char TIER_KEY[];
 };
 
 // store either free or in the cache, can be stolen for reconfiguration
@@ -345,6 +345,10 @@ public:
 
   unsigned int event_types = 0;
 
+  /// The thread group this thread steals work in, if the group does.
+  static constexpr EventType NO_STEAL_GROUP = -1;
+  EventType                  steal_group    = NO_STEAL_GROUP;
+
   bool is_event_type(EventType et);
   void set_event_type(EventType et);
 
@@ -354,6 +358,8 @@ public:
   void             execute_regular();
   void             process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_count);
   void             process_event(Event *e, int calling_code);
+  void             process_ready();
+  bool             steal_event();
   void             free_event(Event *e);
   LoopTailHandler *tail_cb = &DEFAULT_TAIL_HANDLER;
 
@@ -390,7 +396,9 @@ public:
     int
     waitForActivity(ink_hrtime timeout) override
     {
-      _q.wait(ink_get_hrtime() + timeout);
+      ink_hrtime start = ink_get_hrtime();
+      _q.wait(start + timeout);
+      this_ethread_ptr->metrics.record_idle_time(ink_get_hrtime() - start);
       return 0;
     }
     void
@@ -432,8 +440,9 @@ public:
         Events() {}
       } _events;
 
-      int _count = 0; ///< # of times the loop executed.
-      int _wait  = 0; ///< # of timed wait for events
+      int        _count = 0; ///< # of times the loop executed.
+      int        _wait  = 0; ///< # of timed wait for events
+      ink_hrtime _idle  = 0; ///< Time spent waiting for activity.
 
       /** Record the loop start time.
        *
@@ -524,6 +533,23 @@ public:
      */
     self_type &record_api_time(ink_hrtime delta);
 
+    /** Record time the loop spent waiting for activity.
+     *
+     * @param delta Duration of the wait.
+     * @return @a this
+     */
+    self_type &record_idle_time(ink_hrtime delta);
+
+    /** How busy the thread was in the last complete slice.
+     *
+     * This is the part of the slice the loop was not waiting for activity, in thousandths. A thread that has not
+     * finished a loop for a couple of slices is taken to be fully busy. This may be called from other threads, the
+     * value is then approximate.
+     *
+     * @return The busy time in thousandths of the slice, 0 if there is no data yet.
+     */
+    int busy_permille();
+
     /// Do any accumulated data decay that's required.
     self_type &decay();
 
@@ -628,6 +654,15 @@ EThread::Metrics::record_api_time(ink_hrtime delta) -> self_type &
   return *this;
 }
 
+inline auto
+EThread::Metrics::record_idle_time(ink_hrtime delta) -> self_type &
+{
+  if (Slice *slice = current_slice.load(std::memory_order_acquire); slice && delta > 0) {
+    slice->_idle += delta;
+  }
+  return *this;
+}
+
 inline auto
 EThread::Metrics::decay() -> self_type &
 {
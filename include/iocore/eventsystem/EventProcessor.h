@@ -27,6 +27,7 @@
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/Processor.h"
 #include "iocore/eventsystem/Event.h"
+#include "tsutil/Metrics.h"
 #include <atomic>
 
 #ifdef TS_MAX_THREADS_IN_EACH_THREAD_TYPE
@@ -131,6 +132,17 @@ public:
   /// This registers @a name as an event type using @c registerEventType and then calls the real @c spawn_event_threads
   EventType spawn_event_threads(const char *name, int n_thread, size_t stacksize = DEFAULT_STACKSIZE);
 
+  /** Let the threads of the group @a ev_type steal work from each other.
+
+      A thread that is idle takes an immediate event queued on a busy thread of the group and runs
+      it, so that a long running event does not hold up the events queued behind it. Such an event
+      can run on any thread of the group, and out of order with the events sent to the same thread.
+      This is only for groups whose events have no need of a particular thread, so not for ET_NET.
+
+      This must be called before @c spawn_event_threads for @a ev_type.
+   */
+  void enable_work_stealing(EventType ev_type);
+
   /**
     Schedules the continuation on a specific EThread to receive an event
     at the given timeout.  Requests the EventProcessor to schedule
@@ -298,6 +310,10 @@ public:
     Que(Event, link) _spawnQueue;                                 ///< Events to dispatch when thread is spawned.
     EThread              *_thread[MAX_THREADS_IN_EACH_TYPE] = {}; ///< The actual threads in this group.
     std::function<void()> _afterStartCallback               = nullptr;
+
+    bool                              _work_stealing = false;   ///< Idle threads steal events from busy ones.
+    ts::Metrics::Gauge::AtomicType   *_queued        = nullptr; ///< # of events taken in and not yet run, if stealing.
+    ts::Metrics::Counter::AtomicType *_steals        = nullptr; ///< # of events run by a thread they were not sent to.
   };
 
   /// Storage for per group data.
@@ -119,6 +119,9 @@ extern FreelistAllocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
 void init_buffer_allocators(int iobuffer_advice, int chunk_sizes[DEFAULT_BUFFER_SIZES], bool use_hugepages);
 void init_buffer_allocators(int iobuffer_advice);
 
+/** Refresh the per size class memory gauges of the IO buffer allocators. */
+void update_buffer_allocator_metrics();
+
 bool parse_buffer_chunk_sizes(const char *s, int chunk_sizes[DEFAULT_BUFFER_SIZES]);
 
 /**
@@ -1215,12 +1218,42 @@ public:
   clear()
   {
     dealloc();
-    size_index = BUFFER_SIZE_NOT_ALLOCATED;
-    water_mark = 0;
+    size_index           = BUFFER_SIZE_NOT_ALLOCATED;
+    adaptive_start_index = BUFFER_SIZE_NOT_ALLOCATED;
+    adaptive_max_index   = BUFFER_SIZE_NOT_ALLOCATED;
+    water_mark           = 0;
   }
 
+  /**
+    Let the block size of this buffer grow with the observed throughput.
+
+    The buffer keeps allocating blocks of the current size_index. When a new block is needed while
+    the readers are still holding at least a full block of unconsumed data the producer is outrunning
+    the consumers, so the next block is allocated one size class larger, up to @a max_index.
+    release_idle_blocks() resets the size back to the one the buffer started with.
+
+    @param max_index largest size index the buffer may grow to.
+  */
+  void set_adaptive_size_index(int64_t max_index);
+
+  /**
+    Return the blocks of an idle buffer to the allocator.
+
+    If none of the readers has unconsumed data, the block chain is dropped and the readers are reset.
+    The next write allocates a fresh block. This is meant for buffers that are kept around while the
+    connection is idle, so they do not pin a (possibly large) block for the duration.
+
+    @return @c true if blocks were released.
+  */
+  bool release_idle_blocks();
+
   int64_t size_index;
 
+  /// Size index the buffer started with when adaptive sizing is enabled.
+  int64_t adaptive_start_index;
+  /// Largest size index adaptive sizing may grow to, BUFFER_SIZE_NOT_ALLOCATED if disabled.
+  int64_t adaptive_max_index;
+
   /**
     Determines when to stop writing or reading. The watermark is the
     level to which the producer (filler) is required to fill the buffer
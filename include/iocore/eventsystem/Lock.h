@@ -26,10 +26,14 @@
 #include "tscore/ink_platform.h"
 #include "tscore/Diags.h"
 #include "iocore/eventsystem/Thread.h"
+#include "iocore/eventsystem/LockProfiler.h"
 
 #define MAX_LOCK_TIME               HRTIME_MSECONDS(200)
 #define THREAD_MUTEX_THREAD_HOLDING (-1024 * 1024)
 
+/// File and line a lock is taken at, for @c LockProfiler.
+#define LOCK_SITE __FILE__ ":" TS_STR(__LINE__)
+
 /*------------------------------------------------------*\
 |  Macros                                                |
 \*------------------------------------------------------*/
@@ -51,15 +55,15 @@
 
 // A weak version of the SCOPED_MUTEX_LOCK macro, allows the mutex to be a nullptr.
 #ifdef DEBUG
-#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t);
+#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE);
 #else // DEBUG
-#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(_m, _t);
+#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(_m, _t, LOCK_SITE);
 #endif // DEBUG
 
 #ifdef DEBUG
-#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t)
+#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE)
 #else // DEBUG
-#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(_m, _t)
+#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(_m, _t, LOCK_SITE)
 #endif // DEBUG
 
 /**
@@ -77,15 +81,15 @@
 */
 
 #ifdef DEBUG
-#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t);
+#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE);
 #else // DEBUG
-#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(_m, _t);
+#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(_m, _t, LOCK_SITE);
 #endif // DEBUG
 
 #ifdef DEBUG
-#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t)
+#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE)
 #else // DEBUG
-#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(_m, _t)
+#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(_m, _t, LOCK_SITE)
 #endif // DEBUG
 
 /**
@@ -105,15 +109,15 @@
 /////////////////////////////////////
 // DEPRECATED DEPRECATED DEPRECATED
 #ifdef DEBUG
-#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(MakeSourceLocation(), (char *)nullptr, _m, _t)
+#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE)
 #else
-#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(_m, _t)
+#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(_m, _t, LOCK_SITE)
 #endif
 
 #ifdef DEBUG
-#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(MakeSourceLocation(), (char *)nullptr, _m, _t)
+#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(MakeSourceLocation(), (char *)nullptr, _m, _t, LOCK_SITE)
 #else
-#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(_m, _t)
+#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(_m, _t, LOCK_SITE)
 #endif // DEBUG
 
 #define MUTEX_UNTAKE_LOCK(_m, _t) Mutex_unlock(_m, _t)
@@ -179,6 +183,12 @@ public:
 
   int nthread_holding;
 
+  /// Kind of lock, for @c LockProfiler. A static string, or nullptr.
+  const char *lock_class = nullptr;
+
+  /// Where the lock was last taken while @c LockProfiler was enabled.
+  std::atomic<const char *> holder_site{nullptr};
+
 #ifdef DEBUG
   ink_hrtime     hold_time;
   SourceLocation srcloc;
@@ -254,12 +264,15 @@ Mutex_trylock(
 #ifdef DEBUG
   const SourceLocation &location, const char *ahandler,
 #endif
-  ProxyMutex *m, EThread *t)
+  ProxyMutex *m, EThread *t, const char *site = nullptr)
 {
   ink_assert(t != nullptr);
   ink_assert(t == reinterpret_cast<EThread *>(this_thread()));
   if (m->thread_holding != t) {
     if (!ink_mutex_try_acquire(&m->the_mutex)) {
+      if (unlikely(LockProfiler::enabled())) {
+        LockProfiler::try_failed(m, site);
+      }
 #ifdef DEBUG
       lock_waiting(m->srcloc, m->handler);
 #ifdef LOCK_CONTENTION_PROFILING
@@ -271,6 +284,9 @@ Mutex_trylock(
 #endif // DEBUG
       return false;
     }
+    if (unlikely(LockProfiler::enabled())) {
+      m->holder_site.store(site, std::memory_order_relaxed);
+    }
     m->thread_holding = t;
 #ifdef DEBUG
     m->srcloc    = location;
@@ -298,13 +314,13 @@ Mutex_trylock(
 #ifdef DEBUG
   const SourceLocation &location, const char *ahandler,
 #endif
-  Ptr<ProxyMutex> &m, EThread *t)
+  Ptr<ProxyMutex> &m, EThread *t, const char *site = nullptr)
 {
   return Mutex_trylock(
 #ifdef DEBUG
     location, ahandler,
 #endif
-    m.get(), t);
+    m.get(), t, site);
 }
 
 inline int
@@ -312,11 +328,15 @@ Mutex_lock(
 #ifdef DEBUG
   const SourceLocation &location, const char *ahandler,
 #endif
-  ProxyMutex *m, EThread *t)
+  ProxyMutex *m, EThread *t, const char *site = nullptr)
 {
   ink_assert(t != nullptr);
   if (m->thread_holding != t) {
-    ink_mutex_acquire(&m->the_mutex);
+    if (likely(!LockProfiler::enabled())) {
+      ink_mutex_acquire(&m->the_mutex);
+    } else {
+      LockProfiler::acquire(m, site);
+    }
     m->thread_holding = t;
     ink_assert(m->thread_holding);
 #ifdef DEBUG
@@ -344,13 +364,13 @@ Mutex_lock(
 #ifdef DEBUG
   const SourceLocation &location, const char *ahandler,
 #endif
-  Ptr<ProxyMutex> &m, EThread *t)
+  Ptr<ProxyMutex> &m, EThread *t, const char *site = nullptr)
 {
   return Mutex_lock(
 #ifdef DEBUG
     location, ahandler,
 #endif
-    m.get(), t);
+    m.get(), t, site);
 }
 
 inline void
@@ -396,7 +416,7 @@ public:
 #ifdef DEBUG
     const SourceLocation &location, const char *ahandler,
 #endif // DEBUG
-    Ptr<ProxyMutex> &am, EThread *t)
+    Ptr<ProxyMutex> &am, EThread *t, const char *site = nullptr)
     : m(am), locked_p(true)
   {
     if (m.get()) {
@@ -404,7 +424,7 @@ public:
 #ifdef DEBUG
         location, ahandler,
 #endif // DEBUG
-        m, t);
+        m, t, site);
     }
   }
 
@@ -449,14 +469,14 @@ public:
 #ifdef DEBUG
     const SourceLocation &location, const char *ahandler,
 #endif // DEBUG
-    Ptr<ProxyMutex> &am, EThread *t)
+    Ptr<ProxyMutex> &am, EThread *t, const char *site = nullptr)
     : m(am), locked_p(true)
   {
     Mutex_lock(
 #ifdef DEBUG
       location, ahandler,
 #endif // DEBUG
-      m, t);
+      m, t, site);
   }
 
   MutexLock(MutexLock &)                  = delete;
@@ -500,7 +520,7 @@ public:
 #ifdef DEBUG
     const SourceLocation &location, const char *ahandler,
 #endif // DEBUG
-    Ptr<ProxyMutex> &am, EThread *t)
+    Ptr<ProxyMutex> &am, EThread *t, const char *site = nullptr)
     : m(am)
   {
     if (m.get()) {
@@ -508,7 +528,7 @@ public:
 #ifdef DEBUG
         location, ahandler,
 #endif // DEBUG
-        m, t);
+        m, t, site);
     } else {
       lock_acquired = true;
     }
@@ -584,14 +604,14 @@ public:
 #ifdef DEBUG
     const SourceLocation &location, const char *ahandler,
 #endif // DEBUG
-    Ptr<ProxyMutex> &am, EThread *t)
+    Ptr<ProxyMutex> &am, EThread *t, const char *site = nullptr)
     : m(am)
   {
     lock_acquired = Mutex_trylock(
 #ifdef DEBUG
       location, ahandler,
 #endif // DEBUG
-      m, t);
+      m, t, site);
   }
 
   MutexTryLock(MutexTryLock &)                  = delete;
@@ -677,3 +697,18 @@ new_ProxyMutex()
   m->init();
   return m;
 }
+
+/**
+  Creates a new ProxyMutex object of a lock class.
+
+  @param lock_class The name @c LockProfiler reports the contention on
+    the mutex under, e.g. "cache.stripe". It must be a static string.
+
+*/
+inline ProxyMutex *
+new_ProxyMutex(const char *lock_class)
+{
+  ProxyMutex *m = new_ProxyMutex();
+  m->lock_class = lock_class;
+  return m;
+}
@@ -0,0 +1,122 @@
+/** @file
+
+  Sampling of the contention on ProxyMutex locks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "tscore/ink_hrtime.h"
+#include "tsutil/Histogram.h"
+
+class ProxyMutex;
+
+/** Sampler of the contention on @c ProxyMutex locks.
+
+    While it is enabled, it records the try locks that fail and the time spent waiting for blocking locks, by lock class
+    (see @c new_ProxyMutex), by the place the lock was wanted from and by the place the holder took it. The sites are
+    the file and line of the lock macros. One in @c sample_rate contended acquisitions is recorded, the counts are of
+    the samples.
+
+    While it is disabled, which is the default, the lock functions only check @c enabled. While it is enabled, they also
+    note the site of every acquisition on the mutex, so that a contender can tell who holds it.
+ */
+class LockProfiler
+{
+public:
+  /// Wait times, in microseconds, up to about 2 seconds.
+  using WaitHistogram = ts::Histogram<18, 2>;
+
+  /// Whether contention is recorded.
+  static bool
+  enabled()
+  {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+
+  static void set_enabled(bool enable);
+
+  /// Record one of every @a n contended acquisitions.
+  static void set_sample_rate(int n);
+
+  static int
+  sample_rate()
+  {
+    return _sample_rate.load(std::memory_order_relaxed);
+  }
+
+  /// Read the configuration, and follow its changes.
+  static void init();
+
+  /// Record that a try lock of @a m from @a site failed.
+  static void try_failed(ProxyMutex *m, const char *site);
+
+  /// Acquire @a m from @a site, recording the wait if there is one.
+  static void acquire(ProxyMutex *m, const char *site);
+
+  /// Contention on a lock class.
+  struct ClassReport {
+    std::string_view name;
+    uint64_t         try_failures = 0; ///< Sampled try locks that failed.
+    uint64_t         waits        = 0; ///< Sampled blocking locks that had to wait.
+    ink_hrtime       wait_time    = 0; ///< Total time of the sampled waits.
+    WaitHistogram    wait_histogram;
+  };
+
+  /// Contention between the place a lock was wanted from and the place it was held from.
+  struct SiteReport {
+    std::string_view lock_class;
+    std::string_view site;   ///< Where the lock was wanted.
+    std::string_view holder; ///< Where the holder took the lock, empty if unknown.
+    uint64_t         try_failures = 0;
+    uint64_t         waits        = 0;
+    ink_hrtime       wait_time    = 0;
+  };
+
+  struct Report {
+    std::vector<ClassReport> classes;     ///< Most contended first.
+    std::vector<SiteReport>  sites;       ///< Most contended first.
+    uint64_t                 dropped = 0; ///< Samples not kept by site, because there were too many sites.
+  };
+
+  /** The contention recorded since the last reset.
+
+      @param top The number of classes and of sites to report.
+   */
+  static Report report(size_t top);
+
+  /// Forget the contention recorded.
+  static void reset();
+
+  /// Lock class of the mutexes created without one.
+  static constexpr std::string_view UNCLASSIFIED = "unclassified";
+
+  /// The most sites that are kept.
+  static constexpr size_t MAX_SITES = 4096;
+
+private:
+  static inline std::atomic<bool> _enabled{false};
+  static inline std::atomic<int>  _sample_rate{1};
+};
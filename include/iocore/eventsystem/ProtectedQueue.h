@@ -29,11 +29,16 @@
   (2). In case the queue is empty, dequeue() sleeps for a specified
        amount of time, or until a new element is inserted, whichever
        is earlier
+  (3). When the thread group steals work, the immediate events taken in
+       by the thread wait in a ready queue until they are run, from which
+       the idle threads of the group can take them.
 
 
  ****************************************************************************/
 #pragma once
 
+#include <atomic>
+
 #include "tscore/ink_platform.h"
 #include "iocore/eventsystem/Event.h"
 struct ProtectedQueue {
@@ -45,10 +50,20 @@ struct ProtectedQueue {
   void   dequeue_external();       // Dequeue any external events.
   void   wait(ink_hrtime timeout); // Wait for @a timeout nanoseconds on a condition variable if there are no events.
 
+  // Work stealing, see EventProcessor::enable_work_stealing.
+  void   enqueue_ready(Event *e); // Safe when called from the same thread
+  Event *dequeue_ready();         // Safe when called from the same thread
+  Event *steal_ready();           // Take the oldest ready event, for another thread
+  Event *steal_external();        // Take an immediate external event, for another thread
+
   InkAtomicList al;
   ink_mutex     lock;
   ink_cond      might_have_data;
   Que(Event, link) localQueue;
 
+  ink_mutex        ready_lock;
+  Que(Event, link) readyQueue;
+  std::atomic<int> ready_count{0};
+
   ProtectedQueue();
 };
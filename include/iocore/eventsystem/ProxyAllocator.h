@@ -40,25 +40,43 @@ class EThread;
 
 extern int thread_freelist_high_watermark;
 extern int thread_freelist_low_watermark;
+extern int thread_freelist_adaptive;
 extern int cmd_disable_pfreelist;
 
 struct ProxyAllocator {
   int   allocated = 0;
   void *freelist  = nullptr;
 
+  /// Adapted upper bound on @a allocated, or 0 to use @c thread_freelist_high_watermark.
+  int limit = 0;
+  /// Allocations served from this cache (hits) or passed to the global allocator (misses) since the last freeup.
+  uint64_t hits   = 0;
+  uint64_t misses = 0;
+
   ProxyAllocator() {}
+
+  /// @return @c true if this cache holds more items than it may and should be drained with @c thread_freeup.
+  bool
+  is_full() const
+  {
+    return thread_freelist_high_watermark > 0 && allocated > (limit ? limit : thread_freelist_high_watermark);
+  }
 };
 
 template <class CAlloc, typename... Args>
 typename CAlloc::Value_type *
 thread_alloc(CAlloc &a, ProxyAllocator &l, Args &&...args)
 {
-  if (!cmd_disable_pfreelist && l.freelist) {
-    void *v    = l.freelist;
-    l.freelist = *reinterpret_cast<void **>(l.freelist);
-    --(l.allocated);
-    ::new (v) typename CAlloc::Value_type(std::forward<Args>(args)...);
-    return static_cast<typename CAlloc::Value_type *>(v);
+  if (!cmd_disable_pfreelist) {
+    if (l.freelist) {
+      void *v    = l.freelist;
+      l.freelist = *reinterpret_cast<void **>(l.freelist);
+      --(l.allocated);
+      ++(l.hits);
+      ::new (v) typename CAlloc::Value_type(std::forward<Args>(args)...);
+      return static_cast<typename CAlloc::Value_type *>(v);
+    }
+    ++(l.misses);
   }
   return a.alloc(std::forward<Args>(args)...);
 }
@@ -92,7 +110,7 @@ void thread_freeup(Allocator &a, ProxyAllocator &l);
       *(char **)_p    = (char *)_t->_a.freelist;                                                   \
       _t->_a.freelist = _p;                                                                        \
       _t->_a.allocated++;                                                                          \
-      if (thread_freelist_high_watermark > 0 && _t->_a.allocated > thread_freelist_high_watermark) \
+      if (_t->_a.is_full())                                                                        \
         thread_freeup(::_a.raw(), _t->_a);                                                         \
     } else {                                                                                       \
       ::_a.raw().free_void(_p);                                                                    \
@@ -38,3 +38,8 @@ int RecProcessStart();
 void RecProcess_set_raw_stat_sync_interval_ms(int ms);
 void RecProcess_set_config_update_interval_ms(int ms);
 void RecProcess_set_remote_sync_interval_ms(int ms);
+
+//-------------------------------------------------------------------------
+// Export the metrics to the file at path, as often as the raw stats sync
+//-------------------------------------------------------------------------
+void RecProcess_set_metrics_file(const char *path);
@@ -60,6 +60,12 @@ extern int net_accept_period;
 extern int net_retry_delay;
 extern int net_throttle_delay;
 
+// Release the buffers of connections put in the keep-alive queue.
+extern int net_park_idle_connections;
+
+// How accepted connections are placed on the net threads, see ConnectionPlacement::Policy.
+extern int net_connection_placement;
+
 extern std::string_view net_ccp_in;
 extern std::string_view net_ccp_out;
 
@@ -26,6 +26,7 @@
 #include <atomic>
 
 #include "tscore/List.h"
+#include "tscore/TimingWheel.h"
 #include "iocore/eventsystem/VIO.h"
 #include "iocore/eventsystem/EventSystem.h"
 #include "iocore/net/EventIO.h"
@@ -120,8 +121,13 @@ public:
   /** Whether the current timeout is a default inactivity timeout. */
   bool use_default_inactivity_timeout = false;
 
+  /** Whether this is in the timeout changed list of its NetHandler. */
+  std::atomic<bool> in_timeout_changed_list = false;
+
   LINK(NetEvent, open_link);
   LINK(NetEvent, cop_link);
+  TIMING_WHEEL_LINK(NetEvent, timeout_link);
+  SLINK(NetEvent, timeout_changed_link);
   LINKM(NetEvent, read, ready_link)
   SLINKM(NetEvent, read, enable_link)
   LINKM(NetEvent, write, ready_link)
@@ -28,6 +28,7 @@
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/EThread.h"
 #include "iocore/net/NetEvent.h"
+#include "tsutil/Metrics.h"
 
 //
 // NetHandler
@@ -108,6 +109,17 @@ public:
   uint32_t keep_alive_queue_size = 0;
   Que(NetEvent, active_queue_link) active_queue;
   uint32_t active_queue_size = 0;
+  /// NetEvents by the InactivityCop tick at which they are next checked, if the timer wheel is in use.
+  TimingWheelOf(NetEvent, timeout_link) timeout_wheel;
+  /// NetEvents whose timeouts were changed since the last InactivityCop run.
+  ASLL(NetEvent, timeout_changed_link) timeout_changed_list;
+  /// Length of an InactivityCop tick if @a timeout_wheel is in use, 0 otherwise.
+  ink_hrtime cop_tick = 0;
+  /// Number of NetEvents in @a open_list, read by other threads to place new connections.
+  std::atomic<uint32_t> open_connections{0};
+  /// Load of this thread, see @c ConnectionPlacement.
+  ts::Metrics::Gauge::AtomicType *busy_metric        = nullptr;
+  ts::Metrics::Gauge::AtomicType *connections_metric = nullptr;
 
   /// configuration settings for managing the active and keep-alive queues
   struct Config {
@@ -215,6 +227,28 @@ public:
    */
   void stopCop(NetEvent *ne);
 
+  /**
+    Start checking the timeouts of NetEvents with @a timeout_wheel.
+    Only be called before any NetEvent is handed to this NetHandler.
+
+    @param tick Interval between InactivityCop runs.
+   */
+  void start_timeout_wheel(ink_hrtime tick);
+  /**
+    File @a ne in @a timeout_wheel for the first InactivityCop tick at which one of its timeouts may
+    have expired. A NetEvent without any timeout is checked again after
+    @c TIMEOUT_WHEEL_RECHECK_TICKS ticks, so that the default inactivity timeout is applied to it.
+    Only be called when holding the mutex of this NetHandler.
+   */
+  void schedule_timeout(NetEvent *ne, ink_hrtime now);
+  /**
+    Note that the timeouts of @a ne were changed. If they were brought forward, @a ne is filed again
+    by the next InactivityCop run. This may be called without holding the mutex of this NetHandler.
+   */
+  void timeout_changed(NetEvent *ne);
+  /// Upper bound in ticks on the time between InactivityCop checks of a NetEvent.
+  static constexpr int TIMEOUT_WHEEL_RECHECK_TICKS = 64;
+
   // Signal the epoll_wait to terminate.
   void signalActivity() override;
 
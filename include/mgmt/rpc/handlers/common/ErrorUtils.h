@@ -45,6 +45,7 @@ enum Codes : unsigned int {
   SERVER        = 3000,
   STORAGE       = 4000,
   PLUGIN        = 5000,
+  CACHE         = 6000,
   // Add more here. Give enough space between jumps.
   GENERIC = 30000
 };
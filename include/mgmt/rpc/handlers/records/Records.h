@@ -23,22 +23,24 @@
 #include <string_view>
 #include <yaml-cpp/yaml.h>
 #include "tsutil/ts_errata.h"
+#include "mgmt/rpc/jsonrpc/ResponseWriter.h"
 
 namespace rpc::handlers::records
 {
 ///
-/// @brief Record lookups. This is a RPC function handler that retrieves a YAML::Node which will contain the result of a records
-/// lookup. @see RecRecord.
+/// @brief Record lookups. This is a streaming RPC function handler that writes the result of a records lookup as it finds the
+/// records. @see RecRecord.
 /// Incoming parameter is expected to be a sequence, params will be converted to a @see RequestRecordElement
-/// and the response will be a YAML node that contains the findings base on the query type. @see RequestRecordElement recTypes will
-/// lead the search.
+/// and the result will be a map that contains the findings base on the query type. @see RequestRecordElement recTypes will
+/// lead the search. The regexes and prefixes of the request are compiled once, and matched together in a single pass over the
+/// records.
 /// @param id JSONRPC client's id.
 /// @param params lookup_records query structure.
-/// @return swoc::Rv<YAML::Node> A node or an error. If ok, the node will hold the @c "recordList" sequence with the findings. In
-/// case of any missed search, ie: when paseed types didn't match the found record(s), the particular error will be added to the @c
-/// "errorList" field.
+/// @param out Where the result is written to.
+/// @return swoc::Errata Always ok. The result will hold the @c "recordList" sequence with the findings. In case of any missed
+/// search, ie: when paseed types didn't match the found record(s), the particular error will be added to the @c "errorList" field.
 ///
-swoc::Rv<YAML::Node> lookup_records(std::string_view const &id, YAML::Node const &params);
+swoc::Errata lookup_records(std::string_view const &id, YAML::Node const &params, ResponseWriter &out);
 
 ///
 /// @brief A RPC function handler that clear all the metrics.
@@ -27,4 +27,5 @@ namespace rpc::handlers::server
 swoc::Rv<YAML::Node> server_start_drain(std::string_view const &id, YAML::Node const &params);
 swoc::Rv<YAML::Node> server_stop_drain(std::string_view const &id, YAML::Node const &);
 void                 server_shutdown(YAML::Node const &);
+swoc::Rv<YAML::Node> get_lock_contention(std::string_view const &id, YAML::Node const &params);
 } // namespace rpc::handlers::server
@@ -38,6 +38,14 @@ add_method_handler(std::string_view name, Func &&call, const RPCRegistryInfo *in
   return JsonRPCManager::instance().add_method_handler(name, std::forward<Func>(call), info, opt);
 }
 
+/// @see JsonRPCManager::add_streaming_method_handler for details
+template <typename Func>
+inline bool
+add_streaming_method_handler(std::string_view name, Func &&call, const RPCRegistryInfo *info, TSRPCHandlerOptions const &opt)
+{
+  return JsonRPCManager::instance().add_streaming_method_handler(name, std::forward<Func>(call), info, opt);
+}
+
 /// As a plugin you should use  @c TSRPCRegisterMethodHandlerfor to register your function to handle RPC messages.
 template <typename Func>
 inline bool
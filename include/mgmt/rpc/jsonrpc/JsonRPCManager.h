@@ -33,6 +33,7 @@
 
 #include "mgmt/rpc/jsonrpc/Defs.h"
 #include "mgmt/rpc/jsonrpc/Context.h"
+#include "mgmt/rpc/jsonrpc/ResponseWriter.h"
 
 namespace rpc
 {
@@ -68,6 +69,9 @@ public:
   using MethodHandlerSignature       = std::function<swoc::Rv<YAML::Node>(std::string_view const &, const YAML::Node &)>;
   using PluginMethodHandlerSignature = std::function<void(std::string_view const &, const YAML::Node &)>;
   using NotificationHandlerSignature = std::function<void(const YAML::Node &)>;
+  // A method that writes its result as it goes, see @c add_streaming_method_handler.
+  using StreamingMethodHandlerSignature =
+    std::function<swoc::Errata(std::string_view const &, const YAML::Node &, ResponseWriter &)>;
 
   ///
   /// @brief Add new registered method handler to the JSON RPC engine.
@@ -84,6 +88,25 @@ public:
   template <typename Func>
   bool add_method_handler(std::string_view name, Func &&call, const RPCRegistryInfo *info, TSRPCHandlerOptions const &opt);
 
+  ///
+  /// @brief Add new registered method handler that streams its result to the JSON RPC engine.
+  ///
+  /// The handler writes the json text of its result through the passed @c ResponseWriter, piece by piece, as it produces it,
+  /// instead of building a YAML::Node for the whole of it. This is for methods with large results, i.e. record lookups. The
+  /// response envelope is written around it. The handler should fail, if it has to, before it writes anything, as an errata
+  /// returned after the first write can no longer be sent back as the error of the response.
+  ///
+  /// @tparam Func The callback function type. See @c StreamingMethodHandlerSignature
+  /// @param name Name to be exposed by the RPC Engine.
+  /// @param call The function handler.
+  /// @param info RPCRegistryInfo pointer.
+  /// @param opt  Handler options, used to pass information about the registered handler.
+  /// @return bool Boolean flag. true if the callback was successfully added, false otherwise
+  ///
+  template <typename Func>
+  bool add_streaming_method_handler(std::string_view name, Func &&call, const RPCRegistryInfo *info,
+                                    TSRPCHandlerOptions const &opt);
+
   ///
   /// @brief Add new registered method handler(from a plugin scope) to the JSON RPC engine.
   ///
@@ -131,6 +154,16 @@ public:
   ///
   std::optional<std::string> handle_call(Context const &ctx, std::string const &jsonString);
 
+  ///
+  /// @brief Same as above, but the response is written to @a out as it is produced.
+  ///
+  /// @param ctx @c Context object used pass information between rpc layers.
+  /// @param jsonString The incoming jsonrpc 2.0 message.
+  /// @param out Where the response is written to.
+  /// @return bool true if a response was written, false if there is none, i.e. notifications.
+  ///
+  bool handle_call(Context const &ctx, std::string const &jsonString, ResponseWriter &out);
+
   ///
   /// @brief Get the instance of the whole RPC engine.
   ///
@@ -205,7 +238,8 @@ private:
 
     /// Find and call the request's callback. If any error occurs, the return type will have the specific error.
     /// For notifications the @c RPCResponseInfo will not be set as part of the response. @c response_type
-    response_type dispatch(Context const &ctx, specs::RPCRequestInfo const &request) const;
+    /// Streaming methods write their result to @a result, and the response is then not returned.
+    response_type dispatch(Context const &ctx, specs::RPCRequestInfo const &request, ResponseWriter &result) const;
 
     /// Find a particular registered handler(method) by its associated name.
     /// @return A pair. The handler itself and a boolean flag indicating that the handler was found. If not found, second will
@@ -221,6 +255,8 @@ private:
     // Supported handler endpoint types.
     using Method       = FunctionWrapper<MethodHandlerSignature>;
     using PluginMethod = FunctionWrapper<PluginMethodHandlerSignature>;
+    // A method which writes its result as it goes.
+    using StreamingMethod = FunctionWrapper<StreamingMethodHandlerSignature>;
     // Plugins and non plugins handlers have no difference from the point of view of the RPC manager, we call and we do not expect
     // for the work to be finished. Notifications have no response at all.
     using Notification = FunctionWrapper<NotificationHandlerSignature>;
@@ -230,7 +266,8 @@ private:
     void register_service_descriptor_handler();
 
     // Functions to deal with the handler invocation.
-    response_type invoke_method_handler(InternalHandler const &handler, specs::RPCRequestInfo const &request) const;
+    response_type invoke_method_handler(InternalHandler const &handler, specs::RPCRequestInfo const &request,
+                                        ResponseWriter &result) const;
     response_type invoke_notification_handler(InternalHandler const &handler, specs::RPCRequestInfo const &request) const;
 
     ///
@@ -247,7 +284,7 @@ private:
       explicit                         operator bool() const;
       bool                             operator!() const;
       /// Invoke the actual handler callback.
-      swoc::Rv<YAML::Node> invoke(specs::RPCRequestInfo const &request) const;
+      swoc::Rv<YAML::Node> invoke(specs::RPCRequestInfo const &request, ResponseWriter &result) const;
       /// Check if the handler was registered as method.
       bool is_method() const;
 
@@ -267,11 +304,11 @@ private:
 
     private:
       // We need to keep this match with the order of types in the _func variant. This will help us to identify the holding type.
-      enum class VariantTypeIndexId : std::size_t { NOTIFICATION = 1, METHOD = 2, METHOD_FROM_PLUGIN = 3 };
-      // We support these three for now. This can easily be extended to support other signatures.
+      enum class VariantTypeIndexId : std::size_t { NOTIFICATION = 1, METHOD = 2, METHOD_FROM_PLUGIN = 3, STREAMING_METHOD = 4 };
+      // We support these four for now. This can easily be extended to support other signatures.
       // that's one of the main points of the InternalHandler
-      std::variant<std::monostate, Notification, Method, PluginMethod> _func;
-      const RPCRegistryInfo                                           *_regInfo =
+      std::variant<std::monostate, Notification, Method, PluginMethod, StreamingMethod> _func;
+      const RPCRegistryInfo                                                            *_regInfo =
         nullptr; ///< Can hold internal information about the handler, this could be null as it is optional.
                  ///< This pointer can eventually holds important information about the call.
       TSRPCHandlerOptions _options;
@@ -295,6 +332,13 @@ JsonRPCManager::add_method_handler(std::string_view name, Handler &&call, const
 }
 template <typename Handler>
 bool
+JsonRPCManager::add_streaming_method_handler(std::string_view name, Handler &&call, const RPCRegistryInfo *info,
+                                             TSRPCHandlerOptions const &opt)
+{
+  return _dispatcher.add_handler<Dispatcher::StreamingMethod, Handler>(name, std::forward<Handler>(call), info, opt);
+}
+template <typename Handler>
+bool
 JsonRPCManager::add_method_handler_from_plugin(const std::string &name, Handler &&call, const RPCRegistryInfo *info,
                                                TSRPCHandlerOptions const &opt)
 {
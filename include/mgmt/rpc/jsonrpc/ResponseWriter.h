@@ -0,0 +1,111 @@
+/**
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+#pragma once
+
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include <yaml-cpp/yaml.h>
+
+namespace rpc
+{
+///
+/// @brief Sink for the json text of the responses, as it is produced.
+///
+/// The transport provides one to @c JsonRPCManager::handle_call so that a response can go out in parts, instead of being built
+/// whole in memory first. Streaming method handlers (see @c JsonRPCManager::StreamingMethodHandlerSignature) write their result
+/// through it.
+///
+class ResponseWriter
+{
+public:
+  virtual ~ResponseWriter() = default;
+
+  /// Write a piece of json text.
+  virtual void write(std::string_view data) = 0;
+
+  /// Write @a node as json, the way the codec encodes the responses.
+  void
+  write(YAML::Node const &node)
+  {
+    YAML::Emitter json;
+    json << YAML::DoubleQuoted << YAML::Flow << node;
+    write(std::string_view{json.c_str(), json.size()});
+  }
+};
+
+///
+/// @brief @c ResponseWriter that collects the json text into a string.
+///
+class StringResponseWriter : public ResponseWriter
+{
+public:
+  explicit StringResponseWriter(std::string &out) : _out(out) {}
+
+  using ResponseWriter::write;
+  void
+  write(std::string_view data) override
+  {
+    _out.append(data);
+  }
+
+private:
+  std::string &_out;
+};
+
+///
+/// @brief Stream buffer over a @c ResponseWriter, so that a YAML::Emitter can write a result through it while it emits it.
+///
+/// Whatever is buffered is written when the buffer is full and when it goes out of scope.
+///
+class ResponseStreamBuf : public std::streambuf
+{
+public:
+  explicit ResponseStreamBuf(ResponseWriter &out) : _out(out) { setp(_buffer, _buffer + sizeof(_buffer)); }
+  ~ResponseStreamBuf() override { sync(); }
+
+protected:
+  int_type
+  overflow(int_type c) override
+  {
+    sync();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int
+  sync() override
+  {
+    if (pptr() > pbase()) {
+      _out.write(std::string_view{pbase(), static_cast<size_t>(pptr() - pbase())});
+      setp(_buffer, _buffer + sizeof(_buffer));
+    }
+    return 0;
+  }
+
+private:
+  ResponseWriter &_out;
+  char            _buffer[4096];
+};
+} // namespace rpc
@@ -33,6 +33,7 @@
 #include "tsutil/ts_errata.h"
 #include "tscore/Layout.h"
 
+#include "mgmt/rpc/jsonrpc/Context.h"
 #include "mgmt/rpc/server/CommBase.h"
 #include "mgmt/rpc/config/JsonRPCConfig.h"
 
@@ -46,6 +47,9 @@ namespace rpc::comm
 ///
 /// @note The server will keep reading the client's requests till the buffer is full or there is no more data in the wire.
 ///       Buffer size = 32k
+///       A client may send more than one request on a connection without waiting for the responses. Each request is answered as
+///       soon as it is whole, in the order they came. The responses are written back to back on the connection. The client can
+///       shut down its writing side after the last request, and read the responses till the server closes the connection.
 class IPCSocketServer : public BaseCommInterface
 {
   // Error codes to track any unauthorized call to a rpc handler.
@@ -59,6 +63,14 @@ class IPCSocketServer : public BaseCommInterface
   /// When client goes out of scope it will close the socket. If you want to keep the socket connected, you need to keep
   /// the client object around.
   struct Client {
+    /// The outcome of @c read_all.
+    enum class ReadStatus {
+      NO_MORE_DATA, ///< No more data came in for a while.
+      PEER_CLOSED,  ///< The peer closed the connection, or shut down its writing side.
+      BUFFER_FULL,  ///< The buffer is full, more data may be waiting.
+      READ_ERROR    ///< Error reading the socket.
+    };
+
     /// @param fd Peer's socket.
     Client(int fd);
     /// Destructor will close the socket(if opened);
@@ -70,14 +82,13 @@ class IPCSocketServer : public BaseCommInterface
     /// @return the size of what was read by the read() function.
     ssize_t read(swoc::MemSpan<char> span) const;
     /// Function that reads all the data available in the socket, it will validate the data on every read if there is more than
-    /// a single chunk.
+    /// a single chunk. The data is appended to what is in the @c bw already.
     /// The size of the buffer to be read is not defined in this function, but rather passed in the @c bw parameter.
-    /// @return A tuple with a boolean flag indicating if the operation did success or not, in case of any error, a text will
-    /// be added with a description.
-    std::tuple<bool, std::string> read_all(swoc::FixedBufferWriter &bw) const;
+    /// @return Why the reading stopped. In case of any error, @a error will be set with a description.
+    ReadStatus read_all(swoc::FixedBufferWriter &bw, std::string &error) const;
     /// Write the the socket with the passed data.
     /// @return std::error_code.
-    void write(std::string const &data, std::error_code &ec) const;
+    void write(std::string_view data, std::error_code &ec) const;
     bool is_connected() const;
 
   private:
@@ -137,6 +148,8 @@ private:
   void listen(std::error_code &ec);
   void close();
   void late_check_peer_credentials(int peedFd, TSRPCHandlerOptions const &options, swoc::Errata &errata) const;
+  /// Read the requests of @a client and answer them, till it has no more.
+  void handle_client(Client &client, rpc::Context const &ctx, swoc::FixedBufferWriter &bw) const;
 
   std::atomic_bool _running;
 
@@ -1254,8 +1254,13 @@ struct HTTPCacheAlt {
   int32_t m_writeable     = 1;
   int32_t m_unmarshal_len = -1;
 
-  int32_t m_id  = -1;
-  int32_t m_rid = -1;
+  int32_t m_id = -1;
+
+  /// No fingerprint for the alternate.
+  static constexpr uint32_t NO_VARY_FINGERPRINT = UINT32_MAX;
+  /// Fingerprint of the request headers this alternate was selected by, see HttpTransactCache.
+  /// @note This was the unused m_rid, which is -1 in objects written before.
+  uint32_t m_vary_fingerprint = NO_VARY_FINGERPRINT;
 
   int32_t m_object_key[sizeof(CryptoHash) / sizeof(int32_t)];
   int32_t m_object_size[2];
@@ -1336,10 +1341,10 @@ public:
   {
     return m_alt->m_id;
   }
-  int32_t
-  rid_get()
+  uint32_t
+  vary_fingerprint_get() const
   {
-    return m_alt->m_rid;
+    return m_alt->m_vary_fingerprint;
   }
 
   void
@@ -1348,9 +1353,9 @@ public:
     m_alt->m_id = id;
   }
   void
-  rid_set(int32_t id)
+  vary_fingerprint_set(uint32_t fingerprint)
   {
-    m_alt->m_rid = id;
+    m_alt->m_vary_fingerprint = fingerprint;
   }
 
   CryptoHash object_key_get();
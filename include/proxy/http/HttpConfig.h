@@ -771,6 +771,8 @@ public:
 
   MgmtByte server_session_sharing_pool = TS_SERVER_SESSION_SHARING_POOL_THREAD;
 
+  MgmtByte adaptive_buffer_sizing = 0;
+
   ConnectionTracker::GlobalConfig global_connection_tracker_config;
 
   // bitset to hold the status codes that will BE cached with negative caching enabled
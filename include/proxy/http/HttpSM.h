@@ -480,11 +480,12 @@ private:
   virtual void set_next_state();
   void         call_transact_and_set_next_state(TransactEntryFunc_t f);
 
-  bool    is_http_server_eos_truncation(HttpTunnelProducer *);
-  bool    is_bg_fill_necessary(HttpTunnelConsumer *c);
-  int     find_server_buffer_size();
-  int     find_http_resp_buffer_size(int64_t cl);
-  int64_t server_transfer_init(MIOBuffer *buf, int hdr_size);
+  bool       is_http_server_eos_truncation(HttpTunnelProducer *);
+  bool       is_bg_fill_necessary(HttpTunnelConsumer *c);
+  int        find_server_buffer_size();
+  int        find_http_resp_buffer_size(int64_t cl);
+  MIOBuffer *new_server_response_buffer();
+  int64_t    server_transfer_init(MIOBuffer *buf, int hdr_size);
 
   /// Update the milestones to track time spent in the plugin API.
   void milestone_update_api_time();
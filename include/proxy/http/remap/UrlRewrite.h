@@ -33,6 +33,7 @@
 #include "proxy/http/remap/PluginFactory.h"
 #include "proxy/http/remap/NextHopStrategyFactory.h"
 
+#include <atomic>
 #include <memory>
 
 #define URL_REMAP_FILTER_NONE         0x00000000
@@ -122,6 +123,13 @@ public:
     return _valid;
   };
 
+  /// @return The generation of this table, unique across all tables loaded by this process.
+  uint64_t
+  generation() const
+  {
+    return _generation;
+  }
+
   /// @return  Number of rules defined.
   int
   rule_count() const
@@ -159,6 +167,7 @@ public:
   struct MappingsStore {
     std::unique_ptr<URLTable> hash_lookup;
     RegexMappingList          regex_list;
+    int                       max_path_len = 0; ///< Longest "from" path in @a hash_lookup.
     bool
     empty()
     {
@@ -182,7 +191,7 @@ public:
   bool InsertMapping(mapping_type maptype, url_mapping *new_mapping, RegexMapping *reg_map, const char *src_host,
                      bool is_cur_mapping_regex);
 
-  bool TableInsert(std::unique_ptr<URLTable> &h_table, url_mapping *mapping, const char *src_host);
+  bool TableInsert(MappingsStore &store, url_mapping *mapping, const char *src_host);
 
   MappingsStore forward_mappings;
   MappingsStore reverse_mappings;
@@ -241,10 +250,16 @@ private:
   bool              _valid               = false;
   ACLBehaviorPolicy _acl_behavior_policy = ACLBehaviorPolicy::ACL_BEHAVIOR_LEGACY;
 
+  inline static std::atomic<uint64_t> _next_generation{1};
+
+  uint64_t _generation        = _next_generation++;
+  int      _lookup_cache_size = 0; ///< Entries in the per thread lookup cache, 0 to disable.
+
   bool _mappingLookup(MappingsStore &mappings, URL *request_url, int request_port, const char *request_host, int request_host_len,
                       UrlMappingContainer &mapping_container);
-  url_mapping *_tableLookup(std::unique_ptr<URLTable> &h_table, URL *request_url, int request_port, char *request_host,
-                            int request_host_len);
+  url_mapping *_tableLookup(MappingsStore &store, URL *request_url, int request_port, char *request_host, int request_host_len);
+  url_mapping *_cachedTableLookup(MappingsStore &store, URL *request_url, int request_port, char *request_host,
+                                  int request_host_len);
   bool         _regexMappingLookup(RegexMappingList &regex_mappings, URL *request_url, int request_port, const char *request_host,
                                    int request_host_len, int rank_ceiling, UrlMappingContainer &mapping_container);
   int          _expandSubstitutions(size_t *matches_info, const RegexMapping *reg_map, const char *matched_string, char *dest_buf,
@@ -54,6 +54,7 @@
 #include <cstdarg>
 #include "tscore/ink_platform.h"
 #include "tscore/EventNotify.h"
+#include "tscore/ink_hrtime.h"
 #include "tscore/Regression.h"
 #include "records/RecProcess.h"
 #include "proxy/logging/LogFile.h"
@@ -81,8 +82,12 @@ public:
   LogBuffer   *logbuffer = nullptr;
   void        *m_data;
   int          m_len;
+  ink_hrtime   m_queued; ///< When the data was handed to the flush thread.
 
-  LogFlushData(LogFile *logfile, void *data, int len = -1) : m_logfile(logfile), m_data(data), m_len(len) {}
+  LogFlushData(LogFile *logfile, void *data, int len = -1)
+    : m_logfile(logfile), m_data(data), m_len(len), m_queued(ink_get_hrtime())
+  {
+  }
   ~LogFlushData()
   {
     switch (m_logfile->m_file_format) {
@@ -188,11 +193,12 @@ public:
   // logging thread stuff
   static EventNotify   *preproc_notify;
   static void          *preproc_thread_main(void *args);
-  static EventNotify   *flush_notify;
-  static InkAtomicList *flush_data_list;
+  static EventNotify   *flush_notify;    ///< One per flush thread.
+  static InkAtomicList *flush_data_list; ///< One per flush thread.
   static void          *flush_thread_main(void *args);
 
   static int preproc_threads;
+  static int flush_threads;
 
   // reconfiguration stuff
   static void change_configuration();
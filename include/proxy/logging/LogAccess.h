@@ -262,6 +262,7 @@ public:
   int marshal_proxy_protocol_version(char *);                      // STR
   int marshal_proxy_protocol_src_ip(char *);                       // STR
   int marshal_proxy_protocol_dst_ip(char *);                       // STR
+  int marshal_log_sample_rate(char *);                             // INT
 
   // named fields from within a http header
   //
@@ -335,6 +336,30 @@ public:
   static int round_strlen(int len);
   static int strlen(const char *str);
 
+  //
+  // Each log object marshals its fields from this LogAccess. A field in
+  // several formats is marshalled by the first of them, and copied from
+  // here by the others. The cache is indexed by LogField::marshal_slot().
+  //
+  void marshal_cache_init(int slots);
+  void marshal_cache_clear();
+  bool marshal_cache_len(int slot, unsigned *len) const;
+  void marshal_cache_set_len(int slot, unsigned len);
+  bool marshal_cache_copy(int slot, char *buf, unsigned *len) const;
+  void marshal_cache_store(int slot, const char *buf, unsigned len);
+
+  //
+  // A log object that samples its entries sets the rate at which the entry
+  // it logs was sampled, which is logged as the lsr field. Errors and
+  // responses other than 2xx are a priority, and are not sampled.
+  //
+  void
+  set_sample_rate(int rate)
+  {
+    m_sample_rate = rate;
+  }
+  bool is_priority_entry() const;
+
 public:
   static void marshal_int(char *dest, int64_t source);
   static void marshal_str(char *dest, const char *source, int padded_len);
@@ -351,6 +376,15 @@ private:
 
   Arena m_arena;
 
+  struct MarshalCacheEntry {
+    const char *data; ///< The marshalled field, or @c nullptr if only its length is known.
+    unsigned    len;
+  };
+  MarshalCacheEntry *m_marshal_cache       = nullptr;
+  int                m_marshal_cache_slots = 0;
+
+  int m_sample_rate = 1;
+
   HTTPHdr *m_client_request  = nullptr;
   HTTPHdr *m_proxy_response  = nullptr;
   HTTPHdr *m_proxy_request   = nullptr;
@@ -405,6 +439,35 @@ LogAccess::strlen(const char *str)
   }
 }
 
+inline bool
+LogAccess::marshal_cache_len(int slot, unsigned *len) const
+{
+  if (slot >= 0 && slot < m_marshal_cache_slots && m_marshal_cache[slot].len) {
+    *len = m_marshal_cache[slot].len;
+    return true;
+  }
+  return false;
+}
+
+inline void
+LogAccess::marshal_cache_set_len(int slot, unsigned len)
+{
+  if (slot >= 0 && slot < m_marshal_cache_slots) {
+    m_marshal_cache[slot].len = len;
+  }
+}
+
+inline bool
+LogAccess::marshal_cache_copy(int slot, char *buf, unsigned *len) const
+{
+  if (slot >= 0 && slot < m_marshal_cache_slots && m_marshal_cache[slot].data) {
+    *len = m_marshal_cache[slot].len;
+    memcpy(buf, m_marshal_cache[slot].data, *len);
+    return true;
+  }
+  return false;
+}
+
 inline void
 LogAccess::marshal_int(char *dest, int64_t source)
 {
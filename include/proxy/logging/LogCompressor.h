@@ -0,0 +1,64 @@
+/** @file
+
+  Streaming compression of ASCII log files.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+enum LogFileCompression {
+  LOG_FILE_COMPRESSION_NONE,
+  LOG_FILE_COMPRESSION_GZIP,
+  LOG_FILE_COMPRESSION_ZSTD,
+};
+
+/*-------------------------------------------------------------------------
+  LogCompressor
+
+  Compresses the data written to a log file as one stream, flushed at the
+  end of each write so the file can be read up to there even while it is
+  being written. The stream is finished when the file is rolled or closed,
+  and a new gzip member or zstd frame is begun by the next write, so a file
+  appended to after a restart is still read as one file by zcat or zstdcat.
+  -------------------------------------------------------------------------*/
+
+class LogCompressor
+{
+public:
+  virtual ~LogCompressor() = default;
+
+  /// @return A compressor for @a compression at @a level, or @c nullptr if it is not supported by this build.
+  static LogCompressor *create(LogFileCompression compression, int level);
+
+  /// @return The file name extension for @a compression.
+  static const char *extension(LogFileCompression compression);
+
+  /// Compress @a len bytes of @a data to @a fd, @return the bytes written to @a fd or -1 on error.
+  virtual int write(int fd, const char *data, int len) = 0;
+
+  /// End the stream on @a fd, @return the bytes written to @a fd or -1 on error.
+  virtual int finish(int fd) = 0;
+
+protected:
+  /// Write all @a len bytes of @a data to @a fd, @return @a len or -1 on error.
+  static int write_all(int fd, const char *data, int len);
+
+  static constexpr int OUTPUT_BUFFER_SIZE = 64 * 1024;
+};
@@ -178,6 +178,7 @@ public:
   int      logfile_perm          = 0644;
 
   int preproc_threads = 1;
+  int flush_threads   = 1;
 
   Log::RollingEnabledValues rolling_enabled          = Log::NO_ROLLING;
   int                       rolling_interval_sec     = 86400;
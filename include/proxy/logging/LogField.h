@@ -179,6 +179,16 @@ public:
     return m_time_field;
   }
 
+  /// Integer fields are cheaper to marshal again than to copy, and are not cached.
+  static constexpr int NO_MARSHAL_SLOT = -1;
+
+  /// The slot of this field in the marshal cache of LogAccess, shared by the fields that marshal the same data.
+  int
+  marshal_slot() const
+  {
+    return m_marshal_slot;
+  }
+
   void set_http_header_field(LogAccess *lad, LogField::Container container, char *field, char *buf, int len);
   void set_aggregate_op(Aggregate agg_op);
   void update_aggregate(int64_t val);
@@ -188,6 +198,7 @@ public:
   static Aggregate valid_aggregate_name(char *name);
   static bool      fieldlist_contains_aggregates(const char *fieldlist);
   static bool      isContainerUpdateFieldSupported(Container container);
+  static int       marshal_slots();
 
 private:
   char                 *m_name;
@@ -204,6 +215,8 @@ private:
   bool                  m_time_field;
   Ptr<LogFieldAliasMap> m_alias_map; // map sINT <--> string
   SetFunc               m_set_func;
+  int                   m_marshal_slot;
+  unsigned              marshal_field(LogAccess *lad, char *buf);
   TSMilestonesType      milestone_from_m_name();
   int                   milestones_from_m_name(TSMilestonesType *m1, TSMilestonesType *m2);
 
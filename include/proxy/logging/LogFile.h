@@ -27,11 +27,15 @@
 #include <cstdio>
 
 #include "tscore/ink_platform.h"
+#include "tscore/ink_mutex.h"
 #include "proxy/logging/LogBufferSink.h"
+#include "proxy/logging/LogCompressor.h"
+#include "tsutil/Metrics.h"
 
 class LogBuffer;
 struct LogBufferHeader;
 class LogObject;
+class LogFlushData;
 class BaseLogFile;
 class BaseMetaInfo;
 
@@ -43,7 +47,8 @@ class LogFile : public LogBufferSink, public RefCountObjInHeap
 {
 public:
   LogFile(const char *name, const char *header, LogFileFormat format, uint64_t signature, size_t ascii_buffer_size = 4 * 9216,
-          size_t max_line_size = 9216, int pipe_buffer_size = 0, LogEscapeType escape_type = LOG_ESCAPE_NONE);
+          size_t max_line_size = 9216, int pipe_buffer_size = 0, LogEscapeType escape_type = LOG_ESCAPE_NONE,
+          LogFileCompression compression = LOG_FILE_COMPRESSION_NONE, int compression_level = 0);
   LogFile(const LogFile &) = delete;
   ~LogFile() override;
 
@@ -121,6 +126,12 @@ public:
   int        get_fd();
   static int writeln(char *data, int len, int fd, const char *path);
 
+  /// Hand @a flush_data of @a bytes to the flush thread that writes this file.
+  void queue_flush(LogFlushData *flush_data, int bytes);
+
+  /// Write @a len bytes of @a data through the compressor, @return the bytes written to the file or -1 on error.
+  int write_compressed(const char *data, int len);
+
 public:
   LogFileFormat m_file_format;
 
@@ -137,6 +148,16 @@ public:
   int          m_pipe_buffer_size;  // this is the size of the pipe buffer set by fcntl
   int          m_fd;                // this could back m_log or a pipe, depending on the situation
 
+  // Each file is written by one flush thread, so its writes are kept in
+  // order. The mutex keeps the periodic tasks from rolling or closing the
+  // file while that thread writes it.
+  int            m_flush_thread;
+  ink_mutex      m_flush_mutex;
+  LogCompressor *m_compressor = nullptr;
+
+  ts::Metrics::Gauge::AtomicType *m_flush_lag;     ///< Milliseconds the last data written waited for its flush thread.
+  ts::Metrics::Gauge::AtomicType *m_flush_pending; ///< Bytes waiting for the flush thread.
+
 public:
   Link<LogFile> link;
   // noncopyable
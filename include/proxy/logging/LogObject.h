@@ -31,6 +31,7 @@
 #include "proxy/logging/LogBuffer.h"
 #include "proxy/logging/LogAccess.h"
 #include "proxy/logging/LogFilter.h"
+#include <atomic>
 #include <vector>
 
 /*-------------------------------------------------------------------------
@@ -76,6 +77,12 @@ public:
     ink_atomic_increment(&_num_flush_buffers, 1);
   }
 
+  inline int
+  num_flush_buffers() const
+  {
+    return _num_flush_buffers;
+  }
+
   size_t preproc_buffers(LogBufferSink *sink);
 };
 
@@ -96,11 +103,32 @@ public:
   LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
             const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec = 0,
             int rolling_offset_hr = 0, int rolling_size_mb = 0, bool auto_created = false, int rolling_max_count = 0,
-            int rolling_min_count = 0, bool reopen_after_rolling = false, int pipe_buffer_size = 0, bool m_fast = false);
+            int rolling_min_count = 0, bool reopen_after_rolling = false, int pipe_buffer_size = 0, bool m_fast = false,
+            LogFileCompression compression = LOG_FILE_COMPRESSION_NONE, int compression_level = 0);
   ~LogObject() override;
 
   void add_filter(LogFilter *filter, bool copy = true);
 
+  /** Sample the entries of this object while it cannot keep up with them.
+   *
+   * Sampling starts when the buffers waiting to be preprocessed reach @a occupancy percent of
+   * those that can wait, or the flush lag of the file reaches @a lag_ms, and the rate doubles
+   * each second they stay there, up to 1 in @a max_rate entries. Errors and responses other
+   * than 2xx are always logged.
+   *
+   * @param max_rate The highest rate, 0 or 1 to never sample.
+   */
+  void set_sampling(int max_rate, int occupancy, int lag_ms);
+
+  /// Adjust the sample rate to the load at @a now, at most once a second.
+  void update_sample_rate(ink_hrtime now);
+
+  inline int
+  get_sample_rate() const
+  {
+    return m_sample_rate.load(std::memory_order_relaxed);
+  }
+
   inline void
   set_fmt_timestamps()
   {
@@ -280,7 +308,17 @@ private:
   int  m_pipe_buffer_size;
   bool m_fast; // use fast buffering (thread local logbuffers)
 
-  void generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format);
+  int                   m_sample_max_rate  = 0;    // highest sample rate, 0 or 1 if not sampling
+  int                   m_sample_occupancy = 50;   // percent of the buffers that can wait to be preprocessed
+  int                   m_sample_lag_ms    = 1000; // flush lag of the file
+  ink_hrtime            m_sample_updated   = 0;
+  std::atomic<int>      m_sample_rate{1};
+  std::atomic<uint64_t> m_sample_count{0};
+
+  ts::Metrics::Gauge::AtomicType   *m_sample_rate_gauge = nullptr; // the current sample rate
+  ts::Metrics::Counter::AtomicType *m_sampled_out       = nullptr; // entries not logged by sampling
+
+  void generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format, LogFileCompression compression);
   void _setup_rolling(LogConfig *cfg, Log::RollingEnabledValues rolling_enabled, int rolling_interval_sec, int rolling_offset_hr,
                       int rolling_size_mb);
   unsigned _roll_files(long interval_start, long interval_end);
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <functional>
+#include <string_view>
 
 #include "tscore/Diags.h"
 
@@ -180,6 +181,10 @@ using RecLookupCallback = void (*)(const RecRecord *, void *);
 
 RecErrT RecLookupRecord(const char *name, RecLookupCallback callback, void *data, bool lock = true);
 RecErrT RecLookupMatchingRecords(unsigned rec_type, const char *match, RecLookupCallback callback, void *data, bool lock = true);
+/// Same as above, with the records chosen by @a match, called with the type and name of each record of @a rec_type, so that the
+/// caller can test many patterns in one pass.
+RecErrT RecLookupMatchingRecords(unsigned rec_type, std::function<bool(RecT, std::string_view)> const &match,
+                                 RecLookupCallback callback, void *data);
 
 RecErrT RecGetRecordType(const char *name, RecT *rec_type, bool lock = true);
 RecErrT RecGetRecordDataType(const char *name, RecDataT *data_type, bool lock = true);
@@ -110,11 +110,22 @@ public:
     ink_freelist_madvise_init(&this->fl, name, element_size, chunk_size, alignment, use_hugepages, advice);
   }
 
+  /** The underlying freelist, for reading its allocation counters. */
+  const InkFreeList *
+  freelist() const
+  {
+    return this->fl;
+  }
+
   // Dummies
   void
   destroy_if_enabled(void *)
   {
   }
+  void
+  record_thread_cache(size_t, size_t)
+  {
+  }
   FreelistAllocator &
   raw()
   {
@@ -208,6 +219,10 @@ public:
   destroy_if_enabled(void *)
   {
   }
+  void
+  record_thread_cache(size_t, size_t)
+  {
+  }
   MallocAllocator &
   raw()
   {
@@ -248,6 +263,16 @@ public:
     WrappedAllocator::free_void_bulk(head, tail, num_item);
   }
 
+  /**
+    Account for allocations served by (hits) or passed through (misses) a per-thread cache in front of this allocator.
+  */
+  void
+  record_thread_cache(size_t hits, size_t misses)
+  {
+    thread_hit_metric->increment(hits);
+    thread_miss_metric->increment(misses);
+  }
+
   MeteredAllocator() {}
 
   MeteredAllocator(const char *name, unsigned int element_size, unsigned int chunk_size = 128, unsigned int alignment = 8,
@@ -256,7 +281,9 @@ public:
       inuse_metric{ts::Metrics::Gauge::createPtr("proxy.process.allocator.inuse.", name)},
       alloc_metric{ts::Metrics::Counter::createPtr("proxy.process.allocator.alloc.", name)},
       free_metric{ts::Metrics::Counter::createPtr("proxy.process.allocator.free.", name)},
-      size_metric{ts::Metrics::Gauge::createPtr("proxy.process.allocator.size.", name)}
+      size_metric{ts::Metrics::Gauge::createPtr("proxy.process.allocator.size.", name)},
+      thread_hit_metric{ts::Metrics::Counter::createPtr("proxy.process.allocator.thread_hit.", name)},
+      thread_miss_metric{ts::Metrics::Counter::createPtr("proxy.process.allocator.thread_miss.", name)}
   {
     size_metric->store(element_size);
   }
@@ -270,6 +297,9 @@ public:
       alloc_metric = ts::Metrics::Counter::createPtr("proxy.process.allocator.alloc.", name);
       free_metric  = ts::Metrics::Counter::createPtr("proxy.process.allocator.free.", name);
       size_metric  = ts::Metrics::Gauge::createPtr("proxy.process.allocator.size.", name);
+
+      thread_hit_metric  = ts::Metrics::Counter::createPtr("proxy.process.allocator.thread_hit.", name);
+      thread_miss_metric = ts::Metrics::Counter::createPtr("proxy.process.allocator.thread_miss.", name);
     }
     size_metric->store(element_size);
 
@@ -294,6 +324,9 @@ private:
   ts::Metrics::AtomicType *alloc_metric = nullptr;
   ts::Metrics::AtomicType *free_metric  = nullptr;
   ts::Metrics::AtomicType *size_metric  = nullptr;
+
+  ts::Metrics::AtomicType *thread_hit_metric  = nullptr;
+  ts::Metrics::AtomicType *thread_miss_metric = nullptr;
 };
 
 #if TS_USE_MALLOC_ALLOCATOR
@@ -0,0 +1,214 @@
+/** @file
+
+  Hierarchical timing wheel of intrusively linked items.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/List.h"
+#include "tscore/ink_assert.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// Link cell for an item of type C in a TimingWheel.
+template <class C> struct TimingWheelLink : public Link<C> {
+  uint64_t due  = 0;  ///< Tick the item is filed for.
+  int32_t  slot = -1; ///< Bucket holding the item, -1 if the item is not in a wheel.
+};
+
+#define TIMING_WHEEL_LINK(_c, _f)                \
+  class Link##_##_f : public TimingWheelLink<_c> \
+  {                                              \
+  public:                                        \
+    static TimingWheelLink<_c> &                 \
+    wheel_link(_c *c)                            \
+    {                                            \
+      return c->_f;                              \
+    }                                            \
+    static _c *&                                 \
+    next_link(_c *c)                             \
+    {                                            \
+      return c->_f.next;                         \
+    }                                            \
+    static _c *&                                 \
+    prev_link(_c *c)                             \
+    {                                            \
+      return c->_f.prev;                         \
+    }                                            \
+  };                                             \
+  TimingWheelLink<_c> _f
+
+/**
+  A hierarchical timing wheel.
+
+  Items are filed by the tick at which they are due. Level 0 has a slot for each of the next @c SLOTS
+  ticks, level 1 a slot for each of the next @c SLOTS blocks of @c SLOTS ticks, and so on. Filing and
+  removing an item is O(1). advance() moves the wheel forward and hands out the items of level 0
+  slots it passes. The coarser slots are split into the finer levels as their time comes. The cost
+  of an advance depends on the number of items that come due, not on the number of items in the
+  wheel.
+
+  Items due further out than @c SPAN ticks are filed at the far end of the wheel and are handed out
+  early. The owner is expected to check whether an item handed out is really due and file it again
+  if not.
+
+  The wheel is not thread safe.
+*/
+template <class C, class L = typename C::Link_link> class TimingWheel
+{
+public:
+  static constexpr int      SLOT_BITS = 6;
+  static constexpr int      SLOTS     = 1 << SLOT_BITS;
+  static constexpr int      LEVELS    = 4;
+  static constexpr uint64_t SPAN      = uint64_t{1} << (SLOT_BITS * LEVELS);
+
+  explicit TimingWheel(uint64_t now = 0) : _now(now) {}
+
+  /// The last tick handed out by advance().
+  uint64_t
+  now() const
+  {
+    return _now;
+  }
+
+  /// Number of items in the wheel.
+  size_t
+  size() const
+  {
+    return _size;
+  }
+
+  bool
+  in(C *c) const
+  {
+    return L::wheel_link(c).slot >= 0;
+  }
+
+  /**
+    File @a c to be handed out when the wheel advances to tick @a at. An item already in the wheel
+    is moved. An item due at or before the current tick is handed out by the next advance.
+  */
+  void
+  schedule(C *c, uint64_t at)
+  {
+    if (in(c)) {
+      remove(c);
+    }
+    if (at <= _now) {
+      at = _now + 1;
+    } else if (at - _now >= SPAN) {
+      at = _now + SPAN - 1;
+    }
+    file(c, at);
+    ++_size;
+  }
+
+  void
+  remove(C *c)
+  {
+    auto &link = L::wheel_link(c);
+    if (link.slot >= 0) {
+      _buckets[link.slot].remove(c);
+      link.slot = -1;
+      --_size;
+    }
+  }
+
+  /**
+    Advance the wheel to tick @a to and call @a expire for each item due at or before it.
+
+    The item is removed from the wheel before @a expire is called, so it may be filed again or
+    freed there.
+
+    @return The number of items handed out.
+  */
+  template <typename F>
+  size_t
+  advance(uint64_t to, F &&expire)
+  {
+    size_t n = 0;
+
+    if (_size == 0 && _now < to) {
+      _now = to;
+    }
+    while (_now < to) {
+      ++_now;
+      // Split the coarser slots that start at this tick, coarsest first.
+      int level = 1;
+      while (level < LEVELS && (_now & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+        ++level;
+      }
+      for (int l = level - 1; l >= 1; --l) {
+        cascade(l);
+      }
+
+      Bucket &bucket = _buckets[_now & (SLOTS - 1)];
+      while (C *c = bucket.pop()) {
+        L::wheel_link(c).slot = -1;
+        --_size;
+        ++n;
+        expire(c);
+      }
+    }
+
+    return n;
+  }
+
+private:
+  using Bucket = DLL<C, L>;
+
+  void
+  file(C *c, uint64_t at)
+  {
+    ink_assert(at >= _now);
+    uint64_t delta = at - _now;
+    int      level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+      ++level;
+    }
+
+    auto &link = L::wheel_link(c);
+    link.due   = at;
+    link.slot  = level * SLOTS + static_cast<int32_t>((at >> (SLOT_BITS * level)) & (SLOTS - 1));
+    _buckets[link.slot].push(c);
+  }
+
+  void
+  cascade(int level)
+  {
+    Bucket &bucket = _buckets[level * SLOTS + ((_now >> (SLOT_BITS * level)) & (SLOTS - 1))];
+    Bucket  items;
+
+    items.head  = bucket.head;
+    bucket.head = nullptr;
+    while (C *c = items.pop()) {
+      file(c, L::wheel_link(c).due);
+    }
+  }
+
+  uint64_t                           _now  = 0;
+  size_t                             _size = 0;
+  std::array<Bucket, SLOTS * LEVELS> _buckets;
+};
+
+#define TimingWheelOf(_c, _f) TimingWheel<_c, _c::Link##_##_f>
@@ -177,14 +177,23 @@ union head_p {
 #error "unsupported processor"
 #endif
 
+/// Upper bound on the number of NUMA node local depots in a freelist. Nodes past this share depots.
+#define INK_FREELIST_NUMA_DEPOTS 8
+
+/// The free items of one NUMA node, padded so that the depots of different nodes do not share a cache line.
+struct InkFreeListDepot {
+  head_p head;
+  char   pad[64 - sizeof(head_p)];
+};
+
 struct _InkFreeList {
-  head_p      head;
-  const char *name;
-  uint32_t    type_size, chunk_size, used, allocated, alignment;
-  uint32_t    allocated_base, used_base;
-  uint32_t    hugepages_failure;
-  bool        use_hugepages;
-  int         advice;
+  InkFreeListDepot depot[INK_FREELIST_NUMA_DEPOTS];
+  const char      *name;
+  uint32_t         type_size, chunk_size, used, allocated, alignment;
+  uint32_t         allocated_base, used_base;
+  uint32_t         hugepages_failure;
+  bool             use_hugepages;
+  int              advice;
 };
 
 using InkFreeListOps = struct ink_freelist_ops;
@@ -211,6 +220,14 @@ void  ink_freelists_dump(FILE *f);
 void  ink_freelists_dump_baselinerel(FILE *f);
 void  ink_freelists_snap_baseline();
 
+/** Set the NUMA node of the calling thread.
+
+    Each freelist keeps a depot of free items per NUMA node. A thread allocates from and frees to the
+    depot of its node, so the chunks it carves out (and first touches) stay with threads on the same
+    node. Threads that never call this share depot 0, which is the same as having a single freelist.
+*/
+void ink_freelist_set_numa_node(int node);
+
 struct InkAtomicList {
   InkAtomicList() {}
   head_p      head{};
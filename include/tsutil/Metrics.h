@@ -165,6 +165,13 @@ public:
     return _storage->name(id);
   }
 
+  // The number of changes to the metric names, so that a copy of them can tell when it is out of date.
+  uint64_t
+  generation() const
+  {
+    return _storage->generation();
+  }
+
   bool
   valid(IdType id) const
   {
@@ -291,8 +298,9 @@ private:
   class Storage
   {
     BlobStorage        _blobs;
-    uint16_t           _cur_blob = 0;
-    uint16_t           _cur_off  = 0;
+    uint16_t           _cur_blob   = 0;
+    uint16_t           _cur_off    = 0;
+    uint64_t           _generation = 0;
     LookupTable        _lookups;
     mutable std::mutex _mutex;
 
@@ -330,6 +338,13 @@ private:
       return {_cur_blob, _cur_off};
     }
 
+    uint64_t
+    generation() const
+    {
+      std::lock_guard lock(_mutex);
+      return _generation;
+    }
+
     bool
     valid(IdType id) const
     {
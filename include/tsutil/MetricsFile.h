@@ -0,0 +1,189 @@
+/** @file
+
+  The metrics file, a read-only memory mapped copy of the Metrics, for local agents.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tsutil/Metrics.h"
+
+namespace ts
+{
+/** A copy of the Metrics in a file, which local agents map and read without asking the server.
+
+    The file is a header, a name table and the values, in blocks of Metrics::MAX_SIZE as the
+    Metrics store them. A metric that has no name, a slot of a span not yet named, is in the
+    file with an empty name.
+
+    The Writer copies the values into the file periodically, under a sequence count which is odd
+    while it does, so that a Reader can tell a copy that is torn. When the metric names change,
+    the Writer replaces the file with a new one, and marks the one replaced as retired, so that
+    a Reader knows to map the file again.
+
+    The format is for agents on the same host, and in native byte order. A change to it must bump
+    VERSION.
+ */
+class MetricsFile
+{
+public:
+  static constexpr char     MAGIC[8] = {'T', 'S', 'M', 'E', 'T', 'R', 'I', 'C'};
+  static constexpr uint32_t VERSION  = 1;
+
+  /// The name of the file, in the runtime directory.
+  static constexpr const char *FILENAME = "metrics.mmap";
+
+  using ValueType = std::atomic<int64_t>;
+  static_assert(ValueType::is_always_lock_free && sizeof(ValueType) == sizeof(int64_t));
+
+  struct Header {
+    char                  magic[sizeof(MAGIC)];
+    uint32_t              version;
+    uint32_t              block_size;    ///< The number of values in a block.
+    int64_t               pid;           ///< The process writing the file.
+    uint64_t              count;         ///< The number of metrics.
+    uint64_t              names_offset;  ///< Of the name table, an array of @c count NameEntry.
+    uint64_t              values_offset; ///< Of the values, an array of @c count ValueType.
+    uint64_t              size;          ///< Of the file.
+    std::atomic<uint64_t> sequence;      ///< Odd while the values are written.
+    std::atomic<uint32_t> retired;       ///< Non-zero once the file is replaced.
+    uint32_t              reserved;
+    ValueType             updated; ///< When the values were written, in milliseconds since the epoch.
+  };
+
+  struct NameEntry {
+    uint32_t offset; ///< Of the name, from the start of the file.
+    uint32_t length;
+  };
+
+  /// Copies the Metrics into the file.
+  class Writer
+  {
+  public:
+    explicit Writer(std::string path) : _path(std::move(path)) {}
+    Writer(const Writer &)            = delete;
+    Writer &operator=(const Writer &) = delete;
+    ~Writer();
+
+    /** Write the values of @a metrics, and the names too if they changed.
+
+        @return @c false, with @c errno set, if the file could not be written.
+     */
+    bool update(const Metrics &metrics = Metrics::instance());
+
+    const std::string &
+    path() const
+    {
+      return _path;
+    }
+
+  private:
+    bool create(const Metrics &metrics, uint64_t generation);
+
+    std::string _path;
+    Header     *_header     = nullptr;
+    uint64_t    _generation = 0;
+  };
+
+  /// Reads the file.
+  class Reader
+  {
+  public:
+    Reader() = default;
+    Reader(const Reader &)            = delete;
+    Reader &operator=(const Reader &) = delete;
+    ~Reader();
+
+    /** Map the file at @a path.
+
+        @return @c false, with @c errno set, if it is not a metrics file of this VERSION.
+     */
+    bool open(std::string_view path);
+    void close();
+
+    bool
+    is_open() const
+    {
+      return _header != nullptr;
+    }
+
+    /** Copy the values, as of one update of the file. The file is mapped again first if it was
+        replaced since it was mapped.
+
+        @return @c false if there is no file, or if the process writing it is gone.
+     */
+    bool refresh();
+
+    /// @return The index of the metric @a name, or -1 if there is none.
+    int64_t find(std::string_view name) const;
+
+    /// @return The number of metrics.
+    size_t
+    size() const
+    {
+      return _names.size();
+    }
+
+    std::string_view
+    name(size_t index) const
+    {
+      return _names[index];
+    }
+
+    /// @return The value of the metric at @a index, as of the last refresh.
+    int64_t
+    value(size_t index) const
+    {
+      return _values[index];
+    }
+
+    /// @return The process writing the file.
+    int64_t
+    pid() const
+    {
+      return _header ? _header->pid : 0;
+    }
+
+    /// @return When the values were written, as of the last refresh, in milliseconds since the epoch.
+    int64_t
+    updated() const
+    {
+      return _updated;
+    }
+
+  private:
+    std::string                                  _path;
+    const Header                                *_header = nullptr;
+    std::vector<std::string_view>                _names;
+    std::unordered_map<std::string_view, size_t> _index;
+    std::vector<int64_t>                         _values;
+    int64_t                                      _updated = 0;
+  };
+};
+
+} // namespace ts
@@ -33,6 +33,7 @@
 #include "tscore/ink_platform.h"
 
 #include <cstring>
+#include <utility>
 
 void
 AggregateWriteBuffer::add(Doc const *doc, int approx_size)
@@ -51,9 +52,32 @@ AggregateWriteBuffer::emplace(int approx_size)
   return result;
 }
 
+void
+AggregateWriteBuffer::begin_flush()
+{
+  ink_assert(!this->is_flushing() && !this->is_empty());
+  std::swap(this->_buffer, this->_flush_buffer);
+  this->_flush_len  = this->_buffer_pos;
+  this->_buffer_pos = 0;
+}
+
+void
+AggregateWriteBuffer::end_flush()
+{
+  this->_flush_len = 0;
+}
+
 bool
 AggregateWriteBuffer::flush(int fd, off_t write_pos) const
 {
+  if (this->is_flushing()) {
+    int r = pwrite(fd, this->_flush_buffer, this->_flush_len, write_pos);
+    if (r != this->_flush_len) {
+      ink_assert(!"flushing agg buffer failed");
+      return false;
+    }
+    write_pos += this->_flush_len;
+  }
   int r = pwrite(fd, this->_buffer, this->_buffer_pos, write_pos);
   if (r != this->_buffer_pos) {
     ink_assert(!"flushing agg buffer failed");
@@ -65,6 +89,12 @@ AggregateWriteBuffer::flush(int fd, off_t write_pos) const
 void
 AggregateWriteBuffer::copy_from(char *dest, int offset, size_t nbytes) const
 {
+  if (offset < this->_flush_len) {
+    ink_assert((offset + nbytes) <= static_cast<size_t>(this->_flush_len));
+    memcpy(dest, this->_flush_buffer + offset, nbytes);
+    return;
+  }
+  offset -= this->_flush_len;
   ink_assert((offset + nbytes) <= static_cast<size_t>(this->_buffer_pos));
   memcpy(dest, this->_buffer + offset, nbytes);
 }
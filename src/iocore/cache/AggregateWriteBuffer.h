@@ -37,6 +37,14 @@
 
 struct CacheVC;
 
+/**
+ * A double buffered aggregation buffer.
+ *
+ * Documents are copied into the filling buffer. When it is written to disk,
+ * it is handed over with begin_flush() and documents are copied into the
+ * other buffer while the write is in progress. The documents of the flushing
+ * buffer come first on disk, followed by the documents of the filling buffer.
+ */
 class AggregateWriteBuffer
 {
 public:
@@ -44,9 +52,15 @@ public:
   {
     this->_buffer = static_cast<char *>(ats_memalign(ats_pagesize(), AGG_SIZE));
     memset(this->_buffer, 0, AGG_SIZE);
+    this->_flush_buffer = static_cast<char *>(ats_memalign(ats_pagesize(), AGG_SIZE));
+    memset(this->_flush_buffer, 0, AGG_SIZE);
   }
 
-  ~AggregateWriteBuffer() { ats_free(this->_buffer); }
+  ~AggregateWriteBuffer()
+  {
+    ats_free(this->_buffer);
+    ats_free(this->_flush_buffer);
+  }
 
   AggregateWriteBuffer(AggregateWriteBuffer const &)            = delete;
   AggregateWriteBuffer &operator=(AggregateWriteBuffer const &) = delete;
@@ -56,12 +70,36 @@ public:
   AggregateWriteBuffer &operator=(AggregateWriteBuffer &&other) = delete;
 
   /**
-   * Check whether the internal buffer is empty.
+   * Check whether the filling buffer is empty.
    *
    * @return Returns true if the buffer is empty, otherwise false.
    */
   bool is_empty() const;
 
+  /**
+   * Hand the filling buffer over to be written to disk.
+   *
+   * The documents are moved to the flushing buffer, which stays unchanged
+   * until end_flush() is called, and the filling buffer is empty again.
+   * This method may only be called if no flush is in progress.
+   */
+  void begin_flush();
+
+  /**
+   * Note that the flushing buffer was written to disk.
+   *
+   * The caller is expected to move the write position past the flushed
+   * documents, so that the filling buffer starts at the write position.
+   */
+  void end_flush();
+
+  /**
+   * Check whether a buffer is being written to disk.
+   *
+   * @return Returns true if begin_flush() was called but end_flush() was not.
+   */
+  bool is_flushing() const;
+
   /**
    * Add a new document to the buffer.
    *
@@ -107,13 +145,14 @@ public:
   Doc *emplace(int approx_size);
 
   /**
-   * Flush the internal buffer to disk.
+   * Flush the internal buffers to disk.
    *
    * This method should be called during shutdown. It must not be called
    * during regular operation.
    *
-   * Flushing the buffer only writes the buffer to disk; it does not
-   * modify the contents of the buffer. To reset the buffer, call
+   * The flushing buffer, if any, is written again followed by the filling
+   * buffer. Flushing only writes the buffers to disk; it does not modify
+   * their contents. To reset the buffers, call end_flush() and
    * reset_buffer_pos().
    *
    * @param fd File descriptor to write to.
@@ -123,9 +162,11 @@ public:
   bool flush(int fd, off_t write_pos) const;
 
   /**
-   * Copy part of the buffer.
+   * Copy part of the buffers.
    *
-   * The range of bytes to copy must fit within the written buffer.
+   * The offset is relative to the start of the flushing buffer if a flush
+   * is in progress, and to the start of the filling buffer otherwise. The
+   * range of bytes to copy must fit within the written part of one buffer.
    *
    * @param dest: The destination buffer.
    * @param offset: Byte offset to begin copying at.
@@ -140,12 +181,16 @@ public:
   void                                     reset_buffer_pos();
   int                                      get_bytes_pending_aggregation() const;
   void                                     add_bytes_pending_aggregation(int size);
+  char                                    *get_flush_buffer();
+  int                                      get_flush_len() const;
 
 private:
   Queue<CacheVC, Continuation::Link_link> _pending_writers;
   char                                   *_buffer                    = nullptr;
   int                                     _bytes_pending_aggregation = 0;
   int                                     _buffer_pos                = 0;
+  char                                   *_flush_buffer              = nullptr;
+  int                                     _flush_len                 = 0;
 };
 
 inline Queue<CacheVC, Continuation::Link_link> &
@@ -195,3 +240,21 @@ AggregateWriteBuffer::is_empty() const
 {
   return this->_buffer_pos == 0;
 }
+
+inline char *
+AggregateWriteBuffer::get_flush_buffer()
+{
+  return this->_flush_buffer;
+}
+
+inline int
+AggregateWriteBuffer::get_flush_len() const
+{
+  return this->_flush_len;
+}
+
+inline bool
+AggregateWriteBuffer::is_flushing() const
+{
+  return this->_flush_len != 0;
+}
@@ -23,6 +23,9 @@
 
 #include "iocore/cache/Cache.h"
 
+#include "CacheAdmission.h"
+#include "CachePurgeIndex.h"
+#include "CacheTier.h"
 #include "P_CacheDoc.h"
 // Cache Inspector and State Pages
 #include "P_CacheTest.h"
@@ -62,6 +65,8 @@ int     cache_config_ram_cache_use_seen_filter     = 1;
 int     cache_config_http_max_alts                 = 3;
 int     cache_config_log_alternate_eviction        = 0;
 int     cache_config_dir_sync_frequency            = 60;
+int     cache_config_dir_read_size                 = 4 * 1024 * 1024;
+int64_t cache_config_dir_recovery_window           = 0;
 int     cache_config_permit_pinning                = 0;
 int     cache_config_select_alternate              = 1;
 int     cache_config_max_doc_size                  = 0;
@@ -72,6 +77,7 @@ int     cache_config_hit_evacuate_percent          = 10;
 int     cache_config_hit_evacuate_size_limit       = 0;
 int     cache_config_force_sector_size             = 0;
 int     cache_config_target_fragment_size          = DEFAULT_TARGET_FRAGMENT_SIZE;
+int     cache_config_max_fragment_size             = 0;
 int     cache_config_agg_write_backlog             = AGG_SIZE * 2;
 int     cache_config_enable_checksum               = 0;
 int     cache_config_alt_rewrite_max_size          = 4096;
@@ -79,7 +85,17 @@ int     cache_config_read_while_writer             = 0;
 int     cache_config_mutex_retry_delay             = 2;
 int     cache_read_while_writer_retry_delay        = 50;
 int     cache_config_read_while_writer_max_retries = 10;
+int     cache_config_rww_fanout_fragments          = 4;
 int     cache_config_persist_bad_disks             = false;
+int     cache_config_purge_index_enabled           = 0;
+int64_t cache_config_purge_index_max_entries       = 1000000;
+char   *cache_config_purge_index_header            = nullptr;
+char   *cache_config_purge_index_filename          = nullptr;
+int     cache_config_tier_max_copies               = 16;
+int64_t cache_config_tier_max_copy_size            = 16 * 1024 * 1024;
+int     cache_config_tier_demote                   = 1;
+int     cache_config_admission_enabled             = 0;
+int     cache_config_admission_min_requests        = 2;
 
 // Globals
 
@@ -98,6 +114,7 @@ ClassAllocator<EvacuationBlock>    evacuationBlockAllocator("evacuationBlock");
 ClassAllocator<CacheRemoveCont>    cacheRemoveContAllocator("cacheRemoveCont");
 ClassAllocator<EvacuationKey>      evacuationKeyAllocator("evacuationKey");
 std::unordered_set<std::string>    known_bad_disks;
+std::string                        cache_purge_index_path;
 
 namespace
 {
@@ -271,6 +288,7 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
   total_initialized_vol = 0;
   total_nvol            = 0;
   total_good_nvol       = 0;
+  open_time             = ink_get_hrtime();
 
   REC_EstablishStaticConfigInt32(cache_config_min_average_object_size, "proxy.config.cache.min_average_object_size");
   Dbg(dbg_ctl_cache_init, "Cache::open - proxy.config.cache.min_average_object_size = %d", cache_config_min_average_object_size);
@@ -496,6 +514,9 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, const
   CACHE_TRY_LOCK(lock, cont->mutex, this_ethread());
   ink_assert(lock.is_locked());
   StripeSM *stripe = key_to_stripe(key, hostname, host_len);
+  if (StripeSM *fast = key_to_fast_stripe(key, hostname, host_len); fast && type == CACHE_FRAG_TYPE_HTTP) {
+    cache_tier_remove(fast, key);
+  }
   // coverity[var_decl]
   Dir result;
   dir_clear(&result); // initialized here, set result empty so we can recognize missed lock
@@ -556,11 +577,22 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
   ink_assert(caches[type] == this);
 
   StripeSM     *stripe = key_to_stripe(key, hostname, host_len);
+  StripeSM     *fast   = key_to_fast_stripe(key, hostname, host_len);
   Dir           result, *last_collision = nullptr;
   ProxyMutex   *mutex = cont->mutex.get();
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
 
+  // A copy in the fast tier is read from there.
+  if (fast) {
+    CACHE_TRY_LOCK(lock, fast->mutex, mutex->thread_holding);
+    if (lock.is_locked() && !fast->open_read(key) && dir_probe(key, fast, &result, &last_collision)) {
+      stripe = fast;
+      fast   = nullptr;
+    }
+    last_collision = nullptr;
+  }
+
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked() || (od = stripe->open_read(key)) || dir_probe(key, stripe, &result, &last_collision)) {
@@ -588,6 +620,9 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
       goto Lwriter;
     }
     // hit
+    if (fast) {
+      cache_tier_promote(stripe, fast, key);
+    }
     c->dir = c->first_dir = result;
     c->last_collision     = last_collision;
     SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
@@ -603,6 +638,7 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
 Lmiss:
   Metrics::Counter::increment(cache_rsb.status[static_cast<int>(CacheOpType::Read)].failure);
   Metrics::Counter::increment(stripe->cache_vol->vol_rsb.status[static_cast<int>(CacheOpType::Read)].failure);
+  cache_admission_read_miss(stripe->cache_vol, key);
   cont->handleEvent(CACHE_EVENT_OPEN_READ_FAILED, reinterpret_cast<void *>(-ECACHE_NO_DOC));
   return ACTION_RESULT_DONE;
 Lwriter:
@@ -630,11 +666,19 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
   }
 
   ink_assert(caches[type] == this);
-  intptr_t err        = 0;
-  int      if_writers = reinterpret_cast<uintptr_t>(info) == CACHE_ALLOW_MULTIPLE_WRITES;
-  CacheVC *c          = new_CacheVC(cont);
-  c->vio.op           = VIO::WRITE;
-  c->first_key        = *key;
+  intptr_t  err        = 0;
+  int       if_writers = reinterpret_cast<uintptr_t>(info) == CACHE_ALLOW_MULTIPLE_WRITES;
+  StripeSM *stripe     = key_to_stripe(key, hostname, host_len);
+
+  // A new object is only written once it was requested often enough, an update always is.
+  if ((!info || if_writers) && !cache_admission_admit(stripe->cache_vol, key)) {
+    cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, reinterpret_cast<void *>(-ECACHE_NOT_ADMITTED));
+    return ACTION_RESULT_DONE;
+  }
+
+  CacheVC *c   = new_CacheVC(cont);
+  c->vio.op    = VIO::WRITE;
+  c->first_key = *key;
   /*
      The transition from single fragment document to a multi-fragment document
      would cause a problem if the key and the first_key collide. In case of
@@ -645,11 +689,14 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
   do {
     rand_CacheKey(&c->key);
   } while (DIR_MASK_TAG(c->key.slice32(2)) == DIR_MASK_TAG(c->first_key.slice32(2)));
-  c->earliest_key  = c->key;
-  c->frag_type     = CACHE_FRAG_TYPE_HTTP;
-  c->stripe        = key_to_stripe(key, hostname, host_len);
-  StripeSM *stripe = c->stripe;
-  c->info          = info;
+  c->earliest_key = c->key;
+  c->frag_type    = CACHE_FRAG_TYPE_HTTP;
+  c->stripe       = stripe;
+  c->info         = info;
+  // The copy in the fast tier is stale once the object changes.
+  if (StripeSM *fast = key_to_fast_stripe(key, hostname, host_len)) {
+    cache_tier_remove(fast, key);
+  }
   if (c->info && reinterpret_cast<uintptr_t>(info) != CACHE_ALLOW_MULTIPLE_WRITES) {
     /*
        Update has the following code paths :
@@ -798,6 +845,31 @@ Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len)
   }
 }
 
+/* The fast tier stripe for the key, from the same host record as
+   key_to_stripe(), or nullptr if that record does not have stripes in
+   both tiers.
+ */
+StripeSM *
+Cache::key_to_fast_stripe(const CacheKey *key, const char *hostname, int host_len)
+{
+  ReplaceablePtr<CacheHostTable>::ScopedReader hosttable(&this->hosttable);
+
+  uint32_t               h        = (key->slice32(2) >> DIR_TAG_WIDTH) % STRIPE_HASH_TABLE_SIZE;
+  const CacheHostRecord *host_rec = &hosttable->gen_host_rec;
+
+  if (hosttable->m_numEntries > 0 && host_len) {
+    CacheHostResult res;
+    hosttable->Match(hostname, host_len, &res);
+    if (res.record && res.record->vol_hash_table) {
+      host_rec = res.record;
+    }
+  }
+  if (unsigned short *hash_table = host_rec->fast_hash_table; hash_table) {
+    return host_rec->stripes[hash_table[h]];
+  }
+  return nullptr;
+}
+
 int
 FragmentSizeUpdateCb(const char * /* name ATS_UNUSED */, RecDataT /* data_type ATS_UNUSED */, RecData data,
                      void * /* cookie ATS_UNUSED */)
@@ -841,6 +913,12 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_dir_sync_frequency, "proxy.config.cache.dir.sync_frequency");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.sync_frequency = %d", cache_config_dir_sync_frequency);
 
+  REC_EstablishStaticConfigInt32(cache_config_dir_read_size, "proxy.config.cache.dir.read_size");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.read_size = %d", cache_config_dir_read_size);
+
+  REC_EstablishStaticConfigInteger(cache_config_dir_recovery_window, "proxy.config.cache.dir.recovery_window");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.recovery_window = %" PRId64, cache_config_dir_recovery_window);
+
   REC_EstablishStaticConfigInt32(cache_config_select_alternate, "proxy.config.cache.select_alternate");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.select_alternate = %d", cache_config_select_alternate);
 
@@ -857,6 +935,9 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_read_while_writer_retry_delay, "proxy.config.cache.read_while_writer_retry.delay");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer_retry.delay = %dms", cache_read_while_writer_retry_delay);
 
+  REC_EstablishStaticConfigInt32(cache_config_rww_fanout_fragments, "proxy.config.cache.read_while_writer.fanout_fragments");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer.fanout_fragments = %d", cache_config_rww_fanout_fragments);
+
   REC_EstablishStaticConfigInt32(cache_config_hit_evacuate_percent, "proxy.config.cache.hit_evacuate_percent");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.hit_evacuate_percent = %d", cache_config_hit_evacuate_percent);
 
@@ -873,6 +954,9 @@ ink_cache_init(ts::ModuleVersion v)
     cache_config_target_fragment_size = DEFAULT_TARGET_FRAGMENT_SIZE;
   }
 
+  REC_EstablishStaticConfigInt32(cache_config_max_fragment_size, "proxy.config.cache.max_fragment_size");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.max_fragment_size = %d", cache_config_max_fragment_size);
+
   REC_EstablishStaticConfigInt32(cache_config_max_disk_errors, "proxy.config.cache.max_disk_errors");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.max_disk_errors = %d", cache_config_max_disk_errors);
 
@@ -918,6 +1002,36 @@ ink_cache_init(ts::ModuleVersion v)
             bad_disks_path.c_str());
   }
 
+  REC_EstablishStaticConfigInt32(cache_config_tier_max_copies, "proxy.config.cache.tier.max_copies");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.max_copies = %d", cache_config_tier_max_copies);
+  REC_EstablishStaticConfigInteger(cache_config_tier_max_copy_size, "proxy.config.cache.tier.max_copy_size");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.max_copy_size = %" PRId64, cache_config_tier_max_copy_size);
+  REC_EstablishStaticConfigInt32(cache_config_tier_demote, "proxy.config.cache.tier.demote");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.demote = %d", cache_config_tier_demote);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_enabled, "proxy.config.cache.admission.enabled");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.enabled = %d", cache_config_admission_enabled);
+  REC_EstablishStaticConfigInt32(cache_config_admission_min_requests, "proxy.config.cache.admission.min_requests");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.min_requests = %d", cache_config_admission_min_requests);
+
+  REC_EstablishStaticConfigInt32(cache_config_purge_index_enabled, "proxy.config.cache.purge_index.enabled");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.purge_index.enabled = %d", cache_config_purge_index_enabled);
+  if (cache_config_purge_index_enabled) {
+    REC_EstablishStaticConfigInteger(cache_config_purge_index_max_entries, "proxy.config.cache.purge_index.max_entries");
+    REC_ReadConfigStringAlloc(cache_config_purge_index_header, "proxy.config.cache.purge_index.header");
+    REC_ReadConfigStringAlloc(cache_config_purge_index_filename, "proxy.config.cache.purge_index.filename");
+    Dbg(dbg_ctl_cache_init, "proxy.config.cache.purge_index.max_entries = %" PRId64, cache_config_purge_index_max_entries);
+
+    cache_purge_index = new CachePurgeIndex(cache_config_purge_index_max_entries);
+    if (cache_config_purge_index_filename && *cache_config_purge_index_filename) {
+      cache_purge_index_path = Layout::relative_to(Layout::get()->localstatedir, cache_config_purge_index_filename);
+      // not having an index file is not an error, the index starts empty.
+      if (int64_t n = cache_purge_index->load(cache_purge_index_path); n >= 0) {
+        Note("loaded %" PRId64 " objects into the cache purge index from %s", n, cache_purge_index_path.c_str());
+      }
+    }
+  }
+
   Result result = theCacheStore.read_config();
   if (result.failed()) {
     Fatal("Failed to read cache configuration %s: %s", ts::filename::STORAGE, result.message());
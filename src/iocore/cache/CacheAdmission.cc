@@ -0,0 +1,189 @@
+/** @file
+
+  Admission of writes to a cache volume by how often their objects are requested.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "CacheAdmission.h"
+
+// inkcache
+#include "P_CacheInternal.h"
+#include "Stripe.h"
+
+// ts
+#include "tsutil/Metrics.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+constexpr uint64_t MIN_ENTRIES         = 1024;
+constexpr int      COUNTERS_PER_WORD   = 16;
+constexpr int      DOORKEEPER_HASHES   = 3;
+constexpr int      DOORKEEPER_BITS     = 8; ///< Per entry, for about 3% false positives.
+constexpr uint64_t COUNTER_MASK        = 0xF;
+constexpr uint64_t HALVE_COUNTERS_MASK = 0x7777777777777777ULL;
+
+/// The @a i th of a family of hashes of @a key, from its two halves.
+inline uint64_t
+key_hash(const CacheKey &key, int i)
+{
+  return key.u64[0] + i * (key.u64[1] | 1);
+}
+} // end anonymous namespace
+
+CacheAdmission::CacheAdmission(uint64_t entries)
+{
+  uint64_t counters = std::bit_ceil(std::max(entries, MIN_ENTRIES));
+
+  _counter_mask    = counters - 1;
+  _doorkeeper_mask = counters * DOORKEEPER_BITS - 1;
+  _sample_size     = counters;
+  _sketch          = std::make_unique<std::atomic<uint64_t>[]>(DEPTH * counters / COUNTERS_PER_WORD);
+  _doorkeeper      = std::make_unique<std::atomic<uint64_t>[]>(counters * DOORKEEPER_BITS / 64);
+}
+
+bool
+CacheAdmission::admit(const CacheKey &key, int min_requests)
+{
+  // The doorkeeper holds the first request for a key, the sketch the later ones.
+  if (doorkeeper_test_and_set(key)) {
+    increment(key);
+  }
+
+  bool admitted = 1 + static_cast<int>(estimate(key)) >= min_requests;
+
+  if (_requests.fetch_add(1, std::memory_order_relaxed) + 1 >= _sample_size) {
+    age();
+  }
+  return admitted;
+}
+
+bool
+CacheAdmission::rejected(const CacheKey &key, int min_requests) const
+{
+  uint32_t count = estimate(key);
+
+  return (count > 0 || doorkeeper_test(key)) && 1 + static_cast<int>(count) < min_requests;
+}
+
+bool
+CacheAdmission::doorkeeper_test(const CacheKey &key) const
+{
+  for (int i = 0; i < DOORKEEPER_HASHES; ++i) {
+    uint64_t bit = (key_hash(key, DEPTH + i) >> 7) & _doorkeeper_mask;
+    if (!(_doorkeeper[bit / 64].load(std::memory_order_relaxed) & (1ULL << (bit % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+CacheAdmission::doorkeeper_test_and_set(const CacheKey &key)
+{
+  bool found = true;
+
+  for (int i = 0; i < DOORKEEPER_HASHES; ++i) {
+    uint64_t bit  = (key_hash(key, DEPTH + i) >> 7) & _doorkeeper_mask;
+    uint64_t mask = 1ULL << (bit % 64);
+    if (!(_doorkeeper[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask)) {
+      found = false;
+    }
+  }
+  return found;
+}
+
+uint32_t
+CacheAdmission::estimate(const CacheKey &key) const
+{
+  uint32_t count = MAX_COUNT;
+
+  for (int row = 0; row < DEPTH; ++row) {
+    uint64_t counter = row * (_counter_mask + 1) + (key_hash(key, row) & _counter_mask);
+    uint64_t word    = _sketch[counter / COUNTERS_PER_WORD].load(std::memory_order_relaxed);
+    count            = std::min(count, static_cast<uint32_t>((word >> (counter % COUNTERS_PER_WORD * 4)) & COUNTER_MASK));
+  }
+  return count;
+}
+
+void
+CacheAdmission::increment(const CacheKey &key)
+{
+  // Only the smallest counters are incremented, which keeps the estimate of a key from growing with the others in its rows.
+  uint32_t count = estimate(key);
+
+  if (count >= MAX_COUNT) {
+    return;
+  }
+  for (int row = 0; row < DEPTH; ++row) {
+    uint64_t               counter = row * (_counter_mask + 1) + (key_hash(key, row) & _counter_mask);
+    int                    shift   = counter % COUNTERS_PER_WORD * 4;
+    std::atomic<uint64_t> &word    = _sketch[counter / COUNTERS_PER_WORD];
+    uint64_t               value   = word.load(std::memory_order_relaxed);
+
+    while (((value >> shift) & COUNTER_MASK) == count &&
+           !word.compare_exchange_weak(value, value + (1ULL << shift), std::memory_order_relaxed)) {}
+  }
+}
+
+void
+CacheAdmission::age()
+{
+  // Requests counted while another thread ages the filter are kept, or halved with the rest.
+  if (_aging.test_and_set(std::memory_order_acquire)) {
+    return;
+  }
+  for (uint64_t i = 0; i < DEPTH * (_counter_mask + 1) / COUNTERS_PER_WORD; ++i) {
+    uint64_t value = _sketch[i].load(std::memory_order_relaxed);
+    while (!_sketch[i].compare_exchange_weak(value, (value >> 1) & HALVE_COUNTERS_MASK, std::memory_order_relaxed)) {}
+  }
+  for (uint64_t i = 0; i < (_doorkeeper_mask + 1) / 64; ++i) {
+    _doorkeeper[i].store(0, std::memory_order_relaxed);
+  }
+  _requests.store(0, std::memory_order_relaxed);
+  _aging.clear(std::memory_order_release);
+}
+
+bool
+cache_admission_admit(CacheVol *vol, const CacheKey *key)
+{
+  if (!vol->admission) {
+    return true;
+  }
+  if (vol->admission->admit(*key, cache_config_admission_min_requests)) {
+    Metrics::Counter::increment(cache_rsb.admission_admitted);
+    Metrics::Counter::increment(vol->vol_rsb.admission_admitted);
+    return true;
+  }
+  Metrics::Counter::increment(cache_rsb.admission_rejected);
+  Metrics::Counter::increment(vol->vol_rsb.admission_rejected);
+  return false;
+}
+
+void
+cache_admission_read_miss(CacheVol *vol, const CacheKey *key)
+{
+  if (vol->admission && vol->admission->rejected(*key, cache_config_admission_min_requests)) {
+    Metrics::Counter::increment(cache_rsb.admission_rejected_misses);
+    Metrics::Counter::increment(vol->vol_rsb.admission_rejected_misses);
+  }
+}
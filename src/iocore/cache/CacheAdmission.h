@@ -0,0 +1,93 @@
+/** @file
+
+  Admission of writes to a cache volume by how often their objects are requested.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/cache/CacheDefs.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+struct CacheVol;
+
+/*
+  Most objects written to the cache are never read back, yet each of them
+  takes the place of an object that may have been. With
+  proxy.config.cache.admission.enabled, or admission=true for a volume in
+  volume.config, a write of an object is only admitted once the object was
+  asked to be written proxy.config.cache.admission.min_requests times.
+
+  The first request for a key only sets its bits in a doorkeeper bloom
+  filter. Later requests count the key in a count-min sketch of 4 bit
+  counters. Both are sized by the directory entries of the volume, and are
+  aged once that many writes were asked for, halving the counters and
+  clearing the doorkeeper, so the counts follow the recent requests. They
+  are updated with atomic operations, without a lock.
+ */
+class CacheAdmission
+{
+public:
+  /// A filter for a volume of @a entries directory entries.
+  explicit CacheAdmission(uint64_t entries);
+
+  /**
+   * Count a request to write the object with @a key.
+   *
+   * @return @c true if the object was requested at least @a min_requests times and should be written.
+   */
+  bool admit(const CacheKey &key, int min_requests);
+
+  /// @return @c true if the last write of @a key was not admitted with @a min_requests.
+  bool rejected(const CacheKey &key, int min_requests) const;
+
+  /// Counters saturate at this count.
+  static constexpr int MAX_COUNT = 15;
+
+private:
+  static constexpr int DEPTH = 4; ///< Rows of the sketch.
+
+  bool     doorkeeper_test(const CacheKey &key) const;
+  bool     doorkeeper_test_and_set(const CacheKey &key);
+  uint32_t estimate(const CacheKey &key) const;
+  void     increment(const CacheKey &key);
+  void     age();
+
+  uint64_t                                 _counter_mask;    ///< Counters in a row of the sketch, less one.
+  uint64_t                                 _doorkeeper_mask; ///< Bits in the doorkeeper, less one.
+  uint64_t                                 _sample_size;     ///< Requests between agings.
+  std::unique_ptr<std::atomic<uint64_t>[]> _sketch;          ///< 16 counters per word.
+  std::unique_ptr<std::atomic<uint64_t>[]> _doorkeeper;
+  std::atomic<uint64_t>                    _requests{0};
+  std::atomic_flag                         _aging = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * Count a request to write the object with @a key to @a vol.
+ *
+ * @return @c true if the write is admitted, or @a vol admits all writes.
+ */
+bool cache_admission_admit(CacheVol *vol, const CacheKey *key);
+
+/// Count a read miss of @a key in @a vol on an object whose last write was not admitted.
+void cache_admission_read_miss(CacheVol *vol, const CacheKey *key);
@@ -222,6 +222,7 @@ dir_init_segment(int s, Stripe *stripe)
   Dir *seg                    = stripe->dir_segment(s);
   int  l, b;
   memset(static_cast<void *>(seg), 0, SIZEOF_DIR * DIR_DEPTH * stripe->buckets);
+  stripe->mark_dir_segment_dirty(s);
   for (l = 1; l < DIR_DEPTH; l++) {
     for (b = 0; b < stripe->buckets; b++) {
       Dir *bucket = dir_bucket(b, seg);
@@ -309,12 +310,14 @@ unlink_from_freelist(Dir *e, int s, Stripe *stripe)
   Dir *p   = dir_from_offset(dir_prev(e), seg);
   if (p) {
     dir_set_next(p, dir_next(e));
+    stripe->mark_dir_dirty(p);
   } else {
     stripe->header->freelist[s] = dir_next(e);
   }
   Dir *n = dir_from_offset(dir_next(e), seg);
   if (n) {
     dir_set_prev(n, dir_prev(e));
+    stripe->mark_dir_dirty(n);
   }
 }
 
@@ -324,14 +327,17 @@ dir_delete_entry(Dir *e, Dir *p, int s, Stripe *stripe)
   Dir *seg              = stripe->dir_segment(s);
   int  no               = dir_next(e);
   stripe->header->dirty = 1;
+  stripe->mark_dir_dirty(e);
   if (p) {
     unsigned int fo = stripe->header->freelist[s];
     unsigned int eo = dir_to_offset(e, seg);
     dir_clear(e);
     dir_set_next(p, no);
+    stripe->mark_dir_dirty(p);
     dir_set_next(e, fo);
     if (fo) {
       dir_set_prev(dir_from_offset(fo, seg), eo);
+      stripe->mark_dir_dirty(dir_from_offset(fo, seg));
     }
     stripe->header->freelist[s] = eo;
   } else {
@@ -409,6 +415,7 @@ dir_clear_range(off_t start, off_t end, Stripe *stripe)
       Metrics::Gauge::decrement(cache_rsb.direntries_used);
       Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
       dir_set_offset(e, 0); // delete
+      stripe->mark_dir_dirty(e);
     }
   }
   dir_clean_vol(stripe);
@@ -445,6 +452,7 @@ freelist_clean(int s, Stripe *stripe)
         Metrics::Gauge::decrement(cache_rsb.direntries_used);
         Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
         dir_set_offset(e, 0); // delete
+        stripe->mark_dir_dirty(e);
       }
     }
   }
@@ -469,6 +477,7 @@ freelist_pop(int s, Stripe *stripe)
   Dir *h = dir_from_offset(stripe->header->freelist[s], seg);
   if (h) {
     dir_set_prev(h, 0);
+    stripe->mark_dir_dirty(h);
   }
   return e;
 }
@@ -480,8 +489,10 @@ dir_free_entry(Dir *e, int s, Stripe *stripe)
   unsigned int fo  = stripe->header->freelist[s];
   unsigned int eo  = dir_to_offset(e, seg);
   dir_set_next(e, fo);
+  stripe->mark_dir_dirty(e);
   if (fo) {
     dir_set_prev(dir_from_offset(fo, seg), eo);
+    stripe->mark_dir_dirty(dir_from_offset(fo, seg));
   }
   stripe->header->freelist[s] = eo;
 }
@@ -609,6 +620,7 @@ Llink:
 
   dir_set_next(e, 0);
   dir_set_next(prev, dir_to_offset(e, seg));
+  stripe->mark_dir_dirty(prev);
 Lfill:
   dir_assign_data(e, to_part);
   dir_set_tag(e, key->slice32(2));
@@ -617,6 +629,7 @@ Lfill:
        bi, e, key->slice32(1), dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
   stripe->header->dirty = 1;
+  stripe->mark_dir_dirty(e);
   Metrics::Gauge::increment(cache_rsb.direntries_used);
   Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.direntries_used);
 
@@ -699,6 +712,7 @@ Llink:
 
   dir_set_next(e, 0);
   dir_set_next(prev, dir_to_offset(e, seg));
+  stripe->mark_dir_dirty(prev);
 Lfill:
   dir_assign_data(e, dir);
   dir_set_tag(e, t);
@@ -707,6 +721,7 @@ Lfill:
        stripe->fd, bi, e, t, dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
   stripe->header->dirty = 1;
+  stripe->mark_dir_dirty(e);
   return res;
 }
 
@@ -961,11 +976,14 @@ Lrestart:
     // AIO Thread
     if (!io.ok()) {
       Warning("vol write error during directory sync '%s'", gstripes[stripe_index]->hash_text.get());
+      // The copy being written no longer matches any state, rewrite all of it next time.
+      stripe->mark_dir_all_dirty();
       event = EVENT_NONE;
       goto Ldone;
     }
     Metrics::Counter::increment(cache_rsb.directory_sync_bytes, io.aio_result);
     Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_bytes, io.aio_result);
+    sync_bytes += io.aio_result;
     trigger = eventProcessor.schedule_in(this, SYNC_DELAY);
     return EVENT_CONT;
   }
@@ -1034,31 +1052,41 @@ Lrestart:
       stripe->header->sync_serial++;
       stripe->footer->sync_serial = stripe->header->sync_serial;
       CHECK_DIR(d);
-      memcpy(buf, stripe->raw_dir, dirlen);
+      // Only the pages changed since this copy was last written need to go out. The header is
+      // still written first and the footer last, so a torn write leaves their serials different.
+      stripe->copy_dirty_dir(stripe->header->sync_serial & 1, buf, pages);
       stripe->dir_sync_in_progress = true;
     }
     size_t B     = stripe->header->sync_serial & 1;
     off_t  start = stripe->skip + (B ? dirlen : 0);
+    off_t  end   = static_cast<off_t>(dirlen) - headerlen;
+
+    // skip the pages of the body which did not change
+    while (writepos && writepos < end && !pages[writepos / STORE_BLOCK_SIZE]) {
+      writepos += STORE_BLOCK_SIZE;
+    }
 
     if (!writepos) {
       // write header
       aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
       writepos += headerlen;
-    } else if (writepos < static_cast<off_t>(dirlen) - headerlen) {
-      // write part of body
-      int l = SYNC_MAX_WRITE;
-      if (writepos + l > static_cast<off_t>(dirlen) - headerlen) {
-        l = dirlen - headerlen - writepos;
+    } else if (writepos < end) {
+      // write the next run of dirty pages in the body
+      int l = STORE_BLOCK_SIZE;
+      while (l < SYNC_MAX_WRITE && writepos + l < end && pages[(writepos + l) / STORE_BLOCK_SIZE]) {
+        l += STORE_BLOCK_SIZE;
       }
       aio_write(stripe->fd, buf + writepos, l, start + writepos);
       writepos += l;
     } else if (writepos < static_cast<off_t>(dirlen)) {
-      ink_assert(writepos == (off_t)dirlen - headerlen);
+      ink_assert(writepos == end);
       // write footer
+      stripe->write_ahead.sync_footer(B, reinterpret_cast<StripteHeaderFooter *>(buf + writepos));
       aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
       writepos += headerlen;
     } else {
       stripe->dir_sync_in_progress = false;
+      stripe->write_ahead.sync_done(B, *reinterpret_cast<StripteHeaderFooter *>(buf + end));
       Metrics::Counter::increment(cache_rsb.directory_sync_count);
       Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_count);
       Metrics::Counter::increment(cache_rsb.directory_sync_time, ink_get_hrtime() - start_time);
@@ -1070,7 +1098,14 @@ Lrestart:
   }
 Ldone:
   // done
-  writepos = 0;
+  // The gauge sums the bytes written by the last sync of each stripe.
+  Metrics::Gauge::decrement(cache_rsb.directory_sync_interval_bytes, stripe->dir_sync_last_bytes);
+  Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.directory_sync_interval_bytes, stripe->dir_sync_last_bytes);
+  Metrics::Gauge::increment(cache_rsb.directory_sync_interval_bytes, sync_bytes);
+  Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.directory_sync_interval_bytes, sync_bytes);
+  stripe->dir_sync_last_bytes = sync_bytes;
+  sync_bytes                  = 0;
+  writepos                    = 0;
   ++stripe_index;
   goto Lrestart;
 }
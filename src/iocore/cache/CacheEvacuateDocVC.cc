@@ -33,6 +33,7 @@
 #include "P_CacheInternal.h"
 #include "StripeSM.h"
 #include "CacheEvacuateDocVC.h"
+#include "CacheTier.h"
 #include "PreservationTable.h"
 
 // tscore
@@ -199,3 +200,11 @@ Ldone:
   dir_lookaside_remove(&earliest_key, this->stripe);
   return free_CacheEvacuateDocVC(this);
 }
+
+int
+CacheEvacuateDocVC::tierCopyDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  ink_assert(this->stripe->mutex->thread_holding == this_ethread());
+  cache_tier_copied(this);
+  return free_CacheEvacuateDocVC(this);
+}
@@ -46,6 +46,7 @@ class CacheEvacuateDocVC : public CacheVC
 public:
   int evacuateDocDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */);
   int evacuateReadHead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */);
+  int tierCopyDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */);
 };
 
 extern ClassAllocator<CacheEvacuateDocVC> cacheEvacuateDocVConnectionAllocator;
@@ -0,0 +1,186 @@
+/** @file
+
+  Fragments of an object being written, shared with its readers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "CacheFanout.h"
+
+// inkcache
+#include "P_CacheDir.h"
+#include "P_CacheDoc.h"
+#include "P_CacheInternal.h"
+#include "StripeSM.h"
+
+// tscore
+#include "tscore/ink_assert.h"
+#include "tscore/Ptr.h"
+
+// ts
+#include "tsutil/DbgCtl.h"
+#include "tsutil/Metrics.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace
+{
+DbgCtl dbg_ctl_cache_fanout{"cache_fanout"};
+} // end anonymous namespace
+
+class CacheFanout : public RefCountObjInHeap
+{
+public:
+  explicit CacheFanout(CacheVC *writer) : mutex(new_ProxyMutex()), writer(writer) {}
+
+  struct Fragment {
+    CacheKey          key;
+    Ptr<IOBufferData> data;
+  };
+
+  Ptr<ProxyMutex> mutex;
+  CacheVC        *writer;
+  int             readers = 0;
+
+  /// The last fragments written, oldest first.
+  std::deque<Fragment> fragments;
+  /// Readers waiting for the next fragment.
+  std::vector<CacheVC *> waiters;
+
+  /// Wake the waiting readers, those that are busy find the fragment as they retry.
+  void
+  wake()
+  {
+    for (CacheVC *reader : waiters) {
+      MUTEX_TRY_LOCK(lock, reader->mutex, this_ethread());
+      // Only a reader waiting on its retry is woken, with the event it waits for.
+      if (lock.is_locked() && reader->trigger && reader->trigger->ethread) {
+        EThread *thread = reader->trigger->ethread;
+        int      event  = reader->trigger->callback_event;
+        reader->trigger->cancel();
+        reader->trigger = thread->schedule_imm(reader, event);
+      }
+    }
+    waiters.clear();
+  }
+
+  void
+  remove_waiter(CacheVC *reader)
+  {
+    if (auto spot = std::find(waiters.begin(), waiters.end(), reader); spot != waiters.end()) {
+      waiters.erase(spot);
+    }
+  }
+};
+
+void
+cache_fanout_attach(CacheVC *writer, CacheVC *reader)
+{
+  ink_assert(writer->mutex->thread_holding == this_ethread());
+  if (cache_config_rww_fanout_fragments <= 0 || reader->fanout) {
+    return;
+  }
+  if (!writer->fanout) {
+    writer->fanout = new CacheFanout(writer);
+    writer->fanout->refcount_inc();
+    Metrics::Counter::increment(cache_rsb.read_busy_fanout_writers);
+  }
+
+  CacheFanout *fanout = writer->fanout;
+  SCOPED_MUTEX_LOCK(lock, fanout->mutex, this_ethread());
+  fanout->refcount_inc();
+  ++fanout->readers;
+  reader->fanout = fanout;
+  Metrics::Counter::increment(cache_rsb.read_busy_fanout_readers);
+  Dbg(dbg_ctl_cache_fanout, "reader %p attached to writer %p, %d readers", reader, writer, fanout->readers);
+}
+
+void
+cache_fanout_detach(CacheVC *vc)
+{
+  CacheFanout *fanout = vc->fanout;
+
+  vc->fanout = nullptr;
+  {
+    SCOPED_MUTEX_LOCK(lock, fanout->mutex, this_ethread());
+    if (fanout->writer == vc) {
+      // The readers now find the writer gone as they retry.
+      fanout->writer = nullptr;
+      fanout->fragments.clear();
+      fanout->wake();
+    } else {
+      --fanout->readers;
+      fanout->remove_waiter(vc);
+    }
+  }
+  if (fanout->refcount_dec() == 0) {
+    fanout->free();
+  }
+}
+
+void
+cache_fanout_publish(CacheVC *writer)
+{
+  CacheFanout *fanout = writer->fanout;
+  StripeSM    *stripe = writer->stripe;
+
+  if (!fanout) {
+    return;
+  }
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+
+  SCOPED_MUTEX_LOCK(lock, fanout->mutex, this_ethread());
+  // Readers that fell behind read the fragments that were not copied as before.
+  if (fanout->readers > 0 && stripe->dir_agg_buf_valid(&writer->dir)) {
+    size_t            nbytes = dir_approx_size(&writer->dir);
+    Ptr<IOBufferData> data;
+
+    data = new_IOBufferData(iobuffer_size_to_index(nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    stripe->copy_from_aggregate_write_buffer(data->data(), writer->dir, nbytes);
+    fanout->fragments.push_back({writer->key, data});
+    while (fanout->fragments.size() > static_cast<size_t>(std::max(cache_config_rww_fanout_fragments, 1))) {
+      fanout->fragments.pop_front();
+    }
+  }
+  fanout->wake();
+}
+
+bool
+cache_fanout_read(CacheVC *reader)
+{
+  CacheFanout *fanout = reader->fanout;
+
+  SCOPED_MUTEX_LOCK(lock, fanout->mutex, this_ethread());
+  for (auto const &fragment : fanout->fragments) {
+    if (fragment.key == reader->key) {
+      Doc *doc = reinterpret_cast<Doc *>(fragment.data->data());
+      ink_assert(doc->magic == DOC_MAGIC && doc->key == reader->key);
+      reader->buf = fragment.data;
+      fanout->remove_waiter(reader);
+      Metrics::Counter::increment(cache_rsb.read_busy_fanout_bytes, doc->data_len());
+      return true;
+    }
+  }
+  if (fanout->writer && std::find(fanout->waiters.begin(), fanout->waiters.end(), reader) == fanout->waiters.end()) {
+    fanout->waiters.push_back(reader);
+  }
+  return false;
+}
@@ -0,0 +1,69 @@
+/** @file
+
+  Fragments of an object being written, shared with its readers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+struct CacheVC;
+
+/*
+  A reader of a multi fragment object that is still being written otherwise
+  finds each fragment by probing the directory under the stripe lock, reads
+  it from the aggregation buffer or the disk, and polls for fragments not
+  written yet. With many readers of a hot object every one of them does so.
+
+  Instead the first reader to attach gives the writer a fan-out. As the writer
+  writes a fragment it copies the Doc from the aggregation buffer once into a
+  reference counted IOBufferData, keeps the last
+  proxy.config.cache.read_while_writer.fanout_fragments of them, and wakes the
+  readers waiting for it. The readers share these buffers, and take them
+  without the stripe lock. A reader that falls further behind reads the
+  fragment as before.
+ */
+
+/**
+ * Attach @a reader to the fan-out of @a writer, which is created by the first reader.
+ *
+ * Called with the lock of @a writer held.
+ */
+void cache_fanout_attach(CacheVC *writer, CacheVC *reader);
+
+/**
+ * Detach the writer or a reader @a vc from its fan-out. The writer leaving wakes the waiting readers.
+ *
+ * Called as @a vc is freed.
+ */
+void cache_fanout_detach(CacheVC *vc);
+
+/**
+ * Share the fragment @a writer just wrote with its readers.
+ *
+ * Called with the stripe lock held, after the fragment at @a writer->dir was inserted in the directory.
+ */
+void cache_fanout_publish(CacheVC *writer);
+
+/**
+ * Take the fragment with @a reader->key from the writer into @a reader->buf.
+ *
+ * @return @c true if the writer has the fragment, else @a reader is woken as the writer writes the next one.
+ */
+bool cache_fanout_read(CacheVC *reader);
@@ -654,6 +654,7 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
     int         size             = 0;
     int         in_percent       = 0;
     bool        ramcache_enabled = true;
+    int         admission        = -1;
 
     while (true) {
       // skip all blank spaces at beginning of line
@@ -753,6 +754,18 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
           err = "Unexpected end of line";
           break;
         }
+      } else if (strcasecmp(tmp, "admission") == 0) { // match admission
+        tmp += 10;
+        if (!strcasecmp(tmp, "false")) {
+          tmp       += 5;
+          admission  = 0;
+        } else if (!strcasecmp(tmp, "true")) {
+          tmp       += 4;
+          admission  = 1;
+        } else {
+          err = "Unexpected end of line";
+          break;
+        }
       }
 
       // ends here
@@ -778,6 +791,7 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       configp->size             = size;
       configp->cachep           = nullptr;
       configp->ramcache_enabled = ramcache_enabled;
+      configp->admission        = admission;
       cp_queue.enqueue(configp);
       num_volumes++;
       if (scheme == CACHE_HTTP_TYPE) {
@@ -785,8 +799,8 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       } else {
         ink_release_assert(!"Unexpected non-HTTP cache volume");
       }
-      Dbg(dbg_ctl_cache_hosting, "added volume=%d, scheme=%d, size=%d percent=%d, ramcache enabled=%d", volume_number, scheme, size,
-          in_percent, ramcache_enabled);
+      Dbg(dbg_ctl_cache_hosting, "added volume=%d, scheme=%d, size=%d percent=%d, ramcache enabled=%d, admission=%d", volume_number,
+          scheme, size, in_percent, ramcache_enabled, admission);
     }
 
     tmp = bufTok.iterNext(&i_state);
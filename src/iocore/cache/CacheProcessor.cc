@@ -24,6 +24,9 @@
 #include "iocore/cache/Cache.h"
 #include "iocore/cache/CacheDefs.h"
 #include "iocore/cache/Store.h"
+#include "CacheAdmission.h"
+#include "CachePurgeIndex.h"
+#include "CacheTier.h"
 #include "P_CacheDisk.h"
 #include "P_CacheInternal.h"
 #include "StripeSM.h"
@@ -48,6 +51,7 @@
 #include "tsutil/DbgCtl.h"
 #include "tsutil/Metrics.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdlib>
 #include <cstring>
@@ -56,6 +60,8 @@
 #include <string>
 #include <system_error>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 static void    CachePeriodicMetricsUpdate();
 static int64_t cache_bytes_used(int index);
@@ -93,6 +99,7 @@ int                                    CacheProcessor::start_internal_flags = 0;
 int                                    CacheProcessor::auto_clear_flag      = 0;
 CacheProcessor                         cacheProcessor;
 extern std::unordered_set<std::string> known_bad_disks;
+extern std::string                     cache_purge_index_path;
 
 namespace
 {
@@ -101,6 +108,7 @@ DbgCtl dbg_ctl_cache_init{"cache_init"};
 DbgCtl dbg_ctl_cache_remove{"cache_remove"};
 DbgCtl dbg_ctl_cache_hosting{"cache_hosting"};
 DbgCtl dbg_ctl_ram_cache{"ram_cache"};
+DbgCtl dbg_ctl_cache_purge{"cache_purge"};
 
 } // end anonymous namespace
 
@@ -151,6 +159,9 @@ CachePeriodicMetricsUpdate()
 
     Metrics::Gauge::store(cache_rsb.bytes_used, total_sum);
     Metrics::Gauge::store(cache_rsb.percent_full, total ? (total_sum * 100) / total : 0);
+    if (cache_purge_index) {
+      Metrics::Gauge::store(cache_rsb.purge_index_entries, cache_purge_index->size());
+    }
   }
 }
 
@@ -279,6 +290,7 @@ CacheProcessor::start_internal(int flags)
         if (span->hash_base_string) {
           cache_disk->hash_base_string = ats_strdup(span->hash_base_string);
         }
+        cache_disk->fast_tier = span->fast_tier;
 
         if (sector_size < cache_config_force_sector_size) {
           sector_size = cache_config_force_sector_size;
@@ -517,8 +529,31 @@ rebuild_host_table(Cache *cache)
   }
 }
 
+namespace
+{
+enum class StripeTier { ANY, SLOW, FAST };
+
+bool
+in_tier(StripeSM const *stripe, StripeTier tier)
+{
+  return tier == StripeTier::ANY || stripe->disk->fast_tier == (tier == StripeTier::FAST);
+}
+
 void
-build_vol_hash_table(CacheHostRecord *cp)
+install_hash_table(unsigned short **table, unsigned short *ttable)
+{
+  unsigned short *old_table;
+
+  if (nullptr != (old_table = ink_atomic_swap(table, ttable))) {
+    new_Freer(old_table, CACHE_MEM_FREE_TIMEOUT);
+  }
+}
+
+/* Build the hash @a table over the stripes of @a cp in @a tier. The table
+   has indices into cp->stripes, so the tables of each tier share those.
+ */
+void
+build_stripe_hash_table(CacheHostRecord *cp, unsigned short **table, StripeTier tier)
 {
   int           num_vols = cp->num_vols;
   unsigned int *mapping  = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
@@ -532,7 +567,7 @@ build_vol_hash_table(CacheHostRecord *cp)
   uint64_t used     = 0;
   // initialize number of elements per vol
   for (int i = 0; i < num_vols; i++) {
-    if (DISK_BAD(cp->stripes[i]->disk)) {
+    if (DISK_BAD(cp->stripes[i]->disk) || !in_tier(cp->stripes[i], tier)) {
       bad_vols++;
       continue;
     }
@@ -545,10 +580,7 @@ build_vol_hash_table(CacheHostRecord *cp)
 
   if (!num_vols || !total) {
     // all the disks are corrupt,
-    if (cp->vol_hash_table) {
-      new_Freer(cp->vol_hash_table, CACHE_MEM_FREE_TIMEOUT);
-    }
-    cp->vol_hash_table = nullptr;
+    install_hash_table(table, nullptr);
     ats_free(mapping);
     ats_free(p);
     return;
@@ -558,7 +590,6 @@ build_vol_hash_table(CacheHostRecord *cp)
   unsigned int   *gotvol = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
   unsigned int   *rnd    = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
   unsigned short *ttable = static_cast<unsigned short *>(ats_malloc(sizeof(unsigned short) * STRIPE_HASH_TABLE_SIZE));
-  unsigned short *old_table;
   unsigned int   *rtable_entries = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
   unsigned int    rtable_size    = 0;
 
@@ -613,9 +644,7 @@ build_vol_hash_table(CacheHostRecord *cp)
     Dbg(dbg_ctl_cache_init, "build_vol_hash_table index %d mapped to %d requested %d got %d", i, mapping[i], forvol[i], gotvol[i]);
   }
   // install new table
-  if (nullptr != (old_table = ink_atomic_swap(&(cp->vol_hash_table), ttable))) {
-    new_Freer(old_table, CACHE_MEM_FREE_TIMEOUT);
-  }
+  install_hash_table(table, ttable);
   ats_free(mapping);
   ats_free(p);
   ats_free(forvol);
@@ -625,6 +654,33 @@ build_vol_hash_table(CacheHostRecord *cp)
   ats_free(rtable);
 }
 
+} // namespace
+
+/* Objects are written to the slow tier, the stripes not marked tier=fast in
+   storage.config, and copies of the ones read are kept in the fast tier. Without
+   stripes in both tiers every stripe holds objects as before.
+ */
+void
+build_vol_hash_table(CacheHostRecord *cp)
+{
+  int fast = 0;
+  int slow = 0;
+
+  for (int i = 0; i < cp->num_vols; i++) {
+    if (!DISK_BAD(cp->stripes[i]->disk)) {
+      ++(cp->stripes[i]->disk->fast_tier ? fast : slow);
+    }
+  }
+
+  if (fast && slow) {
+    build_stripe_hash_table(cp, &cp->vol_hash_table, StripeTier::SLOW);
+    build_stripe_hash_table(cp, &cp->fast_hash_table, StripeTier::FAST);
+  } else {
+    build_stripe_hash_table(cp, &cp->vol_hash_table, StripeTier::ANY);
+    install_hash_table(&cp->fast_hash_table, nullptr);
+  }
+}
+
 // comparison operator for random table in build_vol_hash_table
 // sorts based on the randomly assigned rval
 int
@@ -698,6 +754,109 @@ CacheProcessor::has_online_storage() const
   return false;
 }
 
+namespace
+{
+// Keys purged under one hold of a stripe lock, so that a large purge does
+// not stall the writers of the stripe.
+constexpr size_t PURGE_BATCH = 1024;
+
+void
+purge_items(std::vector<CachePurgeIndex::Item> const &items, CachePurgeResult &result)
+{
+  std::vector<std::pair<StripeSM *, CryptoHash const *>> keys;
+
+  result.indexed += items.size();
+  if (!CacheProcessor::IsCacheReady(CACHE_FRAG_TYPE_HTTP)) {
+    return;
+  }
+  keys.reserve(items.size());
+  for (auto const &item : items) {
+    std::string_view host = CachePurgeIndex::url_host(item.url);
+    keys.emplace_back(theCache->key_to_stripe(&item.key, host.data(), static_cast<int>(host.size())), &item.key);
+    if (StripeSM *fast = theCache->key_to_fast_stripe(&item.key, host.data(), static_cast<int>(host.size()))) {
+      cache_tier_remove(fast, &item.key);
+    }
+  }
+  std::sort(keys.begin(), keys.end(), [](auto const &a, auto const &b) { return a.first < b.first; });
+
+  for (size_t i = 0; i < keys.size();) {
+    StripeSM *stripe = keys[i].first;
+    size_t    end    = std::min(i + PURGE_BATCH, keys.size());
+    int64_t   purged = 0;
+
+    SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+    for (; i < end && keys[i].first == stripe; ++i) {
+      CryptoHash const *key = keys[i].second;
+      Dir               dir;
+      Dir              *last_collision = nullptr;
+      bool              found          = false;
+
+      // Only the head of an object is deleted, the rest of it is then unreachable.
+      while (dir_probe(key, stripe, &dir, &last_collision)) {
+        if (dir_head(&dir)) {
+          dir_delete(key, stripe, &dir);
+          last_collision = nullptr;
+          found          = true;
+        }
+      }
+      purged += found;
+    }
+    result.purged += purged;
+    Metrics::Counter::increment(cache_rsb.purge_objects, purged);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.purge_objects, purged);
+  }
+}
+
+bool
+purge(CachePurgeResult &result, int64_t (CachePurgeIndex::*remove)(std::string_view, std::vector<CachePurgeIndex::Item> &),
+      std::string_view what)
+{
+  std::vector<CachePurgeIndex::Item> items;
+  ink_hrtime                         start = ink_get_hrtime();
+
+  if (!cache_purge_index) {
+    return false;
+  }
+  (cache_purge_index->*remove)(what, items);
+  purge_items(items, result);
+  result.time = ink_get_hrtime() - start;
+
+  Metrics::Counter::increment(cache_rsb.purge_requests);
+  Metrics::Counter::increment(cache_rsb.purge_time, ink_hrtime_to_usec(result.time));
+  Dbg(dbg_ctl_cache_purge, "purge of '%.*s': %" PRId64 " indexed, %" PRId64 " purged in %" PRId64 " us",
+      static_cast<int>(what.size()), what.data(), result.indexed, result.purged, ink_hrtime_to_usec(result.time));
+  return true;
+}
+
+/// Writes the purge index to its file at each directory sync interval.
+struct PurgeIndexSync : public Continuation {
+  PurgeIndexSync() : Continuation(new_ProxyMutex()) { SET_HANDLER(&PurgeIndexSync::mainEvent); }
+
+  int
+  mainEvent(int /* event ATS_UNUSED */, Event *e)
+  {
+    if (!cache_purge_index->save(cache_purge_index_path)) {
+      Warning("unable to write the cache purge index to %s", cache_purge_index_path.c_str());
+    }
+    e->ethread->schedule_in(this, HRTIME_SECONDS(std::max(cache_config_dir_sync_frequency, 1)));
+    return EVENT_DONE;
+  }
+};
+
+} // namespace
+
+bool
+CacheProcessor::purge_surrogate_key(std::string_view tag, CachePurgeResult &result)
+{
+  return purge(result, &CachePurgeIndex::remove_tag, tag);
+}
+
+bool
+CacheProcessor::purge_url_prefix(std::string_view prefix, CachePurgeResult &result)
+{
+  return purge(result, &CachePurgeIndex::remove_prefix, CachePurgeIndex::url_key(prefix));
+}
+
 int
 CacheProcessor::IsCacheEnabled()
 {
@@ -1163,6 +1322,43 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string prefix)
   rsb->span_failing          = Metrics::Gauge::createPtr(prefix + ".span.failing");
   rsb->span_offline          = Metrics::Gauge::createPtr(prefix + ".span.offline");
   rsb->span_online           = Metrics::Gauge::createPtr(prefix + ".span.online");
+
+  // Bytes written by the last directory sync of each stripe
+  rsb->directory_sync_interval_bytes = Metrics::Gauge::createPtr(prefix + ".sync.interval_bytes");
+
+  // Startup timeline, and the write ahead marker bounding the recovery
+  rsb->init_time          = Metrics::Gauge::createPtr(prefix + ".init.time");
+  rsb->init_dir_read_time = Metrics::Counter::createPtr(prefix + ".init.dir_read.time");
+  rsb->init_recover_time  = Metrics::Counter::createPtr(prefix + ".init.recover.time");
+  rsb->init_recover_bytes = Metrics::Counter::createPtr(prefix + ".init.recover.bytes");
+  rsb->write_ahead_writes = Metrics::Counter::createPtr(prefix + ".write_ahead.writes");
+  rsb->write_ahead_stalls = Metrics::Counter::createPtr(prefix + ".write_ahead.stalls");
+
+  // Purges through the purge index
+  rsb->purge_requests      = Metrics::Counter::createPtr(prefix + ".purge.requests");
+  rsb->purge_objects       = Metrics::Counter::createPtr(prefix + ".purge.objects");
+  rsb->purge_time          = Metrics::Counter::createPtr(prefix + ".purge.time");
+  rsb->purge_index_entries = Metrics::Gauge::createPtr(prefix + ".purge_index.entries");
+
+  // Storage tiers
+  rsb->tier_fast_hits   = Metrics::Counter::createPtr(prefix + ".tier.fast.hits");
+  rsb->tier_slow_hits   = Metrics::Counter::createPtr(prefix + ".tier.slow.hits");
+  rsb->tier_promotions  = Metrics::Counter::createPtr(prefix + ".tier.promotions");
+  rsb->tier_demotions   = Metrics::Counter::createPtr(prefix + ".tier.demotions");
+  rsb->tier_copy_aborts = Metrics::Counter::createPtr(prefix + ".tier.copy_aborts");
+
+  // Fragments of objects being written shared with their readers
+  rsb->read_busy_fanout_writers = Metrics::Counter::createPtr(prefix + ".read_busy.fanout.writers");
+  rsb->read_busy_fanout_readers = Metrics::Counter::createPtr(prefix + ".read_busy.fanout.readers");
+  rsb->read_busy_fanout_bytes   = Metrics::Counter::createPtr(prefix + ".read_busy.fanout.bytes");
+
+  // Objects written in fragments larger than the target fragment size
+  rsb->large_fragment_objects = Metrics::Counter::createPtr(prefix + ".write.large_fragment_objects");
+
+  // Writes admitted by how often their objects are requested
+  rsb->admission_admitted        = Metrics::Counter::createPtr(prefix + ".admission.admitted");
+  rsb->admission_rejected        = Metrics::Counter::createPtr(prefix + ".admission.rejected");
+  rsb->admission_rejected_misses = Metrics::Counter::createPtr(prefix + ".admission.rejected_misses");
 }
 
 void
@@ -1521,6 +1717,25 @@ CacheProcessor::cacheInitialized()
         used_direntries += vol_used_direntries;
       }
 
+      // Write admission filters, sized by the directory entries of their volume
+      for (CacheVol *cp = cp_list.head; cp; cp = cp->link.next) {
+        bool     admission = cache_config_admission_enabled;
+        uint64_t entries   = 0;
+
+        for (ConfigVol *config_vol = config_volumes.cp_queue.head; config_vol; config_vol = config_vol->link.next) {
+          if (config_vol->number == cp->vol_number && config_vol->admission >= 0) {
+            admission = config_vol->admission;
+          }
+        }
+        if (admission && !cp->admission && cp->num_vols > 0) {
+          for (int i = 0; i < cp->num_vols; i++) {
+            entries += cp->stripes[i]->buckets * cp->stripes[i]->segments * DIR_DEPTH;
+          }
+          cp->admission = new CacheAdmission(entries);
+          Dbg(dbg_ctl_cache_init, "volume %d admits writes, %" PRIu64 " entries", cp->vol_number, entries);
+        }
+      }
+
       switch (cache_config_ram_cache_compress) {
       default:
         Fatal("unknown RAM cache compression type: %d", cache_config_ram_cache_compress);
@@ -1543,6 +1758,9 @@ CacheProcessor::cacheInitialized()
 
       if (!check) {
         dir_sync_init();
+        if (cache_purge_index && !cache_purge_index_path.empty()) {
+          eventProcessor.schedule_in(new PurgeIndexSync, HRTIME_SECONDS(cache_config_dir_sync_frequency), ET_TASK);
+        }
       }
       cache_init_ok = 1;
     } else {
@@ -0,0 +1,292 @@
+/** @file
+
+  Index of cached objects by surrogate key and URL, for purges.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "CachePurgeIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+CachePurgeIndex *cache_purge_index = nullptr;
+
+namespace
+{
+
+bool
+is_tag_separator(char c)
+{
+  return c == ' ' || c == ',' || c == '\t';
+}
+
+int
+hex_value(char c)
+{
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = std::tolower(static_cast<unsigned char>(c));
+  return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+bool
+parse_key(std::string_view hex, CryptoHash &key)
+{
+  if (hex.size() != 2 * CRYPTO_HASH_SIZE) {
+    return false;
+  }
+  for (int i = 0; i < CRYPTO_HASH_SIZE; ++i) {
+    int hi = hex_value(hex[2 * i]);
+    int lo = hex_value(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0) {
+      return false;
+    }
+    key.u8[i] = hi << 4 | lo;
+  }
+  return true;
+}
+
+} // namespace
+
+CachePurgeIndex::CachePurgeIndex(int64_t max_entries)
+  : _max_per_shard(std::max<int64_t>(1, (max_entries + SHARDS - 1) / SHARDS))
+{
+}
+
+void
+CachePurgeIndex::insert(CryptoHash const &key, std::string_view url, std::string_view tags)
+{
+  Shard                      &shard = this->_shard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto [spot, added] = shard.entries.try_emplace(key);
+  Entry &entry       = spot->second;
+  if (added) {
+    entry.url = shard.urls.emplace(url, key);
+    shard.order.push_back(key);
+  } else if (entry.url->first != url) {
+    shard.urls.erase(entry.url);
+    entry.url = shard.urls.emplace(url, key);
+  }
+
+  while (!tags.empty()) {
+    size_t n = 0;
+    while (n < tags.size() && !is_tag_separator(tags[n])) {
+      ++n;
+    }
+    std::string_view tag = tags.substr(0, n);
+    tags.remove_prefix(std::min(n + 1, tags.size()));
+    if (tag.empty() || std::find(entry.tags.begin(), entry.tags.end(), tag) != entry.tags.end()) {
+      continue;
+    }
+    entry.tags.emplace_back(tag);
+    shard.tags[entry.tags.back()].insert(key);
+  }
+
+  if (added) {
+    this->_evict(shard);
+  }
+}
+
+int64_t
+CachePurgeIndex::remove_tag(std::string_view tag, std::vector<Item> &items)
+{
+  int64_t     n = 0;
+  std::string name{tag};
+
+  for (auto &shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto spot = shard.tags.find(name);
+    if (spot == shard.tags.end()) {
+      continue;
+    }
+    // Erasing the keys removes them from this set.
+    KeySet keys{std::move(spot->second)};
+    shard.tags.erase(spot);
+    items.reserve(items.size() + keys.size());
+    for (auto const &key : keys) {
+      this->_erase(shard, key, &items);
+      ++n;
+    }
+  }
+  return n;
+}
+
+int64_t
+CachePurgeIndex::remove_prefix(std::string_view prefix, std::vector<Item> &items)
+{
+  int64_t                 n = 0;
+  std::vector<CryptoHash> keys;
+
+  for (auto &shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    keys.clear();
+    for (auto spot = shard.urls.lower_bound(prefix); spot != shard.urls.end() && spot->first.starts_with(prefix); ++spot) {
+      keys.push_back(spot->second);
+    }
+    for (auto const &key : keys) {
+      this->_erase(shard, key, &items);
+      ++n;
+    }
+  }
+  return n;
+}
+
+int64_t
+CachePurgeIndex::size() const
+{
+  int64_t n = 0;
+
+  for (auto const &shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    n += shard.entries.size();
+  }
+  return n;
+}
+
+/* One object per line, its cache key in hex, its URL, and its surrogate keys
+   separated by spaces. URLs do not have unescaped white space.
+ */
+bool
+CachePurgeIndex::save(std::string const &path) const
+{
+  std::string   tmp{path + ".tmp"};
+  std::ofstream out{tmp, std::ios::out | std::ios::trunc};
+  char          hex[CRYPTO_HASH_SIZE * 2 + 1];
+
+  for (auto const &shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    for (auto const &[key, entry] : shard.entries) {
+      out << key.toHexStr(hex) << '\t' << entry.url->first << '\t';
+      for (auto const &tag : entry.tags) {
+        out << tag << ' ';
+      }
+      out << '\n';
+    }
+  }
+  out.close();
+  if (!out) {
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+int64_t
+CachePurgeIndex::load(std::string const &path)
+{
+  std::ifstream in{path};
+  int64_t       n = 0;
+
+  if (!in) {
+    return -1;
+  }
+  for (std::string line; std::getline(in, line);) {
+    std::string_view text{line};
+    size_t           url_end = text.find('\t', 2 * CRYPTO_HASH_SIZE + 1);
+    CryptoHash       key;
+
+    if (text.size() <= 2 * CRYPTO_HASH_SIZE || text[2 * CRYPTO_HASH_SIZE] != '\t' || url_end == std::string_view::npos ||
+        !parse_key(text.substr(0, 2 * CRYPTO_HASH_SIZE), key)) {
+      continue;
+    }
+    this->insert(key, text.substr(2 * CRYPTO_HASH_SIZE + 1, url_end - 2 * CRYPTO_HASH_SIZE - 1), text.substr(url_end + 1));
+    ++n;
+  }
+  return n;
+}
+
+std::string
+CachePurgeIndex::url_key(std::string_view url)
+{
+  if (auto scheme = url.find("://"); scheme != std::string_view::npos && url.find('/') > scheme) {
+    url.remove_prefix(scheme + 3);
+  }
+
+  size_t      host_end = std::min(url.find('/'), url.size());
+  std::string key;
+  key.reserve(url.size());
+  for (char c : url.substr(0, host_end)) {
+    if (c == ':') {
+      break;
+    }
+    key.push_back(std::tolower(static_cast<unsigned char>(c)));
+  }
+  key.append(url.substr(host_end));
+  return key;
+}
+
+std::string_view
+CachePurgeIndex::url_host(std::string_view url)
+{
+  return url.substr(0, url.find('/'));
+}
+
+void
+CachePurgeIndex::_erase(Shard &shard, CryptoHash const &key, std::vector<Item> *items)
+{
+  auto spot = shard.entries.find(key);
+  if (spot == shard.entries.end()) {
+    return;
+  }
+
+  Entry &entry = spot->second;
+  for (auto const &tag : entry.tags) {
+    if (auto keys = shard.tags.find(tag); keys != shard.tags.end()) {
+      keys->second.erase(key);
+      if (keys->second.empty()) {
+        shard.tags.erase(keys);
+      }
+    }
+  }
+  auto url = shard.urls.extract(entry.url);
+  if (items) {
+    items->push_back({key, std::move(url.key())});
+  }
+  shard.entries.erase(spot);
+}
+
+void
+CachePurgeIndex::_evict(Shard &shard)
+{
+  while (shard.entries.size() > _max_per_shard && !shard.order.empty()) {
+    CryptoHash key = shard.order.front();
+    shard.order.pop_front();
+    this->_erase(shard, key, nullptr);
+  }
+
+  // Purged keys are left in the order, drop them once they are most of it.
+  if (shard.order.size() > 2 * shard.entries.size() + 1024) {
+    std::deque<CryptoHash> order;
+    for (auto const &key : shard.order) {
+      if (shard.entries.count(key)) {
+        order.push_back(key);
+      }
+    }
+    shard.order.swap(order);
+  }
+}
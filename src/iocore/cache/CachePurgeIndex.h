@@ -0,0 +1,163 @@
+/** @file
+
+  Index of cached objects by surrogate key and URL, for purges.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/CryptoHash.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Secondary index from surrogate keys and URLs to the cache keys of the
+ * objects written with them.
+ *
+ * Objects are added when their write closes and are only removed by a purge
+ * or when the index is full, so the index may have objects the cache has
+ * since overwritten. Purging those is a directory lookup which finds nothing.
+ *
+ * URLs are kept as host/path?query with the host in lower case and without
+ * the scheme or port, see url_key(). A URL prefix purge is a range of the
+ * sorted URLs.
+ *
+ * The index is split in shards by cache key, each with its own lock, so
+ * writes closing on different threads rarely contend.
+ */
+class CachePurgeIndex
+{
+public:
+  /// An object removed from the index by a purge.
+  struct Item {
+    CryptoHash  key;
+    std::string url;
+  };
+
+  /**
+   * @param max_entries The most objects to keep, the first indexed are
+   *     dropped beyond this.
+   */
+  explicit CachePurgeIndex(int64_t max_entries);
+
+  /**
+   * Index the object with cache key @a key.
+   *
+   * If the key is indexed already, @a url replaces its URL and @a tags are
+   * added to its surrogate keys, so that each alternate can add its own.
+   *
+   * @param url The URL as returned by url_key().
+   * @param tags The surrogate keys, separated by spaces or commas.
+   */
+  void insert(CryptoHash const &key, std::string_view url, std::string_view tags);
+
+  /**
+   * Remove the objects with the surrogate key @a tag.
+   *
+   * @return The number of objects appended to @a items.
+   */
+  int64_t remove_tag(std::string_view tag, std::vector<Item> &items);
+
+  /**
+   * Remove the objects with URLs starting with @a prefix.
+   *
+   * @param prefix A URL prefix as returned by url_key().
+   * @return The number of objects appended to @a items.
+   */
+  int64_t remove_prefix(std::string_view prefix, std::vector<Item> &items);
+
+  /// The number of objects indexed.
+  int64_t size() const;
+
+  /**
+   * Write the index to @a path, replacing it once complete.
+   *
+   * @return Returns true on success.
+   */
+  bool save(std::string const &path) const;
+
+  /**
+   * Add the objects saved in @a path.
+   *
+   * @return The number of objects read, -1 if the file could not be read.
+   */
+  int64_t load(std::string const &path);
+
+  /**
+   * Make the form of a URL the index keeps.
+   *
+   * Drops a scheme and a port, and converts the host to lower case. This is
+   * used for both indexed URLs and purge prefixes, so that they compare.
+   */
+  static std::string url_key(std::string_view url);
+
+  /// The host of a URL returned by url_key().
+  static std::string_view url_host(std::string_view url);
+
+private:
+  struct KeyHash {
+    size_t
+    operator()(CryptoHash const &key) const
+    {
+      return key.fold();
+    }
+  };
+
+  using KeySet = std::unordered_set<CryptoHash, KeyHash>;
+  using UrlMap = std::multimap<std::string, CryptoHash, std::less<>>;
+
+  struct Entry {
+    UrlMap::iterator         url;
+    std::vector<std::string> tags;
+  };
+
+  struct Shard {
+    mutable std::mutex                             mutex;
+    std::unordered_map<CryptoHash, Entry, KeyHash> entries;
+    std::unordered_map<std::string, KeySet>        tags;
+    UrlMap                                         urls;
+    std::deque<CryptoHash>                         order; ///< Insertion order, may have removed keys.
+  };
+
+  static constexpr int SHARDS = 64;
+
+  Shard &
+  _shard(CryptoHash const &key)
+  {
+    return _shards[key.u32[0] % SHARDS];
+  }
+
+  void _erase(Shard &shard, CryptoHash const &key, std::vector<Item> *items);
+  void _evict(Shard &shard);
+
+  size_t _max_per_shard;
+  Shard  _shards[SHARDS];
+};
+
+/// The purge index, nullptr unless proxy.config.cache.purge_index.enabled is set.
+extern CachePurgeIndex *cache_purge_index;
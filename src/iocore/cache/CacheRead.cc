@@ -23,6 +23,7 @@
 
 #include "P_Cache.h"
 #include "P_CacheDoc.h"
+#include "CacheTier.h"
 
 #ifdef DEBUG
 #include "iocore/eventsystem/EThread.h"
@@ -336,6 +337,9 @@ CacheVC::openReadFromWriter(int event, Event *e)
     last_collision = nullptr;
     DDbg(dbg_ctl_cache_read_agg, "%p: key: %X closed: %d, fragment: %d, len: %" PRIu64 " starting first fragment", this,
          first_key.slice32(1), write_vc->closed, write_vc->fragment, doc_len);
+    if (!write_vc->closed) {
+      cache_fanout_attach(write_vc, this);
+    }
     MUTEX_RELEASE(writer_lock);
     // either a header + body update or a new document
     SET_HANDLER(&CacheVC::openReadStartEarliest);
@@ -693,6 +697,13 @@ Lread: {
   // EVENT_IMMEDIATE events. So, we have to cancel that trigger and set
   // a new EVENT_INTERVAL event.
   cancel_trigger();
+  // The writer's copy of the fragment, without the stripe lock or a read.
+  if (fanout && cache_fanout_read(this)) {
+    fragment++;
+    doc_pos = reinterpret_cast<Doc *>(buf->data())->prefix_len();
+    next_CacheKey(&key, &key);
+    return openReadMain(EVENT_NONE, nullptr);
+  }
   CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
     SET_HANDLER(&CacheVC::openReadMain);
@@ -887,6 +898,7 @@ Lsuccess:
     Metrics::Counter::increment(cache_rsb.read_busy_success);
     Metrics::Counter::increment(stripe->cache_vol->vol_rsb.read_busy_success);
   }
+  cache_tier_hit(stripe);
   SET_HANDLER(&CacheVC::openReadMain);
   return callcont(CACHE_EVENT_OPEN_READ);
 }
@@ -1156,6 +1168,7 @@ Ldone:
 Lcallreturn:
   return handleEvent(AIO_EVENT_DONE, nullptr); // hopefully a tail call
 Lsuccess:
+  cache_tier_hit(stripe);
   SET_HANDLER(&CacheVC::openReadMain);
   return callcont(CACHE_EVENT_OPEN_READ);
 Lookup:
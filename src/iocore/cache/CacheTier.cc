@@ -0,0 +1,687 @@
+/** @file
+
+  Copies of cached objects between the fast and the slow storage tier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "CacheTier.h"
+
+// aio
+#include "../aio/P_AIO.h"
+
+// inkcache
+#include "P_CacheDisk.h"
+#include "P_CacheDoc.h"
+#include "P_CacheHttp.h"
+#include "P_CacheInternal.h"
+#include "StripeSM.h"
+#include "CacheEvacuateDocVC.h"
+#include "PreservationTable.h"
+
+// tscore
+#include "tscore/Diags.h"
+#include "tscore/ink_assert.h"
+
+// ts
+#include "tsutil/DbgCtl.h"
+#include "tsutil/Metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+extern CacheDisk **gdisks;
+extern int         gndisks;
+
+namespace
+{
+DbgCtl dbg_ctl_cache_tier{"cache_tier"};
+
+// How often a demotion queue checks for a free copy.
+constexpr int DEMOTE_RETRY_MSECONDS = 10;
+
+struct KeyHash {
+  size_t
+  operator()(CryptoHash const &key) const
+  {
+    return key.fold();
+  }
+};
+
+// Copies in progress, and the objects being copied.
+std::atomic<int>                        tier_copies{0};
+std::mutex                              tier_keys_mutex;
+std::unordered_set<CryptoHash, KeyHash> tier_keys;
+
+using CacheCounter = Metrics::Counter::AtomicType *CacheStatsBlock::*;
+
+void
+count(StripeSM const *stripe, CacheCounter counter)
+{
+  Metrics::Counter::increment(cache_rsb.*counter);
+  Metrics::Counter::increment(stripe->cache_vol->vol_rsb.*counter);
+}
+
+/// Take one of the proxy.config.cache.tier.max_copies copies, returns false if there are none left.
+bool
+reserve_copy()
+{
+  if (tier_copies.fetch_add(1) >= cache_config_tier_max_copies) {
+    --tier_copies;
+    return false;
+  }
+  return true;
+}
+
+bool
+claim_key(CryptoHash const &key)
+{
+  std::lock_guard<std::mutex> lock(tier_keys_mutex);
+  return tier_keys.insert(key).second;
+}
+
+void
+release_key(CryptoHash const &key)
+{
+  std::lock_guard<std::mutex> lock(tier_keys_mutex);
+  tier_keys.erase(key);
+}
+
+/// Whether @a stripe has a head for @a key, the one at @a at if not nullptr.
+bool
+find_head(StripeSM *stripe, CacheKey const *key, Dir const *at)
+{
+  Dir  dir;
+  Dir *last_collision = nullptr;
+
+  while (dir_probe(key, stripe, &dir, &last_collision)) {
+    if (dir_head(&dir) && (!at || (dir_offset(&dir) == dir_offset(at) && dir_phase(&dir) == dir_phase(at)))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+delete_heads(StripeSM *stripe, CacheKey const *key)
+{
+  Dir  dir;
+  Dir *last_collision = nullptr;
+
+  while (dir_probe(key, stripe, &dir, &last_collision)) {
+    if (dir_head(&dir)) {
+      dir_delete(key, stripe, &dir);
+      last_collision = nullptr;
+    }
+  }
+}
+
+/// Whether there are online stripes in both tiers.
+bool
+tiered()
+{
+  bool fast = false;
+  bool slow = false;
+
+  for (int i = 0; i < gndisks; ++i) {
+    if (!DISK_BAD(gdisks[i]) && gdisks[i]->online) {
+      (gdisks[i]->fast_tier ? fast : slow) = true;
+    }
+  }
+  return fast && slow;
+}
+
+/* A copy of an HTTP object from one tier to the other.
+
+   It reads the head of the object and the fragments of each of its
+   alternates from the source stripe, and queues each to the destination
+   stripe as it is read. The head goes last, so that the object is only found
+   in the destination once all of it has been written there, see head_copied().
+
+   The copy has its own lock and takes the stripe locks as it needs them, it
+   gives up rather than wait for the object when anything changes.
+ */
+class TierCopy : public Continuation
+{
+public:
+  /// Promotion of the object with @a key from the slow @a src to the fast @a dst.
+  TierCopy(StripeSM *src, StripeSM *dst, CacheKey const *key) : Continuation(new_ProxyMutex()), _src(src), _dst(dst), _promote(true)
+  {
+    _first_key = *key;
+    _claimed   = true;
+    SET_HANDLER(&TierCopy::probeHead);
+  }
+
+  /// Demotion of the object with its head at @a head in the fast @a src.
+  TierCopy(StripeSM *src, Dir const *head) : Continuation(new_ProxyMutex()), _src(src), _promote(false)
+  {
+    _dir = *head;
+    SET_HANDLER(&TierCopy::readHead);
+  }
+
+  ~TierCopy() override
+  {
+    if (_claimed) {
+      release_key(_first_key);
+    }
+    --tier_copies;
+  }
+
+  void head_copied(CacheEvacuateDocVC *vc);
+
+private:
+  int probeHead(int event, Event *e);
+  int readHead(int event, Event *e);
+  int readHeadDone(int event, Event *e);
+  int probeFragment(int event, Event *e);
+  int readFragmentDone(int event, Event *e);
+  int queueFragment(int event, Event *e);
+  int queueHead(int event, Event *e);
+
+  int  retry();
+  int  abort(const char *why);
+  int  read();
+  bool load_head(Doc *doc);
+  bool next_alternate();
+  void queue_write(Dir const *dir, bool head);
+
+  StripeSM *_src;
+  StripeSM *_dst = nullptr; ///< Set once the head is read for a demotion.
+  bool      _promote;
+  bool      _claimed = false;
+  CacheKey  _first_key;
+  Dir       _head_dir;
+  Dir       _dir;
+  Dir      *_last_collision = nullptr;
+  CacheKey  _key;      ///< Of the fragment being read.
+  int64_t   _left = 0; ///< Bytes of the alternate still to read.
+
+  std::vector<std::pair<CacheKey, int64_t>> _alternates; ///< Earliest key and size of those not in the head.
+  size_t                                    _next_alternate = 0;
+
+  Ptr<IOBufferData>   _buf;
+  Ptr<IOBufferData>   _head_buf;
+  AIOCallbackInternal _io;
+};
+
+int
+TierCopy::retry()
+{
+  eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay), ET_CALL);
+  return EVENT_CONT;
+}
+
+int
+TierCopy::abort(const char *why)
+{
+  Dbg(dbg_ctl_cache_tier, "%s of %X aborted: %s", _promote ? "promotion" : "demotion", _first_key.slice32(0), why);
+  count(_src, &CacheStatsBlock::tier_copy_aborts);
+  delete this;
+  return EVENT_DONE;
+}
+
+int
+TierCopy::read()
+{
+  _io.aiocb.aio_fildes = _src->fd;
+  _io.aiocb.aio_nbytes = dir_approx_size(&_dir);
+  _io.aiocb.aio_offset = _src->vol_offset(&_dir);
+  if (static_cast<off_t>(_io.aiocb.aio_offset + _io.aiocb.aio_nbytes) > static_cast<off_t>(_src->skip + _src->len)) {
+    _io.aiocb.aio_nbytes = _src->skip + _src->len - _io.aiocb.aio_offset;
+  }
+  _buf = new_IOBufferData(iobuffer_size_to_index(_io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+
+  // A Doc written recently may not be on disk yet.
+  if (_src->copy_from_aggregate_write_buffer(_buf->data(), _dir, _io.aiocb.aio_nbytes)) {
+    _io.aio_result = _io.aiocb.aio_nbytes;
+    return handleEvent(AIO_EVENT_DONE, nullptr);
+  }
+  _io.aiocb.aio_buf = _buf->data();
+  _io.action        = this;
+  _io.thread        = AIO_CALLBACK_THREAD_ANY;
+  ink_assert(ink_aio_read(&_io) >= 0);
+  return EVENT_CONT;
+}
+
+int
+TierCopy::probeHead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _src->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  if (_src->open_read(&_first_key)) {
+    return abort("being written");
+  }
+  while (dir_probe(&_first_key, _src, &_dir, &_last_collision)) {
+    if (dir_head(&_dir) && _src->dir_valid(&_dir)) {
+      SET_HANDLER(&TierCopy::readHeadDone);
+      return this->read();
+    }
+  }
+  return abort("no head");
+}
+
+int
+TierCopy::readHead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _src->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  if (!_src->dir_valid(&_dir)) {
+    return abort("head overwritten");
+  }
+  SET_HANDLER(&TierCopy::readHeadDone);
+  return this->read();
+}
+
+int
+TierCopy::readHeadDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _src->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  if (!_io.ok() || !_src->dir_valid(&_dir)) {
+    return abort("head overwritten");
+  }
+
+  Doc *doc = reinterpret_cast<Doc *>(_buf->data());
+  if (doc->magic != DOC_MAGIC || doc->len > _io.aiocb.aio_nbytes || !dir_compare_tag(&_dir, &doc->first_key) ||
+      (_promote && !(doc->first_key == _first_key))) {
+    if (_promote) {
+      // a collision, try the next entry
+      SET_HANDLER(&TierCopy::probeHead);
+      return probeHead(EVENT_IMMEDIATE, nullptr);
+    }
+    return abort("not a head");
+  }
+  if (doc->doc_type != CACHE_FRAG_TYPE_HTTP || !doc->hlen || ts::VersionNumber(doc->v_major, doc->v_minor) < CACHE_DB_VERSION) {
+    return abort("not a current HTTP object");
+  }
+  _first_key = doc->first_key;
+  _head_dir  = _dir;
+  _head_buf  = _buf;
+  if (!_promote && !(_claimed = claim_key(_first_key))) {
+    return abort("being copied");
+  }
+  if (!this->load_head(doc)) {
+    return abort("not copied");
+  }
+
+  if (!this->next_alternate()) {
+    SET_HANDLER(&TierCopy::queueHead);
+    return queueHead(EVENT_IMMEDIATE, nullptr);
+  }
+  SET_HANDLER(&TierCopy::probeFragment);
+  return probeFragment(EVENT_IMMEDIATE, nullptr);
+}
+
+/* Find the fragments of the alternates, and for a demotion the stripe in the
+   slow tier the object is written to.
+ */
+bool
+TierCopy::load_head(Doc *doc)
+{
+  // Unmarshaling is in place, the head is copied as it was read.
+  Ptr<IOBufferData>   hdr;
+  CacheHTTPInfoVector vector;
+  int64_t             size = 0;
+
+  hdr = new_IOBufferData(iobuffer_size_to_index(doc->hlen, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  memcpy(hdr->data(), doc->hdr(), doc->hlen);
+  if (vector.unmarshal(hdr->data(), doc->hlen, hdr.get()) != static_cast<int>(doc->hlen) || !vector.count()) {
+    return false;
+  }
+  for (int i = 0; i < vector.count(); ++i) {
+    CacheHTTPInfo *alt = vector.get(i);
+    CacheKey       earliest;
+
+    alt->object_key_get(&earliest);
+    size += alt->object_size_get();
+    // a single fragment alternate is in the head
+    if (!(earliest == doc->key)) {
+      _alternates.emplace_back(earliest, alt->object_size_get());
+    }
+  }
+  if (size > cache_config_tier_max_copy_size) {
+    Dbg(dbg_ctl_cache_tier, "%X is too large to copy: %" PRId64 " bytes", _first_key.slice32(0), size);
+    return false;
+  }
+
+  if (!_promote) {
+    HTTPHdr    *request  = vector.get(0)->request_get();
+    int         host_len = 0;
+    const char *host     = request->valid() ? request->host_get(&host_len) : nullptr;
+
+    _dst = theCache->key_to_stripe(&_first_key, host, host_len);
+    if (_dst->disk->fast_tier || theCache->key_to_fast_stripe(&_first_key, host, host_len) != _src) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+TierCopy::next_alternate()
+{
+  if (_next_alternate == _alternates.size()) {
+    return false;
+  }
+  _key            = _alternates[_next_alternate].first;
+  _left           = _alternates[_next_alternate].second;
+  _last_collision = nullptr;
+  ++_next_alternate;
+  return true;
+}
+
+int
+TierCopy::probeFragment(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _src->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  while (dir_probe(&_key, _src, &_dir, &_last_collision)) {
+    if (_src->dir_valid(&_dir)) {
+      SET_HANDLER(&TierCopy::readFragmentDone);
+      return this->read();
+    }
+  }
+  return abort("fragment missing");
+}
+
+int
+TierCopy::readFragmentDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _src->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  if (!_io.ok() || !_src->dir_valid(&_dir)) {
+    return abort("fragment overwritten");
+  }
+
+  Doc *doc = reinterpret_cast<Doc *>(_buf->data());
+  if (doc->magic != DOC_MAGIC || !(doc->key == _key) || doc->len > _io.aiocb.aio_nbytes) {
+    // a collision, try the next entry
+    SET_HANDLER(&TierCopy::probeFragment);
+    return probeFragment(EVENT_IMMEDIATE, nullptr);
+  }
+  SET_HANDLER(&TierCopy::queueFragment);
+  return queueFragment(EVENT_IMMEDIATE, nullptr);
+}
+
+int
+TierCopy::queueFragment(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _dst->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+
+  _left -= reinterpret_cast<Doc *>(_buf->data())->data_len();
+  this->queue_write(&_dir, false);
+
+  if (_left > 0) {
+    next_CacheKey(&_key, &_key);
+    _last_collision = nullptr;
+  } else if (!this->next_alternate()) {
+    SET_HANDLER(&TierCopy::queueHead);
+    return queueHead(EVENT_IMMEDIATE, nullptr);
+  }
+  SET_HANDLER(&TierCopy::probeFragment);
+  return probeFragment(EVENT_IMMEDIATE, nullptr);
+}
+
+int
+TierCopy::queueHead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  CACHE_TRY_LOCK(lock, _dst->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    return retry();
+  }
+  if (!_promote && find_head(_dst, &_first_key, nullptr)) {
+    return abort("in the slow tier");
+  }
+  // The copy now belongs to the writer of the head, which calls head_copied().
+  _buf = _head_buf;
+  this->queue_write(&_head_dir, true);
+  return EVENT_DONE;
+}
+
+/* Queue the Doc in _buf to the destination stripe as an evacuation, which
+   copies it verbatim and calls CacheEvacuateDocVC::tierCopyDone.
+ */
+void
+TierCopy::queue_write(Dir const *dir, bool head)
+{
+  Doc     *doc         = reinterpret_cast<Doc *>(_buf->data());
+  uint32_t approx_size = _dst->round_to_approx_size(doc->len);
+
+  // The destination may round to a larger sector size.
+  if (approx_size > static_cast<uint32_t>(_buf->block_size())) {
+    Ptr<IOBufferData> buf = _buf;
+    _buf                  = new_IOBufferData(iobuffer_size_to_index(approx_size, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    memcpy(_buf->data(), doc, doc->len);
+  }
+
+  CacheEvacuateDocVC *vc = new_CacheEvacuateDocVC(this);
+  vc->mutex              = _dst->mutex;
+  vc->op_type            = static_cast<int>(CacheOpType::Evacuate);
+  Metrics::Gauge::increment(cache_rsb.status[vc->op_type].active);
+  Metrics::Gauge::increment(_dst->cache_vol->vol_rsb.status[vc->op_type].active);
+  vc->buf             = _buf;
+  vc->stripe          = _dst;
+  vc->first_key       = _first_key;
+  vc->f.evacuator     = 1;
+  vc->f.use_first_key = head;
+  vc->overwrite_dir   = *dir;
+  dir_set_approx_size(&vc->overwrite_dir, approx_size);
+  vc->earliest_key.clear();
+  SET_CONTINUATION_HANDLER(vc, &CacheEvacuateDocVC::tierCopyDone);
+  _dst->evacuateWrite(vc, EVENT_IMMEDIATE, nullptr);
+}
+
+/* The head has been copied after all of the fragments, insert it unless the
+   object changed since it was read. Called with the destination stripe lock.
+ */
+void
+TierCopy::head_copied(CacheEvacuateDocVC *vc)
+{
+  bool ok = !_dst->open_read(&_first_key);
+
+  if (ok && _promote) {
+    CACHE_TRY_LOCK(lock, _src->mutex, this_ethread());
+    ok = lock.is_locked() && !_src->open_read(&_first_key) && find_head(_src, &_first_key, &_head_dir);
+    if (ok) {
+      delete_heads(_dst, &_first_key);
+    }
+  } else if (ok) {
+    ok = !find_head(_dst, &_first_key, nullptr);
+  }
+  if (!ok) {
+    abort("changed while copied");
+    return;
+  }
+
+  dir_insert(&_first_key, _dst, &vc->dir);
+  count(_dst, _promote ? &CacheStatsBlock::tier_promotions : &CacheStatsBlock::tier_demotions);
+  Dbg(dbg_ctl_cache_tier, "%s %X from %s to %s", _promote ? "promoted" : "demoted", _first_key.slice32(0), _src->hash_text.get(),
+      _dst->hash_text.get());
+  delete this;
+}
+
+/// Deletes the copy of an object in the fast tier once it has the stripe lock.
+struct TierRemove : public Continuation {
+  TierRemove(StripeSM *stripe, CacheKey const *key) : Continuation(stripe->mutex), stripe(stripe), key(*key)
+  {
+    SET_HANDLER(&TierRemove::mainEvent);
+  }
+
+  int
+  mainEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    delete_heads(stripe, &key);
+    delete this;
+    return EVENT_DONE;
+  }
+
+  StripeSM *stripe;
+  CacheKey  key;
+};
+
+/// The heads of a fast stripe to demote, in the order they will be overwritten.
+struct DemoteQueue : public Continuation {
+  explicit DemoteQueue(StripeSM *stripe) : Continuation(stripe->mutex), stripe(stripe) { SET_HANDLER(&DemoteQueue::mainEvent); }
+
+  int
+  mainEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    while (!heads.empty()) {
+      // skip those overwritten while queued
+      if (stripe->dir_valid(&heads.front())) {
+        if (!cache_config_tier_demote || !reserve_copy()) {
+          break;
+        }
+        eventProcessor.schedule_imm(new TierCopy(stripe, &heads.front()), ET_CALL);
+      }
+      heads.pop_front();
+    }
+    scheduled = !heads.empty() && cache_config_tier_demote;
+    if (scheduled) {
+      eventProcessor.schedule_in(this, HRTIME_MSECONDS(DEMOTE_RETRY_MSECONDS), ET_CALL);
+    } else {
+      heads.clear();
+    }
+    return EVENT_DONE;
+  }
+
+  StripeSM       *stripe;
+  std::deque<Dir> heads;
+  bool            scheduled = false;
+};
+
+std::mutex                                   demote_queues_mutex;
+std::unordered_map<StripeSM *, DemoteQueue *> demote_queues;
+
+DemoteQueue *
+demote_queue(StripeSM *stripe)
+{
+  std::lock_guard<std::mutex> lock(demote_queues_mutex);
+  DemoteQueue               *&queue = demote_queues[stripe];
+
+  if (!queue) {
+    queue = new DemoteQueue(stripe);
+  }
+  return queue;
+}
+
+} // namespace
+
+void
+cache_tier_hit(StripeSM *stripe)
+{
+  count(stripe, stripe->disk->fast_tier ? &CacheStatsBlock::tier_fast_hits : &CacheStatsBlock::tier_slow_hits);
+}
+
+void
+cache_tier_promote(StripeSM *stripe, StripeSM *fast, const CacheKey *key)
+{
+  if (!reserve_copy()) {
+    return;
+  }
+  if (!claim_key(*key)) {
+    --tier_copies;
+    return;
+  }
+  Dbg(dbg_ctl_cache_tier, "promoting %X from %s to %s", key->slice32(0), stripe->hash_text.get(), fast->hash_text.get());
+  eventProcessor.schedule_imm(new TierCopy(stripe, fast, key), ET_CALL);
+}
+
+void
+cache_tier_demote_scan(StripeSM *stripe)
+{
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+  if (!cache_config_tier_demote || !cache_config_tier_max_copies || !tiered() || !stripe->disk->fast_tier) {
+    return;
+  }
+
+  // The same region as scan_for_pinned_documents(), what the writes until the next scan overwrite.
+  off_t ps      = stripe->offset_to_vol_offset(stripe->header->write_pos + AGG_SIZE);
+  off_t pe      = stripe->offset_to_vol_offset(stripe->header->write_pos + 2 * EVACUATION_SIZE + (stripe->len / PIN_SCAN_EVERY));
+  off_t vol_end = stripe->offset_to_vol_offset(stripe->len + stripe->skip);
+  std::vector<std::pair<off_t, Dir>> heads;
+
+  for (int i = 0; i < stripe->direntries(); i++) {
+    Dir const *e = &stripe->dir[i];
+    if (dir_is_empty(e) || !dir_head(e)) {
+      continue;
+    }
+    off_t o = dir_offset(e);
+    if (dir_phase(e) == stripe->header->phase) {
+      if (pe < vol_end || o >= (pe - vol_end)) {
+        continue;
+      }
+    } else if (o < ps || o >= pe) {
+      continue;
+    }
+    heads.emplace_back((o - ps + vol_end) % vol_end, *e);
+  }
+  std::sort(heads.begin(), heads.end(), [](auto const &a, auto const &b) { return a.first < b.first; });
+
+  DemoteQueue *queue = demote_queue(stripe);
+  queue->heads.clear();
+  for (auto const &head : heads) {
+    queue->heads.push_back(head.second);
+  }
+  Dbg(dbg_ctl_cache_tier, "%zu heads to demote from %s", heads.size(), stripe->hash_text.get());
+  if (!queue->heads.empty() && !queue->scheduled) {
+    queue->scheduled = true;
+    eventProcessor.schedule_imm(queue, ET_CALL);
+  }
+}
+
+void
+cache_tier_remove(StripeSM *fast, const CacheKey *key)
+{
+  CACHE_TRY_LOCK(lock, fast->mutex, this_ethread());
+  if (lock.is_locked()) {
+    delete_heads(fast, key);
+  } else {
+    eventProcessor.schedule_imm(new TierRemove(fast, key), ET_CALL);
+  }
+}
+
+void
+cache_tier_copied(CacheEvacuateDocVC *vc)
+{
+  if (vc->f.use_first_key) {
+    static_cast<TierCopy *>(vc->_action.continuation)->head_copied(vc);
+  } else {
+    dir_insert(&reinterpret_cast<Doc *>(vc->buf->data())->key, vc->stripe, &vc->dir);
+  }
+}
@@ -0,0 +1,68 @@
+/** @file
+
+  Copies of cached objects between the fast and the slow storage tier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/cache/CacheDefs.h"
+
+class StripeSM;
+class CacheEvacuateDocVC;
+
+/*
+  Spans marked tier=fast in storage.config make up the fast tier, the others
+  the slow tier. HTTP objects are written to their stripe in the slow tier as
+  before. A read hit there copies the object to its stripe in the fast tier,
+  which later reads are served from. As the fast stripe is about to overwrite
+  an object, it is copied back to the slow tier if it is no longer there.
+
+  A copy reads the Docs of the object from the source stripe and queues them to
+  the destination stripe as evacuations, the fragments first and the head last,
+  so the copy is only found once all of it is in the destination. A write or a
+  remove of the object deletes its copy in the fast tier.
+ */
+
+/// Count a read hit served from @a stripe in the hits of its tier.
+void cache_tier_hit(StripeSM *stripe);
+
+/**
+ * Copy the object with @a key from the slow tier @a stripe to @a fast.
+ *
+ * Called on a read hit in @a stripe, with its lock held. Does nothing if
+ * the object is being copied already or proxy.config.cache.tier.max_copies
+ * copies are in progress.
+ */
+void cache_tier_promote(StripeSM *stripe, StripeSM *fast, const CacheKey *key);
+
+/**
+ * Queue the heads of the objects the next writes to the fast tier @a stripe
+ * overwrite, to be copied back to the slow tier if they are not there.
+ *
+ * Called with the stripe lock held as the write position advances.
+ */
+void cache_tier_demote_scan(StripeSM *stripe);
+
+/// Delete the copy of the object with @a key in the fast tier @a fast.
+void cache_tier_remove(StripeSM *fast, const CacheKey *key);
+
+/// Handle a Doc of a copy having been copied to the destination stripe.
+void cache_tier_copied(CacheEvacuateDocVC *vc);
@@ -31,6 +31,7 @@
 
 // must be included after the others
 #include "iocore/cache/CacheVC.h"
+#include "iocore/cache/HttpTransactCache.h"
 
 // hdrs
 #include "proxy/hdrs/HTTP.h"
@@ -1045,6 +1046,10 @@ CacheVC::set_http_info(CacheHTTPInfo *ainfo)
     f.allow_empty_doc = 0;
   }
 
+  // Lets a request with the same selecting headers find this alternate without scoring the others.
+  ainfo->vary_fingerprint_set(
+    HttpTransactCache::calculate_alternate_vary_fingerprint(&ainfo->m_alt->m_request_hdr, &ainfo->m_alt->m_response_hdr));
+
   alternate.copy_shallow(ainfo);
   ainfo->clear();
 }
@@ -23,6 +23,11 @@
 
 #include "P_Cache.h"
 #include "P_CacheDoc.h"
+#include "CachePurgeIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
 
 namespace
 {
@@ -38,6 +43,38 @@ DbgCtl dbg_ctl_cache_insert{"cache_insert"};
 
 #endif
 
+// Index the object under the URL of the alternate being written and the surrogate keys of its response.
+void
+purge_index_insert(CacheKey const &key, CacheHTTPInfo &info)
+{
+  HTTPHdr *request  = info.request_get();
+  HTTPHdr *response = info.response_get();
+  if (!request->valid() || !response->valid()) {
+    return;
+  }
+
+  // As for alternate eviction, the request heap of the HttpSM may be gone.
+  request->mark_target_dirty();
+  int                  url_length = request->url_printed_length();
+  ats_scoped_mem<char> url_text;
+  url_text   = static_cast<char *>(ats_malloc(url_length + 1));
+  int index  = 0;
+  int offset = 0;
+  if (request->url_print(url_text.get(), url_length, &index, &offset) == 0) {
+    return;
+  }
+
+  std::string tags;
+  if (cache_config_purge_index_header && *cache_config_purge_index_header) {
+    for (MIMEField const *field = response->field_find(cache_config_purge_index_header, strlen(cache_config_purge_index_header));
+         field; field = field->m_next_dup) {
+      tags.append(field->value_get());
+      tags.push_back(' ');
+    }
+  }
+  cache_purge_index->insert(key, CachePurgeIndex::url_key({url_text.get(), static_cast<size_t>(url_length)}), tags);
+}
+
 } // end anonymous namespace
 
 // Given a key, finds the index of the alternate which matches
@@ -158,6 +195,10 @@ CacheVC::updateVector(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
         alternate.copy_frag_offsets_from(write_vector->get(alternate_index));
       }
       alternate_index = write_vector->insert(&alternate, alternate_index);
+      // Indexed here as the vector frees the headers of the alternate once it is written.
+      if (cache_purge_index) {
+        purge_index_insert(first_key, alternate);
+      }
     }
 
     if (od->move_resident_alt && first_buf.get() && !od->has_multiple_writers()) {
@@ -258,7 +299,7 @@ CacheVC::handleWrite(int event, Event * /* e ATS_UNUSED */)
   if (!stripe->is_io_in_progress()) {
     return stripe->aggWrite(event, this);
   }
-  return EVENT_CONT;
+  return stripe->aggregate_during_write(event);
 }
 
 int
@@ -417,6 +458,7 @@ CacheVC::openWriteCloseDataDone(int event, Event *e)
     fragment++;
     write_pos += write_len;
     dir_insert(&key, stripe, &dir);
+    cache_fanout_publish(this);
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
     if (length) {
@@ -513,6 +555,7 @@ CacheVC::openWriteWriteDone(int event, Event *e)
     ++fragment;
     write_pos += write_len;
     dir_insert(&key, stripe, &dir);
+    cache_fanout_publish(this);
     DDbg(dbg_ctl_cache_insert, "WriteDone: %X, %X, %d", key.slice32(0), first_key.slice32(0), write_len);
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
@@ -524,10 +567,27 @@ CacheVC::openWriteWriteDone(int event, Event *e)
   return openWriteMain(event, e);
 }
 
+// An object of a known length is written in fragments of twice the target
+// size, or four times, and so on up to proxy.config.cache.max_fragment_size,
+// while that still splits it. Large objects then take fewer directory entries
+// and are read in fewer, larger reads. Each size with its Doc is a multiple
+// of the target, so it fits the Dir size encoding as well as the target does.
 static inline int
-target_fragment_size()
+target_fragment_size(int64_t object_size)
 {
-  uint64_t value = cache_config_target_fragment_size - sizeof(Doc);
+  int64_t size = cache_config_target_fragment_size;
+  int64_t max  = std::min<int64_t>(cache_config_max_fragment_size, AGG_SIZE);
+
+  if (object_size != INT64_MAX) {
+    while (size * 2 <= max && object_size > size * 2) {
+      size *= 2;
+    }
+  }
+  if (size != cache_config_target_fragment_size) {
+    Metrics::Counter::increment(cache_rsb.large_fragment_objects);
+    DDbg(dbg_ctl_cache_write, "object of %" PRId64 " bytes written in fragments of %" PRId64, object_size, size);
+  }
+  uint64_t value = size - sizeof(Doc);
   ink_release_assert(value <= MAX_FRAG_SIZE);
   return value;
 }
@@ -579,12 +639,15 @@ Lagain:
     total_len += avail;
   }
   length = static_cast<uint64_t>(towrite);
-  if (length > target_fragment_size() && (length < target_fragment_size() + target_fragment_size() / 4)) {
-    write_len = target_fragment_size();
+  if (!fragment_size) {
+    fragment_size = target_fragment_size(vio.nbytes);
+  }
+  if (length > fragment_size && (length < fragment_size + fragment_size / 4)) {
+    write_len = fragment_size;
   } else {
     write_len = length;
   }
-  bool not_writing = towrite != ntodo && towrite < target_fragment_size();
+  bool not_writing = towrite != ntodo && towrite < fragment_size;
   if (!called_user) {
     if (not_writing) {
       called_user = 1;
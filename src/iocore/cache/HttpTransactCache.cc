@@ -31,8 +31,10 @@
 #include <ctime>
 #include "proxy/HttpAPIHooks.h"
 #include "proxy/hdrs/HTTP.h"
+#include "proxy/hdrs/HdrUtils.h"
 #include "proxy/hdrs/HttpCompat.h"
 
+#include "tscore/HashFNV.h"
 #include "tscore/InkErrno.h"
 #include "tscore/ink_time.h"
 
@@ -163,6 +165,146 @@ is_empty(char *s)
   return (s[0] == NUL);
 }
 
+/// Always checks the quality of match, and so the stored request headers must match.
+class StrictConfigAccessor : public HttpConfigAccessor
+{
+public:
+  int8_t
+  get_ignore_accept_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_charset_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_encoding_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_language_mismatch() const override
+  {
+    return 0;
+  }
+  const char *
+  get_global_user_agent_header() const override
+  {
+    return nullptr;
+  }
+};
+
+/**
+  Call @a f with the name and length of each request header that selects
+  the alternate with @a response: the Accept headers, which the quality of
+  match depends on, and the headers named by Vary.
+
+  @return @c false if the response varies on everything.
+
+*/
+template <typename F>
+bool
+for_each_selecting_header(HTTPHdr *response, F &&f)
+{
+  f(MIME_FIELD_ACCEPT, MIME_LEN_ACCEPT);
+  f(MIME_FIELD_ACCEPT_CHARSET, MIME_LEN_ACCEPT_CHARSET);
+  f(MIME_FIELD_ACCEPT_ENCODING, MIME_LEN_ACCEPT_ENCODING);
+  f(MIME_FIELD_ACCEPT_LANGUAGE, MIME_LEN_ACCEPT_LANGUAGE);
+
+  if (MIMEField *vary = response->field_find(MIME_FIELD_VARY, MIME_LEN_VARY); vary != nullptr) {
+    HdrCsvIter iter;
+    for (auto name = iter.get_first(vary); !name.empty(); name = iter.get_next()) {
+      if (name == "*") {
+        return false;
+      }
+      const char *wks = hdrtoken_string_to_wks(name.data(), name.size());
+      f(wks ? wks : name.data(), static_cast<int>(name.size()));
+    }
+  }
+  return true;
+}
+
+/**
+  Whether the selecting headers of @a client_request match those of the
+  stored @a obj_client_request, as in CalcVariability().
+
+*/
+bool
+selecting_headers_match(HTTPHdr *client_request, HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response)
+{
+  bool match = true;
+
+  match = for_each_selecting_header(obj_origin_server_response, [&](const char *name, int len) {
+            match = match && HttpCompat::do_vary_header_values_match(obj_client_request->field_find(name, len),
+                                                                     client_request->field_find(name, len));
+          }) &&
+          match;
+  return match;
+}
+
+/**
+  Select the alternate stored for a request with the same selecting headers
+  as @a client_request by the Vary fingerprints, the youngest if there are
+  several.
+
+  @return index in cache alternates vector, or -1 if there is no such alternate.
+
+*/
+int
+select_by_vary_fingerprint(CacheHTTPInfoVector *cache_vector, HTTPHdr *client_request)
+{
+  int              alt_count   = cache_vector->count();
+  int              best_index  = -1;
+  time_t           best_age    = CacheHighAgeWatermark;
+  time_t           t_now       = 0;
+  uint32_t         fingerprint = HTTPCacheAlt::NO_VARY_FINGERPRINT;
+  bool             reusable    = false;
+  std::string_view last_vary_value;
+
+  for (int i = 0; i < alt_count; i++) {
+    CacheHTTPInfo *obj = cache_vector->get(i);
+
+    if (obj->object_key_get().is_zero() || obj->vary_fingerprint_get() == HTTPCacheAlt::NO_VARY_FINGERPRINT) {
+      continue;
+    }
+
+    // The alternates of an object usually have the same Vary, fingerprint the request once for each.
+    HTTPHdr         *cached_response = obj->response_get();
+    MIMEField       *vary            = cached_response->field_find(MIME_FIELD_VARY, MIME_LEN_VARY);
+    std::string_view vary_value      = vary ? vary->value_get() : std::string_view{};
+    if (!reusable || vary_value != last_vary_value) {
+      fingerprint     = HttpTransactCache::calculate_vary_fingerprint(client_request, cached_response);
+      reusable        = !(vary && vary->has_dups());
+      last_vary_value = vary_value;
+    }
+
+    // A fingerprint can collide, the headers are compared to be sure.
+    if (fingerprint != obj->vary_fingerprint_get() ||
+        !selecting_headers_match(client_request, obj->request_get(), cached_response)) {
+      continue;
+    }
+
+    time_t current_age = 0;
+    if (alt_count > 1) {
+      if (t_now == 0) {
+        t_now = ink_hrtime_to_sec(ink_get_hrtime());
+      }
+      current_age = HttpTransactCache::calculate_document_age(obj->request_sent_time_get(), obj->response_received_time_get(),
+                                                              cached_response, cached_response->get_date(), t_now);
+      if (current_age < 0) {
+        current_age = CacheHighAgeWatermark;
+      }
+    }
+    if (best_index == -1 || current_age <= best_age) {
+      best_age   = current_age;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
 } // end anonymous namespace
 
 /**
@@ -204,6 +346,15 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
     return 0;
   }
 
+  // An alternate stored for a request with the same selecting headers is taken without scoring the
+  // others, unless a plugin scores them.
+  if (http_global_hooks->get(TS_HTTP_SELECT_ALT_HOOK) == nullptr) {
+    if (best_index = select_by_vary_fingerprint(cache_vector, client_request); best_index >= 0) {
+      Dbg(dbg_ctl_http_seq, "[SelectFromAlternates] Vary fingerprint chose alternate # %d", best_index);
+      return best_index;
+    }
+  }
+
   for (int i = 0; i < alt_count; i++) {
     float          Q;
     CacheHTTPInfo *obj             = cache_vector->get(i);
@@ -277,37 +428,72 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
 }
 
 /**
-  For cached req/res and incoming req, return quality of match.
+  Fingerprint the headers of @a request that select the alternate with
+  @a response, the Accept headers and the headers named by Vary. Header
+  values are compared as in CalcVariability(), without case and with the
+  values of repeated headers combined.
 
-  The current school of thought: quality 1st, freshness 2nd.  This
-  function takes a user agent request client_request and the two headers
-  for a cached object (obj_client_request and obj_origin_server_response),
-  and returns a floating point number for how well the object matches
-  the client's request.
+  @return the fingerprint, HTTPCacheAlt::NO_VARY_FINGERPRINT if the response
+  varies on everything.
 
-  Two factors currently affect a match: Accept headers, which filter and
-  sort the matches, and Vary headers, which constrain whether a dynamic
-  document matches a request.
+*/
+uint32_t
+HttpTransactCache::calculate_vary_fingerprint(HTTPHdr *request, HTTPHdr *response)
+{
+  ATSHash32FNV1a hash;
+
+  bool selectable = for_each_selecting_header(response, [&](const char *name, int len) {
+    hash.update(name, len, ATSHash::nocase());
+    if (MIMEField *field = request->field_find(name, len); field != nullptr) {
+      HdrCsvIter iter;
+      hash.update("=", 1);
+      for (auto value = iter.get_first(field); !value.empty(); value = iter.get_next()) {
+        hash.update(value.data(), value.size(), ATSHash::nocase());
+        hash.update(",", 1);
+      }
+    }
+    hash.update("\n", 1);
+  });
+  if (!selectable) {
+    return HTTPCacheAlt::NO_VARY_FINGERPRINT;
+  }
+  hash.final();
+  return hash.get() == HTTPCacheAlt::NO_VARY_FINGERPRINT ? 0 : hash.get();
+}
 
-  Note: According to the specs, specific matching takes precedence over
-  wildcard matching. For example, listed in precedence: text/html;q=0.5,
-  text/ascii, image/'*', '*'/'*'. So, ideally, in choosing between
-  alternates, we should given preference to those which matched
-  specifically over those which matched with wildcards.
+/**
+  The fingerprint to store with an alternate, if a request with the same
+  selecting headers can be served it without scoring the quality of match.
+  That is so if the request it was written for matches it.
 
-  @return quality (-1: no match, 0..1: poor..good).
+  @return the fingerprint, or HTTPCacheAlt::NO_VARY_FINGERPRINT.
 
 */
-float
-HttpTransactCache::calculate_quality_of_match(const HttpConfigAccessor *http_config_param, HTTPHdr *client_request,
-                                              HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response)
+uint32_t
+HttpTransactCache::calculate_alternate_vary_fingerprint(HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response)
 {
-  // For PURGE requests, any alternate is good really.
-  if (client_request->method_get_wksidx() == HTTP_WKSIDX_PURGE) {
-    return static_cast<float>(1.0);
+  static const StrictConfigAccessor strict;
+
+  if (!obj_client_request->valid() || !obj_origin_server_response->valid() ||
+      calculate_quality_of_accept_headers(&strict, obj_client_request, obj_client_request, obj_origin_server_response) <= 0.0 ||
+      CalcVariability(&strict, obj_client_request, obj_client_request, obj_origin_server_response) != VARIABILITY_NONE) {
+    return HTTPCacheAlt::NO_VARY_FINGERPRINT;
   }
+  return calculate_vary_fingerprint(obj_client_request, obj_origin_server_response);
+}
+
+/**
+  The quality of match of the Accept, Accept-Charset, Accept-Encoding and
+  Accept-Language headers, the part of calculate_quality_of_match() that
+  does not call plugins or check variability.
 
-  // Now calculate a quality based on all sorts of logic
+  @return quality (-1: no match, 0..1: poor..good).
+
+*/
+float
+HttpTransactCache::calculate_quality_of_accept_headers(const HttpConfigAccessor *http_config_param, HTTPHdr *client_request,
+                                                       HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response)
+{
   float      q[4], Q;
   MIMEField *accept_field;
   MIMEField *cached_accept_field;
@@ -427,6 +613,42 @@ HttpTransactCache::calculate_quality_of_match(const HttpConfigAccessor *http_con
   Dbg(dbg_ctl_http_alternate, "Mult's Quality Factor: %f", Q);
   Dbg(dbg_ctl_http_alternate, "----------End of Alternate----------");
 
+  return Q;
+}
+
+/**
+  For cached req/res and incoming req, return quality of match.
+
+  The current school of thought: quality 1st, freshness 2nd.  This
+  function takes a user agent request client_request and the two headers
+  for a cached object (obj_client_request and obj_origin_server_response),
+  and returns a floating point number for how well the object matches
+  the client's request.
+
+  Two factors currently affect a match: Accept headers, which filter and
+  sort the matches, and Vary headers, which constrain whether a dynamic
+  document matches a request.
+
+  Note: According to the specs, specific matching takes precedence over
+  wildcard matching. For example, listed in precedence: text/html;q=0.5,
+  text/ascii, image/'*', '*'/'*'. So, ideally, in choosing between
+  alternates, we should given preference to those which matched
+  specifically over those which matched with wildcards.
+
+  @return quality (-1: no match, 0..1: poor..good).
+
+*/
+float
+HttpTransactCache::calculate_quality_of_match(const HttpConfigAccessor *http_config_param, HTTPHdr *client_request,
+                                              HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response)
+{
+  // For PURGE requests, any alternate is good really.
+  if (client_request->method_get_wksidx() == HTTP_WKSIDX_PURGE) {
+    return static_cast<float>(1.0);
+  }
+
+  float Q = calculate_quality_of_accept_headers(http_config_param, client_request, obj_client_request, obj_origin_server_response);
+
   int force_alt = 0;
 
   if (Q > 0.0) {
@@ -34,6 +34,8 @@
 #include "../aio/P_AIO.h"
 #include "iocore/aio/AIO.h"
 
+#include <vector>
+
 class Stripe;
 class StripeSM;
 struct InterimCacheVol;
@@ -249,6 +251,8 @@ struct CacheSync : public Continuation {
   size_t              buflen       = 0;
   bool                buf_huge     = false;
   off_t               writepos     = 0;
+  std::vector<bool>   pages; // pages of buf to write
+  size_t              sync_bytes = 0;
   AIOCallbackInternal io;
   Event              *trigger    = nullptr;
   ink_hrtime          start_time = 0;
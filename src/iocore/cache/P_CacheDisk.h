@@ -96,6 +96,7 @@ struct CacheDisk : public Continuation {
   // Extra configuration values
   int            forced_volume_num = -1; ///< Volume number for this disk.
   ats_scoped_str hash_base_string;       ///< Base string for hash seed.
+  bool           fast_tier = false;      ///< Disk is in the fast storage tier.
 
   CacheDisk() : Continuation(new_ProxyMutex()) {}
 
@@ -47,15 +47,17 @@ struct CacheHostRecord {
   {
     ats_free(stripes);
     ats_free(vol_hash_table);
+    ats_free(fast_hash_table);
     ats_free(cp);
   }
 
-  CacheType       type           = CACHE_NONE_TYPE;
-  StripeSM      **stripes        = nullptr;
-  int             num_vols       = 0;
-  unsigned short *vol_hash_table = nullptr;
-  CacheVol      **cp             = nullptr;
-  int             num_cachevols  = 0;
+  CacheType       type            = CACHE_NONE_TYPE;
+  StripeSM      **stripes         = nullptr;
+  int             num_vols        = 0;
+  unsigned short *vol_hash_table  = nullptr;
+  unsigned short *fast_hash_table = nullptr; ///< Fast tier stripes, if there are stripes in both tiers.
+  CacheVol      **cp              = nullptr;
+  int             num_cachevols   = 0;
 
   CacheHostRecord() {}
 };
@@ -292,6 +294,7 @@ struct ConfigVol {
   off_t     size;
   bool      in_percent;
   bool      ramcache_enabled;
+  int       admission; // -1 follows proxy.config.cache.admission.enabled
   int       percent;
   CacheVol *cachep;
   LINK(ConfigVol, link);
@@ -35,6 +35,7 @@
 
 #include "iocore/cache/CacheVC.h"
 #include "CacheEvacuateDocVC.h"
+#include "CacheFanout.h"
 
 using ts::Metrics;
 
@@ -101,6 +102,8 @@ extern CacheStatsBlock cache_rsb;
 
 // Configuration
 extern int cache_config_dir_sync_frequency;
+extern int cache_config_dir_read_size;
+extern int64_t cache_config_dir_recovery_window;
 extern int cache_config_http_max_alts;
 extern int cache_config_log_alternate_eviction;
 extern int cache_config_permit_pinning;
@@ -111,6 +114,12 @@ extern int cache_config_agg_write_backlog;
 extern int cache_config_enable_checksum;
 extern int cache_config_alt_rewrite_max_size;
 extern int cache_config_read_while_writer;
+extern char *cache_config_purge_index_header;
+extern int cache_config_tier_max_copies;
+extern int64_t cache_config_tier_max_copy_size;
+extern int cache_config_tier_demote;
+extern int cache_config_admission_enabled;
+extern int cache_config_admission_min_requests;
 extern int cache_config_agg_write_backlog;
 extern int cache_config_ram_cache_compress;
 extern int cache_config_ram_cache_compress_percent;
@@ -119,9 +128,11 @@ extern int cache_config_hit_evacuate_percent;
 extern int cache_config_hit_evacuate_size_limit;
 extern int cache_config_force_sector_size;
 extern int cache_config_target_fragment_size;
+extern int cache_config_max_fragment_size;
 extern int cache_config_mutex_retry_delay;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_rww_fanout_fragments;
 
 #define PUSH_HANDLER(_x)                                          \
   do {                                                            \
@@ -198,6 +209,9 @@ free_CacheVCCommon(CacheVC *cont)
   }
   ink_assert(!cont->is_io_in_progress());
   ink_assert(!cont->od);
+  if (cont->fanout) {
+    cache_fanout_detach(cont);
+  }
   cont->io.action = nullptr;
   cont->io.mutex.clear();
   cont->io.aio_result       = 0;
@@ -447,13 +461,14 @@ class StripeSM;
 class CacheHostTable;
 
 struct Cache {
-  int       cache_read_done       = 0;
-  int       total_good_nvol       = 0;
-  int       total_nvol            = 0;
-  int       ready                 = CACHE_INITIALIZING;
-  int64_t   cache_size            = 0; // in store block size
-  int       total_initialized_vol = 0;
-  CacheType scheme                = CACHE_NONE_TYPE;
+  int        cache_read_done       = 0;
+  int        total_good_nvol       = 0;
+  int        total_nvol            = 0;
+  int        ready                 = CACHE_INITIALIZING;
+  int64_t    cache_size            = 0; // in store block size
+  int        total_initialized_vol = 0;
+  CacheType  scheme                = CACHE_NONE_TYPE;
+  ink_hrtime open_time             = 0; // when open() started, for the startup time
 
   ReplaceablePtr<CacheHostTable> hosttable;
 
@@ -481,6 +496,7 @@ struct Cache {
   int open_done();
 
   StripeSM *key_to_stripe(const CacheKey *key, const char *hostname, int host_len);
+  StripeSM *key_to_fast_stripe(const CacheKey *key, const char *hostname, int host_len);
 
   Cache() {}
 };
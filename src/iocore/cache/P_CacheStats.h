@@ -67,4 +67,34 @@ struct CacheStatsBlock {
   Metrics::Gauge::AtomicType   *span_offline          = nullptr;
   Metrics::Gauge::AtomicType   *span_online           = nullptr;
   Metrics::Gauge::AtomicType   *span_failing          = nullptr;
+
+  Metrics::Gauge::AtomicType *directory_sync_interval_bytes = nullptr;
+
+  Metrics::Gauge::AtomicType   *init_time          = nullptr;
+  Metrics::Counter::AtomicType *init_dir_read_time = nullptr;
+  Metrics::Counter::AtomicType *init_recover_time  = nullptr;
+  Metrics::Counter::AtomicType *init_recover_bytes = nullptr;
+  Metrics::Counter::AtomicType *write_ahead_writes = nullptr;
+  Metrics::Counter::AtomicType *write_ahead_stalls = nullptr;
+
+  Metrics::Counter::AtomicType *purge_requests      = nullptr;
+  Metrics::Counter::AtomicType *purge_objects       = nullptr;
+  Metrics::Counter::AtomicType *purge_time          = nullptr;
+  Metrics::Gauge::AtomicType   *purge_index_entries = nullptr;
+
+  Metrics::Counter::AtomicType *tier_fast_hits   = nullptr;
+  Metrics::Counter::AtomicType *tier_slow_hits   = nullptr;
+  Metrics::Counter::AtomicType *tier_promotions  = nullptr;
+  Metrics::Counter::AtomicType *tier_demotions   = nullptr;
+  Metrics::Counter::AtomicType *tier_copy_aborts = nullptr;
+
+  Metrics::Counter::AtomicType *read_busy_fanout_writers = nullptr;
+  Metrics::Counter::AtomicType *read_busy_fanout_readers = nullptr;
+  Metrics::Counter::AtomicType *read_busy_fanout_bytes   = nullptr;
+
+  Metrics::Counter::AtomicType *large_fragment_objects = nullptr;
+
+  Metrics::Counter::AtomicType *admission_admitted        = nullptr;
+  Metrics::Counter::AtomicType *admission_rejected        = nullptr;
+  Metrics::Counter::AtomicType *admission_rejected_misses = nullptr;
 };
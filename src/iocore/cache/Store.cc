@@ -40,6 +40,7 @@
 //
 const char Store::VOLUME_KEY[]           = "volume";
 const char Store::HASH_BASE_STRING_KEY[] = "id";
+const char Store::TIER_KEY[]             = "tier";
 
 namespace
 {
@@ -193,6 +194,12 @@ Span::volume_number_set(int n)
   forced_volume_num = n;
 }
 
+void
+Span::tier_set(bool fast)
+{
+  fast_tier = fast;
+}
+
 void
 Store::delete_all()
 {
@@ -264,6 +271,7 @@ Store::read_config()
 
     int64_t     size       = -1;
     int         volume_num = -1;
+    bool        fast_tier  = false;
     const char *e;
     while (nullptr != (e = tokens.getNext())) {
       if (ParseRules::is_digit(*e)) {
@@ -291,14 +299,26 @@ Store::read_config()
           Error("%s failed to load", ts::filename::STORAGE);
           return Result::failure("failed to parse volume number '%s'", e);
         }
+      } else if (0 == strncasecmp(TIER_KEY, e, sizeof(TIER_KEY) - 1)) {
+        e += sizeof(TIER_KEY) - 1;
+        if ('=' == *e) {
+          ++e;
+        }
+        if (0 == strcasecmp(e, "fast")) {
+          fast_tier = true;
+        } else if (0 != strcasecmp(e, "slow")) {
+          delete sd;
+          Error("%s failed to load", ts::filename::STORAGE);
+          return Result::failure("failed to parse storage tier '%s'", e);
+        }
       }
     }
 
     std::string pp = Layout::get()->relative(path);
 
     ns = new Span;
-    Dbg(dbg_ctl_cache_init, "Store::read_config - ns = new Span; ns->init(\"%s\",%" PRId64 "), forced volume=%d%s%s", pp.c_str(),
-        size, volume_num, seed ? " id=" : "", seed ? seed : "");
+    Dbg(dbg_ctl_cache_init, "Store::read_config - ns = new Span; ns->init(\"%s\",%" PRId64 "), forced volume=%d%s%s%s",
+        pp.c_str(), size, volume_num, seed ? " id=" : "", seed ? seed : "", fast_tier ? " tier=fast" : "");
     if ((err = ns->init(pp.c_str(), size))) {
       Dbg(dbg_ctl_cache_init, "Store::read_config - could not initialize storage \"%s\" [%s]", pp.c_str(), err);
       delete ns;
@@ -314,6 +334,7 @@ Store::read_config()
     if (volume_num > 0) {
       ns->volume_number_set(volume_num);
     }
+    ns->tier_set(fast_tier);
 
     // new Span
     {
@@ -28,6 +28,7 @@
 #include "tscore/ink_assert.h"
 #include "tscore/ink_memory.h"
 
+#include <algorithm>
 #include <cstring>
 
 using CacheHTTPInfo = HTTPInfo;
@@ -242,6 +243,7 @@ Stripe::_clear_init()
   this->header->dirty                                              = 0;
   this->sector_size = this->header->sector_size = this->disk->hw_sector_size;
   *this->footer                                 = *this->header;
+  this->mark_dir_all_dirty();
 }
 
 void
@@ -306,20 +308,69 @@ Stripe::_init_data(off_t blocks, off_t dir_skip)
   dir    = reinterpret_cast<Dir *>(raw_dir + this->headerlen());
   header = reinterpret_cast<StripteHeaderFooter *>(raw_dir);
   footer = reinterpret_cast<StripteHeaderFooter *>(raw_dir + this->dirlen() - ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter)));
+
+  // Neither copy on disk is known to match memory yet.
+  _dir_dirty_pages.assign(this->dirlen() / STORE_BLOCK_SIZE, DIR_DIRTY_ALL);
+}
+
+void
+Stripe::mark_dir_all_dirty()
+{
+  std::fill(this->_dir_dirty_pages.begin(), this->_dir_dirty_pages.end(), DIR_DIRTY_ALL);
+}
+
+size_t
+Stripe::copy_dirty_dir(int copy, char *buf, std::vector<bool> &pages)
+{
+  size_t  npages   = this->dirlen() / STORE_BLOCK_SIZE;
+  size_t  nheader  = this->headerlen() / STORE_BLOCK_SIZE;
+  uint8_t bit      = 1 << copy;
+  size_t  copied   = 0;
+  bool    tracking = !this->_dir_dirty_pages.empty();
+
+  pages.assign(npages, false);
+  for (size_t p = 0; p < npages; p++) {
+    if (p < nheader || p == npages - 1 || !tracking || (this->_dir_dirty_pages[p] & bit)) {
+      pages[p] = true;
+    }
+  }
+  for (size_t p = 0; p < npages;) {
+    if (!pages[p]) {
+      p++;
+      continue;
+    }
+    // copy runs of dirty pages at a time
+    size_t end = p + 1;
+    while (end < npages && pages[end]) {
+      end++;
+    }
+    memcpy(buf + p * STORE_BLOCK_SIZE, this->raw_dir + p * STORE_BLOCK_SIZE, (end - p) * STORE_BLOCK_SIZE);
+    copied += (end - p) * STORE_BLOCK_SIZE;
+    for (; tracking && p < end; p++) {
+      this->_dir_dirty_pages[p] &= ~bit;
+    }
+    p = end;
+  }
+  return copied;
 }
 
 bool
 Stripe::flush_aggregate_write_buffer()
 {
   // set write limit
-  this->header->agg_pos = this->header->write_pos + this->_write_buffer.get_buffer_pos();
+  this->header->agg_pos = this->header->write_pos + this->get_agg_buf_pos();
 
   if (!this->_write_buffer.flush(this->fd, this->header->write_pos)) {
     return false;
   }
   this->header->last_write_pos  = this->header->write_pos;
-  this->header->write_pos      += this->_write_buffer.get_buffer_pos();
+  this->header->write_pos      += this->get_agg_buf_pos();
   ink_assert(this->header->write_pos == this->header->agg_pos);
+  // The documents of the filling buffer carry the serial after that of the flushing buffer.
+  if (this->_write_buffer.is_flushing()) {
+    this->_write_buffer.end_flush();
+    this->header->write_serial++;
+  }
   this->_write_buffer.reset_buffer_pos();
   this->header->write_serial++;
 
@@ -34,6 +34,7 @@
 #include "tscore/ink_memory.h"
 
 #include <cstdint>
+#include <vector>
 
 #define CACHE_BLOCK_SHIFT        9
 #define CACHE_BLOCK_SIZE         (1 << CACHE_BLOCK_SHIFT) // 512, smallest sector size
@@ -45,14 +46,17 @@
 // This is defined here so CacheVC can avoid including StripeSM.h.
 #define RECOVERY_SIZE EVACUATION_SIZE // 8MB
 
+class CacheAdmission;
+
 struct CacheVol {
-  int          vol_number       = -1;
-  int          scheme           = 0;
-  off_t        size             = 0;
-  int          num_vols         = 0;
-  bool         ramcache_enabled = true;
-  StripeSM   **stripes          = nullptr;
-  DiskStripe **disk_stripes     = nullptr;
+  int             vol_number       = -1;
+  int             scheme           = 0;
+  off_t           size             = 0;
+  int             num_vols         = 0;
+  bool            ramcache_enabled = true;
+  StripeSM      **stripes          = nullptr;
+  DiskStripe    **disk_stripes     = nullptr;
+  CacheAdmission *admission        = nullptr; // write admission filter, if enabled
   LINK(CacheVol, link);
   // per volume stats
   CacheStatsBlock vol_rsb;
@@ -74,7 +78,7 @@ struct StripteHeaderFooter {
   uint32_t          write_serial;
   uint32_t          dirty;
   uint32_t          sector_size;
-  uint32_t          unused; // pad out to 8 byte boundary
+  uint32_t          write_ahead; // STORE_BLOCKs past write_pos that may have been written, 0 if unknown
   uint16_t          freelist[1];
 };
 
@@ -120,6 +124,21 @@ public:
    */
   size_t dirlen() const;
 
+  /* The directory is written to the A and B copies on disk in turn. For each
+     STORE_BLOCK_SIZE page of the directory we keep which copies are behind
+     memory, so that a sync only writes the pages that changed since that copy
+     was last written.
+   */
+  void mark_dir_dirty(const Dir *e);
+  void mark_dir_segment_dirty(int s);
+  void mark_dir_all_dirty();
+  /* Copy the pages which are dirty for @a copy into @a buf at their offset in
+     the directory, set them in @a pages and mark them clean for @a copy. The
+     header, freelist and footer pages are always copied.
+     Returns the number of bytes copied.
+   */
+  size_t copy_dirty_dir(int copy, char *buf, std::vector<bool> &pages);
+
   bool dir_valid(const Dir *dir) const;
   bool dir_agg_valid(const Dir *dir) const;
   bool dir_agg_buf_valid(const Dir *dir) const;
@@ -136,7 +155,18 @@ public:
   /* Length of the partition not including the offset of location 0.
    */
   off_t vol_relative_length(off_t start_offset) const;
+  /* Bytes the write position moves to get from @a from to @a to, wrapping
+     around the end of the data.
+   */
+  off_t write_distance(off_t from, off_t to) const;
+  /* The write position @a n bytes after @a pos, wrapping around the end of
+     the data.
+   */
+  off_t write_advance(off_t pos, off_t n) const;
 
+  /* Number of bytes in the aggregation buffers past the write position,
+     including the buffer being written, if any.
+   */
   int get_agg_buf_pos() const;
 
   /**
@@ -162,7 +192,12 @@ protected:
   bool flush_aggregate_write_buffer();
 
 private:
+  static constexpr uint8_t DIR_DIRTY_ALL = 0x3; ///< Dirty for both copies.
+
+  std::vector<uint8_t> _dir_dirty_pages;
+
   void _init_data_internal();
+  void _mark_dir_dirty(size_t pos, size_t len);
 };
 
 inline uint32_t
@@ -197,6 +232,31 @@ Stripe::dirlen() const
          ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
 }
 
+inline void
+Stripe::_mark_dir_dirty(size_t pos, size_t len)
+{
+  if (this->_dir_dirty_pages.empty()) {
+    return;
+  }
+  ink_assert(pos + len <= this->_dir_dirty_pages.size() * STORE_BLOCK_SIZE);
+  for (size_t p = pos / STORE_BLOCK_SIZE; p <= (pos + len - 1) / STORE_BLOCK_SIZE; p++) {
+    this->_dir_dirty_pages[p] = DIR_DIRTY_ALL;
+  }
+}
+
+inline void
+Stripe::mark_dir_dirty(const Dir *e)
+{
+  this->_mark_dir_dirty(reinterpret_cast<const char *>(e) - this->raw_dir, SIZEOF_DIR);
+}
+
+inline void
+Stripe::mark_dir_segment_dirty(int s)
+{
+  this->_mark_dir_dirty(reinterpret_cast<const char *>(this->dir_segment(s)) - this->raw_dir,
+                        this->buckets * DIR_DEPTH * SIZEOF_DIR);
+}
+
 /**
   entry is valid
  */
@@ -242,14 +302,14 @@ Stripe::vol_out_of_phase_write_valid(Dir const *e) const
 inline int
 Stripe::vol_in_phase_valid(Dir const *e) const
 {
-  return (dir_offset(e) - 1 < ((this->header->write_pos + this->_write_buffer.get_buffer_pos() - this->start) / CACHE_BLOCK_SIZE));
+  return (dir_offset(e) - 1 < ((this->header->write_pos + this->get_agg_buf_pos() - this->start) / CACHE_BLOCK_SIZE));
 }
 
 inline int
 Stripe::vol_in_phase_agg_buf_valid(Dir const *e) const
 {
   return (this->vol_offset(e) >= this->header->write_pos &&
-          this->vol_offset(e) < (this->header->write_pos + this->_write_buffer.get_buffer_pos()));
+          this->vol_offset(e) < (this->header->write_pos + this->get_agg_buf_pos()));
 }
 
 inline off_t
@@ -276,8 +336,24 @@ Stripe::vol_relative_length(off_t start_offset) const
   return (this->len + this->skip) - start_offset;
 }
 
+inline off_t
+Stripe::write_distance(off_t from, off_t to) const
+{
+  return to >= from ? to - from : (this->skip + this->len - from) + (to - this->start);
+}
+
+inline off_t
+Stripe::write_advance(off_t pos, off_t n) const
+{
+  pos += n;
+  while (pos >= this->skip + this->len) {
+    pos -= this->skip + this->len - this->start;
+  }
+  return pos;
+}
+
 inline int
 Stripe::get_agg_buf_pos() const
 {
-  return this->_write_buffer.get_buffer_pos();
+  return this->_write_buffer.get_flush_len() + this->_write_buffer.get_buffer_pos();
 }
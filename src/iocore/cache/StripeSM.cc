@@ -29,6 +29,7 @@
 #include "P_CacheDir.h"
 
 #include "CacheEvacuateDocVC.h"
+#include "CacheTier.h"
 #include "PreservationTable.h"
 #include "Stripe.h"
 
@@ -52,6 +53,7 @@
 #include "tscore/ink_hrtime.h"
 #include "tscore/List.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstddef>
 #include <cstdlib>
@@ -88,15 +90,29 @@ static void update_header_info(CacheVC *vc, Doc *doc);
 static int  evacuate_fragments(CacheKey *key, CacheKey *earliest_key, int force, StripeSM *stripe);
 
 struct StripeInitInfo {
+  static constexpr int DIR_READ_AIOS = 8; ///< Directory reads in flight per stripe.
+
   off_t               recover_pos;
   AIOCallbackInternal vol_aio[4];
   char               *vol_h_f;
 
+  AIOCallbackInternal dir_aio[DIR_READ_AIOS];
+  off_t               dir_offset  = 0; ///< Start of the directory copy being read.
+  size_t              dir_pos     = 0; ///< Next byte of the directory to read.
+  size_t              dir_chunk   = 0;
+  int                 dir_pending = 0;
+  bool                dir_failed  = false;
+
+  ink_hrtime start_time    = 0;
+  ink_hrtime recover_time  = 0;
+  int64_t    recover_bytes = 0;
+
   StripeInitInfo()
   {
     recover_pos = 0;
     vol_h_f     = static_cast<char *>(ats_memalign(ats_pagesize(), 4 * STORE_BLOCK_SIZE));
     memset(vol_h_f, 0, 4 * STORE_BLOCK_SIZE);
+    start_time = ink_get_hrtime();
   }
 
   ~StripeInitInfo()
@@ -105,6 +121,10 @@ struct StripeInitInfo {
       i.action = nullptr;
       i.mutex.clear();
     }
+    for (auto &i : dir_aio) {
+      i.action = nullptr;
+      i.mutex.clear();
+    }
     free(vol_h_f);
   }
 };
@@ -245,17 +265,70 @@ StripeSM::handle_dir_clear(int event, void *data)
   return EVENT_DONE;
 }
 
+/**
+  Read the directory copy at @a offset into memory in chunks of
+  proxy.config.cache.dir.read_size, several at a time.
+ */
+void
+StripeSM::_read_dir(off_t offset)
+{
+  size_t dir_len = this->dirlen();
+
+  SET_HANDLER(&StripeSM::handle_dir_read);
+  init_info->dir_offset = offset;
+  init_info->dir_pos    = 0;
+  init_info->dir_chunk  = cache_config_dir_read_size > 0 ? ROUND_TO_STORE_BLOCK(cache_config_dir_read_size) : dir_len;
+  for (auto &aio : init_info->dir_aio) {
+    if (init_info->dir_pos >= dir_len) {
+      break;
+    }
+    aio.aiocb.aio_fildes = fd;
+    aio.action           = this;
+    aio.thread           = AIO_CALLBACK_THREAD_ANY;
+    aio.then             = nullptr;
+    this->_read_dir_chunk(&aio);
+  }
+}
+
+void
+StripeSM::_read_dir_chunk(AIOCallback *aio)
+{
+  size_t n = std::min(init_info->dir_chunk, this->dirlen() - init_info->dir_pos);
+
+  aio->aiocb.aio_buf     = raw_dir + init_info->dir_pos;
+  aio->aiocb.aio_nbytes  = n;
+  aio->aiocb.aio_offset  = init_info->dir_offset + init_info->dir_pos;
+  init_info->dir_pos    += n;
+  init_info->dir_pending++;
+  ink_assert(ink_aio_read(aio));
+}
+
 int
 StripeSM::handle_dir_read(int event, void *data)
 {
   AIOCallback *op = static_cast<AIOCallback *>(data);
 
   if (event == AIO_EVENT_DONE) {
+    init_info->dir_pending--;
     if (!op->ok()) {
+      init_info->dir_failed = true;
+    } else if (!init_info->dir_failed && init_info->dir_pos < this->dirlen()) {
+      this->_read_dir_chunk(op);
+    }
+    if (init_info->dir_pending) {
+      return EVENT_CONT;
+    }
+    if (init_info->dir_failed) {
       Note("Directory read failed: clearing cache directory %s", this->hash_text.get());
+      delete init_info;
+      init_info = nullptr;
       clear_dir_aio();
       return EVENT_DONE;
     }
+    ink_hrtime now = ink_get_hrtime();
+    Metrics::Counter::increment(cache_rsb.init_dir_read_time, now - init_info->start_time);
+    Metrics::Counter::increment(cache_vol->vol_rsb.init_dir_read_time, now - init_info->start_time);
+    init_info->recover_time = now;
   }
 
   if (!(header->magic == STRIPE_MAGIC && footer->magic == STRIPE_MAGIC &&
@@ -353,6 +426,21 @@ StripeSM::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
       SET_HANDLER(&StripeSM::handle_recover_write_dir);
       return handle_recover_write_dir(EVENT_IMMEDIATE, nullptr);
     }
+    if (footer->write_ahead) {
+      // Everything written since the sync is within write_ahead of write_pos,
+      // so that range is cleared without scanning the data.
+      off_t ahead = footer->write_ahead == WRITE_AHEAD_ALL ? len : static_cast<off_t>(footer->write_ahead) * STORE_BLOCK_SIZE;
+      io.aiocb.aio_buf = nullptr;
+      if (ahead >= (skip + len) - start - EVACUATION_SIZE) {
+        Warning("writes since the last directory sync may cover '%s', clearing", hash_text.get());
+        goto Lclear;
+      }
+      recover_wrapped = false;
+      recover_pos     = this->write_advance(header->write_pos, ahead);
+      // Documents may carry the serial of a sync which did not complete.
+      max_sync_serial = header->sync_serial + 2;
+      goto Lbounded;
+    }
     // initialize
     recover_wrapped   = false;
     last_sync_serial  = 0;
@@ -373,6 +461,7 @@ StripeSM::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
       disk->incrErrors(&io);
       goto Lclear;
     }
+    init_info->recover_bytes += io.aiocb.aio_nbytes;
     if (io.aiocb.aio_offset == header->last_write_pos) {
       /* check that we haven't wrapped around without syncing
          the directory. Start from last_write_serial (write pos the documents
@@ -546,6 +635,7 @@ Ldone: {
   if (recover_pos > skip + len) {
     recover_pos -= skip + len;
   }
+Lbounded:
   // bump sync number so it is different from that in the Doc structs
   uint32_t next_sync_serial = max_sync_serial + 1;
   // make that the next sync does not overwrite our good copy!
@@ -566,6 +656,8 @@ Ldone: {
        header->write_pos, recover_pos, header->sync_serial, next_sync_serial);
 
   footer->sync_serial = header->sync_serial = next_sync_serial;
+  // The writer moves the write ahead marker before writing past write_pos.
+  footer->write_ahead = 0;
 
   for (int i = 0; i < 3; i++) {
     AIOCallback *aio      = &(init_info->vol_aio[i]);
@@ -608,6 +700,16 @@ StripeSM::handle_recover_write_dir(int /* event ATS_UNUSED */, void * /* data AT
   if (io.aiocb.aio_buf) {
     free(static_cast<char *>(io.aiocb.aio_buf));
   }
+  if (init_info && init_info->recover_time) {
+    ink_hrtime elapsed = ink_get_hrtime() - init_info->recover_time;
+    Metrics::Counter::increment(cache_rsb.init_recover_time, elapsed);
+    Metrics::Counter::increment(cache_vol->vol_rsb.init_recover_time, elapsed);
+    Metrics::Counter::increment(cache_rsb.init_recover_bytes, init_info->recover_bytes);
+    Metrics::Counter::increment(cache_vol->vol_rsb.init_recover_bytes, init_info->recover_bytes);
+    Dbg(dbg_ctl_cache_init, "Stripe %s: directory read in %" PRId64 " ms, recovered in %" PRId64 " ms reading %" PRId64 " bytes",
+        hash_text.get(), ink_hrtime_to_msec(init_info->recover_time - init_info->start_time), ink_hrtime_to_msec(elapsed),
+        init_info->recover_bytes);
+  }
   delete init_info;
   init_info = nullptr;
   set_io_not_in_progress();
@@ -652,30 +754,29 @@ StripeSM::handle_header_read(int event, void *data)
       op = op->then;
     }
 
+    // Recovery reads and writes through io once the directory is in.
     io.aiocb.aio_fildes = fd;
-    io.aiocb.aio_nbytes = this->dirlen();
-    io.aiocb.aio_buf    = raw_dir;
     io.action           = this;
     io.thread           = AIO_CALLBACK_THREAD_ANY;
     io.then             = nullptr;
 
+    // The write ahead marker keeps the footers of both copies up to date.
+    write_ahead.set_footer(0, *hf[1]);
+    write_ahead.set_footer(1, *hf[3]);
+
     if (hf[0]->sync_serial == hf[1]->sync_serial &&
         (hf[0]->sync_serial >= hf[2]->sync_serial || hf[2]->sync_serial != hf[3]->sync_serial)) {
-      SET_HANDLER(&StripeSM::handle_dir_read);
       if (dbg_ctl_cache_init.on()) {
         Note("using directory A for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip;
-      ink_assert(ink_aio_read(&io));
+      this->_read_dir(skip);
     }
     // try B
     else if (hf[2]->sync_serial == hf[3]->sync_serial) {
-      SET_HANDLER(&StripeSM::handle_dir_read);
       if (dbg_ctl_cache_init.on()) {
         Note("using directory B for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip + this->dirlen();
-      ink_assert(ink_aio_read(&io));
+      this->_read_dir(skip + this->dirlen());
     } else {
       Note("no good directory, clearing '%s' since sync_serials on both A and B copies are invalid", hash_text.get());
       Note("Header A: %d\nFooter A: %d\n Header B: %d\n Footer B %d\n", hf[0]->sync_serial, hf[1]->sync_serial, hf[2]->sync_serial,
@@ -698,6 +799,14 @@ StripeSM::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */
     eventProcessor.schedule_in(this, HRTIME_MSECONDS(5), ET_CALL);
     return EVENT_CONT;
   } else {
+    if (fd != -1) {
+      write_ahead.set_footer(header->sync_serial & 1, *footer);
+      write_ahead.init(this, cache_config_dir_recovery_window);
+    }
+    // Time from the cache open until the last stripe was ready.
+    int64_t init_ms = ink_hrtime_to_msec(ink_get_hrtime() - cache->open_time);
+    Metrics::Gauge::store(cache_rsb.init_time, init_ms);
+    Metrics::Gauge::store(cache_vol->vol_rsb.init_time, init_ms);
     int i = gnstripes++;
     ink_assert(!gstripes[i]);
     gstripes[i] = this;
@@ -734,8 +843,9 @@ StripeSM::aggWriteDone(int event, Event *e)
     if (header->write_pos + EVACUATION_SIZE > scan_pos) {
       ink_assert(this->mutex->thread_holding == this_ethread());
       this->_preserved_dirs.periodic_scan(this);
+      cache_tier_demote_scan(this);
     }
-    this->_write_buffer.reset_buffer_pos();
+    this->_write_buffer.end_flush();
     header->write_serial++;
   } else {
     // delete all the directory entries that we inserted
@@ -746,13 +856,20 @@ StripeSM::aggWriteDone(int event, Event *e)
         (uint64_t)io.aiocb.aio_offset / CACHE_BLOCK_SIZE, (uint64_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) / CACHE_BLOCK_SIZE);
     Dir del_dir;
     dir_clear(&del_dir);
-    for (int done = 0; done < this->_write_buffer.get_buffer_pos();) {
-      Doc *doc = reinterpret_cast<Doc *>(this->_write_buffer.get_buffer() + done);
+    for (int done = 0; done < this->_write_buffer.get_flush_len();) {
+      Doc *doc = reinterpret_cast<Doc *>(this->_write_buffer.get_flush_buffer() + done);
       dir_set_offset(&del_dir, header->write_pos + done);
       dir_delete(&doc->key, this, &del_dir);
       done += round_to_approx_size(doc->len);
     }
-    this->_write_buffer.reset_buffer_pos();
+    this->_write_buffer.end_flush();
+    if (!this->_write_buffer.is_empty()) {
+      // The fragments aggregated during the write were placed after it, so
+      // skip the failed range to keep them where their directory entries are.
+      header->last_write_pos = header->write_pos;
+      header->write_pos      = header->agg_pos;
+      header->write_serial++;
+    }
   }
   set_io_not_in_progress();
   // callback ready sync CacheVCs
@@ -769,7 +886,8 @@ StripeSM::aggWriteDone(int event, Event *e)
     dir_sync_waiting = false;
     cacheDirSync->handleEvent(EVENT_IMMEDIATE, nullptr);
   }
-  if (this->_write_buffer.get_pending_writers().head || sync.head) {
+  // The directory sync may have started the next write already.
+  if (!is_io_in_progress() && (this->_write_buffer.get_pending_writers().head || sync.head || !this->_write_buffer.is_empty())) {
     return aggWrite(event, e);
   }
   return EVENT_CONT;
@@ -849,13 +967,21 @@ Lagain:
     d->write_serial = header->write_serial;
   }
 
+  // the footers on disk must cover the write before it starts
+  if (!write_ahead.covers(header->write_pos + this->_write_buffer.get_buffer_pos())) {
+    goto Lwait;
+  }
+
   // set write limit
   header->agg_pos = header->write_pos + this->_write_buffer.get_buffer_pos();
 
+  // Writers arriving from now on are copied into the other buffer.
+  this->_write_buffer.begin_flush();
+
   io.aiocb.aio_fildes = fd;
   io.aiocb.aio_offset = header->write_pos;
-  io.aiocb.aio_buf    = this->_write_buffer.get_buffer();
-  io.aiocb.aio_nbytes = this->_write_buffer.get_buffer_pos();
+  io.aiocb.aio_buf    = this->_write_buffer.get_flush_buffer();
+  io.aiocb.aio_nbytes = this->_write_buffer.get_flush_len();
   io.action           = this;
   /*
     Callback on AIO thread so that we can issue a new write ASAP
@@ -867,7 +993,28 @@ Lagain:
   ink_aio_write(&io);
 
 Lwait:
-  int ret = EVENT_CONT;
+  return this->_call_aggregated_writers(event, tocall);
+}
+
+int
+StripeSM::aggregate_during_write(int event)
+{
+  if (!this->_write_buffer.is_flushing()) {
+    return EVENT_CONT;
+  }
+
+  Que(CacheVC, link) tocall;
+
+  this->aggregate_pending_writes(tocall);
+  return this->_call_aggregated_writers(event, tocall);
+}
+
+int
+StripeSM::_call_aggregated_writers(int event, Queue<CacheVC, Continuation::Link_link> &tocall)
+{
+  int      ret = EVENT_CONT;
+  CacheVC *c;
+
   while ((c = tocall.dequeue())) {
     if (event == EVENT_CALL && c->mutex->thread_holding == mutex->thread_holding) {
       ret = EVENT_RETURN;
@@ -886,11 +1033,11 @@ StripeSM::aggregate_pending_writes(Queue<CacheVC, Continuation::Link_link> &toca
     // [amc] this is checked multiple places, on here was it strictly less.
     ink_assert(writelen <= AGG_SIZE);
     if (this->_write_buffer.get_buffer_pos() + writelen > AGG_SIZE ||
-        this->header->write_pos + this->_write_buffer.get_buffer_pos() + writelen > (this->skip + this->len)) {
+        this->header->write_pos + this->get_agg_buf_pos() + writelen > (this->skip + this->len)) {
       break;
     }
     DDbg(dbg_ctl_agg_read, "copying: %d, %" PRIu64 ", key: %d", this->_write_buffer.get_buffer_pos(),
-         this->header->write_pos + this->_write_buffer.get_buffer_pos(), c->first_key.slice32(0));
+         this->header->write_pos + this->get_agg_buf_pos(), c->first_key.slice32(0));
     [[maybe_unused]] int wrotelen = this->_agg_copy(c);
     ink_assert(writelen == wrotelen);
     CacheVC *n = static_cast<CacheVC *>(c->link.next);
@@ -930,9 +1077,9 @@ StripeSM::_copy_evacuator_to_aggregation(CacheVC *vc)
   Metrics::Counter::increment(this->cache_vol->vol_rsb.gc_frags_evacuated);
 
   doc->sync_serial  = this->header->sync_serial;
-  doc->write_serial = this->header->write_serial;
+  doc->write_serial = this->_agg_write_serial();
 
-  off_t doc_offset{this->header->write_pos + this->_write_buffer.get_buffer_pos()};
+  off_t doc_offset{this->header->write_pos + this->get_agg_buf_pos()};
   this->_write_buffer.add(doc, approx_size);
 
   vc->dir = vc->overwrite_dir;
@@ -960,7 +1107,7 @@ StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
   // fill in document header
   init_document(vc, doc, len);
   doc->sync_serial = this->header->sync_serial;
-  vc->write_serial = doc->write_serial = this->header->write_serial;
+  vc->write_serial = doc->write_serial = this->_agg_write_serial();
   if (vc->get_pin_in_cache()) {
     dir_set_pinned(&vc->dir, 1);
     doc->pin(vc->get_pin_in_cache());
@@ -1091,6 +1238,7 @@ StripeSM::agg_wrap()
   }
   ink_assert(this->mutex->thread_holding == this_ethread());
   this->_preserved_dirs.periodic_scan(this);
+  cache_tier_demote_scan(this);
 }
 
 int
@@ -1285,6 +1433,10 @@ StripeSM::evacuateWrite(CacheEvacuateDocVC *evacuator, int event, Event *e)
   }
   ink_assert(evacuator->agg_len <= AGG_SIZE);
   this->_write_buffer.get_pending_writers().insert(evacuator, after);
+  // Copies between the storage tiers come from outside the stripe state machine.
+  if (is_io_in_progress()) {
+    return aggregate_during_write(event);
+  }
   return aggWrite(event, e);
 }
 
@@ -1348,7 +1500,7 @@ StripeSM::shutdown(EThread *shutdown_thread)
   // check if we have data in the agg buffer
   // dont worry about the cachevc s in the agg queue
   // directories have not been inserted for these writes
-  if (!this->_write_buffer.is_empty()) {
+  if (this->get_agg_buf_pos()) {
     Dbg(dbg_ctl_cache_dir_sync, "Dir %s: flushing agg buffer first", this->hash_text.get());
     this->flush_aggregate_write_buffer();
   }
@@ -1360,6 +1512,8 @@ StripeSM::shutdown(EThread *shutdown_thread)
     Dbg(dbg_ctl_cache_dir_sync, "Periodic dir sync in progress -- overwriting");
   }
   this->footer->sync_serial = this->header->sync_serial;
+  // Nothing is written after this copy.
+  this->footer->write_ahead = 0;
 
   CHECK_DIR(d);
   size_t B     = this->header->sync_serial & 1;
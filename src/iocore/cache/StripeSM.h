@@ -28,6 +28,7 @@
 #include "AggregateWriteBuffer.h"
 #include "PreservationTable.h"
 #include "Stripe.h"
+#include "WriteAheadMarker.h"
 
 #include "iocore/eventsystem/EThread.h"
 
@@ -77,6 +78,7 @@ public:
   Event *trigger = nullptr;
 
   OpenDir              open_dir;
+  WriteAheadMarker     write_ahead;
   RamCache            *ram_cache = nullptr;
   DLL<EvacuationBlock> lookaside[LOOKASIDE_SIZE];
   CacheEvacuateDocVC  *doc_evacuator = nullptr;
@@ -89,6 +91,7 @@ public:
   bool     recover_wrapped      = false;
   bool     dir_sync_waiting     = false;
   bool     dir_sync_in_progress = false;
+  size_t   dir_sync_last_bytes  = 0; // bytes written by the last directory sync
   bool     writing_end_marker   = false;
 
   CacheKey          first_fragment_key;
@@ -147,6 +150,18 @@ public:
    * @see aggWrite
    */
   void aggregate_pending_writes(Queue<CacheVC, Continuation::Link_link> &tocall);
+  /**
+   * Copy the pending writes into the aggregate write buffer while the
+   * previous buffer is being written to disk.
+   *
+   * This lets writers proceed without waiting for aggWriteDone. Nothing is
+   * done unless an aggregation write is in progress; the buffer is written
+   * once the write in progress is done.
+   *
+   * @return EVENT_RETURN if the calling writer was copied, otherwise EVENT_CONT.
+   * @see aggregate_pending_writes
+   */
+  int  aggregate_during_write(int event);
   void agg_wrap();
 
   int evacuateWrite(CacheEvacuateDocVC *evacuator, int event, Event *e);
@@ -156,7 +171,7 @@ public:
 
   int within_hit_evacuate_window(Dir const *dir) const;
 
-  StripeSM() : Continuation(new_ProxyMutex())
+  StripeSM() : Continuation(new_ProxyMutex("cache.stripe"))
   {
     open_dir.mutex = mutex;
     SET_HANDLER(&StripeSM::aggWrite);
@@ -223,9 +238,13 @@ public:
 private:
   mutable PreservationTable _preserved_dirs;
 
-  int _agg_copy(CacheVC *vc);
-  int _copy_writer_to_aggregation(CacheVC *vc);
-  int _copy_evacuator_to_aggregation(CacheVC *vc);
+  void     _read_dir(off_t offset);
+  void     _read_dir_chunk(AIOCallback *aio);
+  int      _agg_copy(CacheVC *vc);
+  int      _copy_writer_to_aggregation(CacheVC *vc);
+  int      _copy_evacuator_to_aggregation(CacheVC *vc);
+  int      _call_aggregated_writers(int event, Queue<CacheVC, Continuation::Link_link> &tocall);
+  uint32_t _agg_write_serial() const;
 };
 
 // Global Data
@@ -264,6 +283,15 @@ StripeSM::set_io_not_in_progress()
   io.aiocb.aio_fildes = AIO_NOT_IN_PROGRESS;
 }
 
+/* Documents in the buffer filled during an aggregation write are written
+   after it, so they get the serial the header will have by then.
+ */
+inline uint32_t
+StripeSM::_agg_write_serial() const
+{
+  return header->write_serial + (this->_write_buffer.is_flushing() ? 1 : 0);
+}
+
 inline Queue<CacheVC, Continuation::Link_link> &
 StripeSM::get_pending_writers()
 {
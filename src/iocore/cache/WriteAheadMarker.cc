@@ -0,0 +1,247 @@
+/** @file
+
+  Bound on the data written after the last directory sync of a stripe.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_CacheInternal.h"
+#include "P_CacheStats.h"
+#include "StripeSM.h"
+#include "WriteAheadMarker.h"
+
+#include "iocore/aio/AIO.h"
+
+#include "tsutil/DbgCtl.h"
+#include "tsutil/Metrics.h"
+
+#include "tscore/Diags.h"
+#include "tscore/ink_memory.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+namespace
+{
+
+DbgCtl dbg_ctl_cache_write_ahead{"cache_write_ahead"};
+
+int const FOOTER_LEN = ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
+
+} // namespace
+
+WriteAheadMarker::~WriteAheadMarker()
+{
+  for (auto &io : this->_io) {
+    io.action = nullptr;
+    io.mutex.clear();
+  }
+  if (this->_buf) {
+    ats_free(this->_buf);
+  }
+}
+
+void
+WriteAheadMarker::init(StripeSM *stripe, int64_t window)
+{
+  off_t data_len = stripe->skip + stripe->len - stripe->start;
+
+  this->_stripe = stripe;
+  this->mutex   = stripe->mutex;
+  // Each step must fit a whole aggregation write, and the range cleared on
+  // recovery is kept to a small part of the stripe.
+  this->_window = window > 0 ? std::max<off_t>(std::min<off_t>(ROUND_TO_STORE_BLOCK(window), data_len / 4), 2 * AGG_SIZE) : 0;
+  if (!this->enabled()) {
+    return;
+  }
+  if (!this->_buf) {
+    this->_buf = static_cast<char *>(ats_memalign(ats_pagesize(), 2 * FOOTER_LEN));
+    memset(this->_buf, 0, 2 * FOOTER_LEN);
+  }
+
+  this->_last        = stripe->header->write_pos;
+  this->_room        = 0;
+  this->_target_room = 0;
+  for (int c = 0; c < 2; c++) {
+    if (this->_known[c]) {
+      this->_advance[c] = stripe->write_distance(this->_footer[c].write_pos, this->_last);
+    }
+  }
+  Dbg(dbg_ctl_cache_write_ahead, "Stripe %s: window %" PRId64 " bytes", stripe->hash_text.get(),
+      static_cast<int64_t>(this->_window));
+}
+
+void
+WriteAheadMarker::set_footer(int copy, StripteHeaderFooter const &footer)
+{
+  this->_footer[copy] = footer;
+  this->_known[copy]  = true;
+}
+
+bool
+WriteAheadMarker::covers(off_t end)
+{
+  if (!this->enabled()) {
+    return true;
+  }
+  this->_track();
+
+  off_t need = this->_stripe->write_distance(this->_last, end);
+  if (!this->_writing && this->_room - need < this->_window / 2) {
+    this->_extend();
+  }
+  if (need <= this->_room) {
+    this->_waiting = false;
+    return true;
+  }
+  if (!this->_waiting) {
+    this->_waiting = true;
+    Metrics::Counter::increment(cache_rsb.write_ahead_stalls);
+    Metrics::Counter::increment(this->_stripe->cache_vol->vol_rsb.write_ahead_stalls);
+  }
+  return false;
+}
+
+void
+WriteAheadMarker::sync_footer(int copy, StripteHeaderFooter *footer)
+{
+  if (!this->enabled()) {
+    footer->write_ahead = 0;
+    return;
+  }
+  this->_track();
+
+  // The footers are not moved past this until the sync is done, so the
+  // writer is not held up unless the sync takes long.
+  this->_sync_room    = (this->_writing ? this->_target_room : this->_room) + this->_window;
+  this->_syncing      = true;
+  footer->write_ahead = this->_blocks(this->_stripe->write_distance(footer->write_pos, this->_last) + this->_sync_room);
+  Dbg(dbg_ctl_cache_write_ahead, "Stripe %s: sync of copy %d covers %u blocks", this->_stripe->hash_text.get(), copy,
+      footer->write_ahead);
+}
+
+void
+WriteAheadMarker::sync_done(int copy, StripteHeaderFooter const &footer)
+{
+  if (!this->enabled()) {
+    return;
+  }
+  this->_track();
+  this->set_footer(copy, footer);
+  this->_advance[copy] = this->_stripe->write_distance(footer.write_pos, this->_last);
+  this->_syncing       = false;
+  if (this->_waiting && !this->_writing && !this->_stripe->is_io_in_progress()) {
+    this->_stripe->aggWrite(EVENT_IMMEDIATE, nullptr);
+  }
+}
+
+int
+WriteAheadMarker::handle_write_done(int /* event ATS_UNUSED */, void *data)
+{
+  AIOCallback *op = static_cast<AIOCallback *>(data);
+
+  if (!op->ok()) {
+    Warning("unable to write directory footer of '%s'", this->_stripe->hash_text.get());
+    this->_stripe->disk->incrErrors(op);
+    this->_failed = true;
+  }
+  if (--this->_writing) {
+    return EVENT_DONE;
+  }
+  this->_track();
+  // After a failure the writer stays where it is until it is called again.
+  if (!this->_failed) {
+    this->_room = this->_target_room;
+    if (this->_waiting && !this->_stripe->is_io_in_progress()) {
+      this->_stripe->aggWrite(EVENT_IMMEDIATE, nullptr);
+    }
+  }
+  return EVENT_DONE;
+}
+
+/* Bring the distances up to date with the write position. It moves by at
+   most one aggregation write, and a wrap, between calls.
+ */
+void
+WriteAheadMarker::_track()
+{
+  off_t pos   = this->_stripe->header->write_pos;
+  off_t moved = this->_stripe->write_distance(this->_last, pos);
+
+  this->_last         = pos;
+  this->_room        -= moved;
+  this->_target_room -= moved;
+  this->_sync_room   -= moved;
+  for (auto &a : this->_advance) {
+    a += moved;
+  }
+}
+
+void
+WriteAheadMarker::_extend()
+{
+  // A sync waiting to start means the footer of the last one was not written.
+  if (this->_syncing && this->_stripe->dir_sync_waiting) {
+    this->_syncing = false;
+  }
+  off_t room = this->_syncing ? std::min(this->_window, this->_sync_room) : this->_window;
+  if (room <= this->_room) {
+    return;
+  }
+
+  int syncing = this->_stripe->dir_sync_in_progress ? static_cast<int>(this->_stripe->header->sync_serial & 1) : -1;
+  for (int c = 0; c < 2; c++) {
+    if (!this->_known[c] || c == syncing) {
+      continue;
+    }
+    this->_footer[c].write_ahead = this->_blocks(this->_advance[c] + room);
+    memcpy(this->_buf + c * FOOTER_LEN, &this->_footer[c], sizeof(StripteHeaderFooter));
+
+    AIOCallback *io      = &this->_io[c];
+    size_t       dirlen  = this->_stripe->dirlen();
+    io->aiocb.aio_fildes = this->_stripe->fd;
+    io->aiocb.aio_buf    = this->_buf + c * FOOTER_LEN;
+    io->aiocb.aio_nbytes = FOOTER_LEN;
+    io->aiocb.aio_offset = this->_stripe->skip + (c ? dirlen : 0) + dirlen - FOOTER_LEN;
+    io->action           = this;
+    io->thread           = AIO_CALLBACK_THREAD_ANY;
+    io->then             = nullptr;
+    ++this->_writing;
+    ink_assert(ink_aio_write(io));
+  }
+  this->_target_room = room;
+  this->_failed      = false;
+  if (!this->_writing) {
+    // The only copy on disk is being synced, the footer it writes will cover the writer.
+    this->_room = room;
+  } else {
+    Metrics::Counter::increment(cache_rsb.write_ahead_writes);
+    Metrics::Counter::increment(this->_stripe->cache_vol->vol_rsb.write_ahead_writes);
+  }
+}
+
+uint32_t
+WriteAheadMarker::_blocks(off_t ahead) const
+{
+  if (ahead >= this->_stripe->skip + this->_stripe->len - this->_stripe->start) {
+    return WRITE_AHEAD_ALL;
+  }
+  return std::max<off_t>(1, (ahead + STORE_BLOCK_SIZE - 1) / STORE_BLOCK_SIZE);
+}
@@ -0,0 +1,132 @@
+/** @file
+
+  Bound on the data written after the last directory sync of a stripe.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "P_CacheDir.h"
+#include "Stripe.h"
+
+#include "iocore/eventsystem/Continuation.h"
+
+#include <cstdint>
+
+class StripeSM;
+
+/// Value of StripteHeaderFooter::write_ahead when the whole stripe may have been written.
+#define WRITE_AHEAD_ALL UINT32_MAX
+
+/**
+ * Keeps the write_ahead of the directory footers on disk ahead of the
+ * aggregation writer.
+ *
+ * The footer of each directory copy records how many store blocks past its
+ * write_pos may have been written since the copy was synced. The writer does
+ * not write past the limit until the footers recording it are on disk, and
+ * the footers are moved ahead of the writer in steps of the recovery window.
+ * On startup the stripe then clears that range of the directory instead of
+ * scanning the data for documents written after the sync.
+ *
+ * The footer of the copy being synced is left to the sync, which sets its
+ * write_ahead with sync_footer().
+ *
+ * This class is not safe for concurrent access. It shares the stripe mutex.
+ *
+ * @see StripeSM::handle_recover_from_data
+ */
+class WriteAheadMarker : public Continuation
+{
+public:
+  WriteAheadMarker() : Continuation(nullptr) { SET_HANDLER(&WriteAheadMarker::handle_write_done); }
+  ~WriteAheadMarker() override;
+
+  /**
+   * Start bounding the writes of @a stripe.
+   *
+   * The footers of the copies on disk must have been given with set_footer().
+   *
+   * @param stripe The stripe, with its directory loaded.
+   * @param window The distance to keep the footers ahead of the writer, 0 to
+   *     leave the footers alone.
+   */
+  void init(StripeSM *stripe, int64_t window);
+
+  bool
+  enabled() const
+  {
+    return this->_window > 0;
+  }
+
+  /**
+   * Record the footer of directory copy @a copy as it is on disk.
+   */
+  void set_footer(int copy, StripteHeaderFooter const &footer);
+
+  /**
+   * Check whether the writer may write up to @a end.
+   *
+   * Starts moving the footers ahead when the writer gets close to the limit.
+   * If this returns false, the stripe's aggWrite is called again once the
+   * footers are written.
+   *
+   * @param end The end of the write, not past the end of the stripe.
+   * @return Returns true if the write is covered by the footers on disk.
+   */
+  bool covers(off_t end);
+
+  /**
+   * Set the write_ahead of @a footer, about to be written by the directory
+   * sync to copy @a copy, to cover everything the writer may write until the
+   * sync is done.
+   */
+  void sync_footer(int copy, StripteHeaderFooter *footer);
+
+  /**
+   * The directory sync wrote @a footer to copy @a copy.
+   */
+  void sync_done(int copy, StripteHeaderFooter const &footer);
+
+  int handle_write_done(int event, void *data);
+
+private:
+  StripeSM *_stripe      = nullptr;
+  off_t     _window      = 0;
+  off_t     _room        = 0; ///< Bytes the writer may move past the write position.
+  off_t     _target_room = 0; ///< The room once the footers being written are on disk.
+  off_t     _sync_room   = 0; ///< The room covered by the footer the sync is writing.
+  off_t     _last        = 0; ///< Write position the distances are relative to.
+  int       _writing{};       ///< Footer writes in progress.
+  bool      _failed{};        ///< A footer write in progress failed.
+  bool      _waiting{};       ///< The writer is waiting for the footers.
+  bool      _syncing{};       ///< The sync is writing a footer.
+
+  StripteHeaderFooter _footer[2]{};
+  bool                _known[2]{};
+  off_t               _advance[2]{}; ///< Bytes the writer moved since the write_pos of each footer.
+
+  char               *_buf = nullptr;
+  AIOCallbackInternal _io[2];
+
+  void     _track();
+  void     _extend();
+  uint32_t _blocks(off_t ahead) const;
+};
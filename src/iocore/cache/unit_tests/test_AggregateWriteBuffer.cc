@@ -50,3 +50,44 @@ TEST_CASE("Given 10 bytes are pending to the buffer, "
   write_buffer.emplace(10);
   CHECK(0 == write_buffer.get_bytes_pending_aggregation());
 }
+
+TEST_CASE("Given a buffer is being flushed, "
+          "when we emplace a document, "
+          "then it should be copied into the other buffer.")
+{
+  AggregateWriteBuffer write_buffer;
+  Doc                 *first = write_buffer.emplace(512);
+  first->magic               = DOC_MAGIC;
+  first->len                 = sizeof(Doc);
+
+  char const *filled = write_buffer.get_buffer();
+  write_buffer.begin_flush();
+  CHECK(write_buffer.is_flushing());
+  CHECK(write_buffer.is_empty());
+  CHECK(512 == write_buffer.get_flush_len());
+  CHECK(filled == write_buffer.get_flush_buffer());
+
+  Doc *second   = write_buffer.emplace(1024);
+  second->magic = DOC_MAGIC;
+  second->len   = 2 * sizeof(Doc);
+  CHECK(reinterpret_cast<char *>(second) != write_buffer.get_flush_buffer());
+  CHECK(1024 == write_buffer.get_buffer_pos());
+
+  SECTION("then copy_from should address the buffers back to back.")
+  {
+    Doc doc;
+    write_buffer.copy_from(reinterpret_cast<char *>(&doc), 0, sizeof(Doc));
+    CHECK(sizeof(Doc) == doc.len);
+    write_buffer.copy_from(reinterpret_cast<char *>(&doc), 512, sizeof(Doc));
+    CHECK(2 * sizeof(Doc) == doc.len);
+  }
+
+  SECTION("then ending the flush should leave only the new document.")
+  {
+    write_buffer.end_flush();
+    CHECK(!write_buffer.is_flushing());
+    Doc doc;
+    write_buffer.copy_from(reinterpret_cast<char *>(&doc), 0, sizeof(Doc));
+    CHECK(2 * sizeof(Doc) == doc.len);
+  }
+}
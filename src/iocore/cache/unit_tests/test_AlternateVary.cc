@@ -0,0 +1,225 @@
+/** @file
+
+  Test selection of alternates by their Vary fingerprint
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "iocore/cache/HttpTransactCache.h"
+
+#include <string>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+
+class TestConfigAccessor : public HttpConfigAccessor
+{
+public:
+  int8_t
+  get_ignore_accept_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_charset_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_encoding_mismatch() const override
+  {
+    return 0;
+  }
+  int8_t
+  get_ignore_accept_language_mismatch() const override
+  {
+    return 0;
+  }
+  const char *
+  get_global_user_agent_header() const override
+  {
+    return nullptr;
+  }
+};
+
+void
+parse_request(HTTPHdr &req, std::string const &text)
+{
+  HTTPParser  parser;
+  const char *start = text.data();
+
+  req.create(HTTP_TYPE_REQUEST);
+  http_parser_init(&parser);
+  REQUIRE(req.parse_req(&parser, &start, text.data() + text.size(), true) == PARSE_RESULT_DONE);
+  http_parser_clear(&parser);
+}
+
+void
+parse_response(HTTPHdr &resp, std::string const &text)
+{
+  HTTPParser  parser;
+  const char *start = text.data();
+
+  resp.create(HTTP_TYPE_RESPONSE);
+  http_parser_init(&parser);
+  REQUIRE(resp.parse_resp(&parser, &start, text.data() + text.size(), true) == PARSE_RESULT_DONE);
+  http_parser_clear(&parser);
+}
+
+std::string
+request_text(const char *accept_language)
+{
+  std::string text = "GET http://www.example.com/vary HTTP/1.1\r\n";
+  if (accept_language) {
+    text += "Accept-Language: ";
+    text += accept_language;
+    text += "\r\n";
+  }
+  return text + "\r\n";
+}
+
+std::string
+response_text(const char *vary, const char *content_language, const char *content_type = "text/plain")
+{
+  std::string text = "HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\n";
+  text            += "Vary: ";
+  text            += vary;
+  text            += "\r\nContent-Language: ";
+  text            += content_language;
+  text            += "\r\nContent-Type: ";
+  text            += content_type;
+  return text + "\r\n\r\n";
+}
+
+/// Fingerprint a request with @a accept_language for a response with @a vary.
+uint32_t
+fingerprint(const char *accept_language, const char *vary = "Accept-Language")
+{
+  HTTPHdr req;
+  HTTPHdr resp;
+
+  parse_request(req, request_text(accept_language));
+  parse_response(resp, response_text(vary, "en"));
+  uint32_t result = HttpTransactCache::calculate_vary_fingerprint(&req, &resp);
+  req.destroy();
+  resp.destroy();
+  return result;
+}
+
+/// Add an alternate written for a request with @a accept_language to @a vector.
+void
+add_alternate(CacheHTTPInfoVector &vector, const char *accept_language, const char *content_language)
+{
+  HTTPInfo   info;
+  HTTPHdr    req;
+  HTTPHdr    resp;
+  CryptoHash key;
+
+  parse_request(req, request_text(accept_language));
+  parse_response(resp, response_text("Accept-Language", content_language));
+  info.create();
+  info.request_set(&req);
+  info.response_set(&resp);
+  req.destroy();
+  resp.destroy();
+
+  key.u64[0] = vector.count() + 1;
+  key.u64[1] = 0;
+  info.object_key_set(key);
+  info.vary_fingerprint_set(HttpTransactCache::calculate_alternate_vary_fingerprint(info.request_get(), info.response_get()));
+  vector.insert(&info);
+}
+
+int
+select(CacheHTTPInfoVector &vector, const char *accept_language)
+{
+  TestConfigAccessor config;
+  HTTPHdr            req;
+
+  parse_request(req, request_text(accept_language));
+  int index = HttpTransactCache::SelectFromAlternates(&vector, &req, &config);
+  req.destroy();
+  return index;
+}
+
+} // namespace
+
+TEST_CASE("Vary fingerprint")
+{
+  http_init();
+
+  // Values compare as the Vary match does, without case or whitespace around the commas.
+  CHECK(fingerprint("en-US, fr") == fingerprint("EN-us,fr"));
+  CHECK(fingerprint("en-US, fr") != fingerprint("fr, en-US"));
+  CHECK(fingerprint("en") != fingerprint("fr"));
+  // A missing header differs from an empty one.
+  CHECK(fingerprint(nullptr) != fingerprint(""));
+  CHECK(fingerprint("en") != HTTPCacheAlt::NO_VARY_FINGERPRINT);
+  CHECK(fingerprint("en", "Accept-Language, *") == HTTPCacheAlt::NO_VARY_FINGERPRINT);
+}
+
+TEST_CASE("Select alternates by Vary fingerprint")
+{
+  http_init();
+
+  CacheHTTPInfoVector vector;
+
+  add_alternate(vector, "en", "en");
+  add_alternate(vector, "fr", "fr");
+  add_alternate(vector, "de, fr;q=0.5", "de");
+
+  for (int i = 0; i < vector.count(); ++i) {
+    CHECK(vector.get(i)->vary_fingerprint_get() != HTTPCacheAlt::NO_VARY_FINGERPRINT);
+  }
+
+  CHECK(select(vector, "en") == 0);
+  CHECK(select(vector, "FR") == 1);
+  CHECK(select(vector, "de,fr;q=0.5") == 2);
+
+  // Each alternate varies from these.
+  CHECK(select(vector, "de") == -1);
+  CHECK(select(vector, nullptr) == -1);
+
+  vector.clear();
+}
+
+TEST_CASE("Alternates not selected by Vary fingerprint")
+{
+  http_init();
+
+  HTTPHdr req;
+  HTTPHdr resp;
+
+  // The request an alternate was written for does not accept its type.
+  parse_request(req, "GET http://www.example.com/vary HTTP/1.1\r\nAccept: image/png\r\nAccept-Language: fr\r\n\r\n");
+  parse_response(resp, response_text("Accept-Language", "fr", "text/html"));
+  CHECK(HttpTransactCache::calculate_alternate_vary_fingerprint(&req, &resp) == HTTPCacheAlt::NO_VARY_FINGERPRINT);
+  resp.destroy();
+
+  parse_response(resp, response_text("*", "fr"));
+  CHECK(HttpTransactCache::calculate_alternate_vary_fingerprint(&req, &resp) == HTTPCacheAlt::NO_VARY_FINGERPRINT);
+  resp.destroy();
+  req.destroy();
+}
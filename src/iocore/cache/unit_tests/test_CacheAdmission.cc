@@ -0,0 +1,128 @@
+/** @file
+
+  Test admission of cache writes by how often their objects are requested
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../CacheAdmission.h"
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+
+CacheKey
+make_key(uint64_t n)
+{
+  CacheKey key;
+  uint64_t x = n * 0x9E3779B97F4A7C15ULL;
+
+  // splitmix64, so the keys look like the hashes they stand for.
+  for (auto &half : key.u64) {
+    x    += 0x9E3779B97F4A7C15ULL;
+    half  = x;
+    half  = (half ^ (half >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    half  = (half ^ (half >> 27)) * 0x94D049BB133111EBULL;
+    half ^= half >> 31;
+  }
+  return key;
+}
+
+} // namespace
+
+TEST_CASE("CacheAdmission min requests")
+{
+  CacheAdmission filter(1024);
+  CacheKey       key = make_key(1);
+
+  CHECK_FALSE(filter.admit(key, 3));
+  CHECK(filter.rejected(key, 3));
+  CHECK_FALSE(filter.admit(key, 3));
+  CHECK(filter.rejected(key, 3));
+  CHECK(filter.admit(key, 3));
+  CHECK_FALSE(filter.rejected(key, 3));
+
+  key = make_key(2);
+  CHECK_FALSE(filter.rejected(key, 2));
+  CHECK_FALSE(filter.admit(key, 2));
+  CHECK(filter.admit(key, 2));
+
+  key = make_key(3);
+  CHECK(filter.admit(key, 1));
+  CHECK_FALSE(filter.rejected(key, 1));
+}
+
+TEST_CASE("CacheAdmission counts saturate")
+{
+  CacheAdmission filter(1024);
+  CacheKey       key = make_key(1);
+
+  for (int i = 0; i < 2 * CacheAdmission::MAX_COUNT; ++i) {
+    filter.admit(key, 2);
+  }
+  CHECK(filter.admit(key, CacheAdmission::MAX_COUNT + 1));
+  CHECK_FALSE(filter.rejected(key, CacheAdmission::MAX_COUNT + 1));
+}
+
+TEST_CASE("CacheAdmission one hit wonders")
+{
+  CacheAdmission filter(4096);
+  int            admitted = 0;
+
+  // Keys requested once are rejected, but for the false positives of the doorkeeper.
+  for (uint64_t n = 0; n < 2048; ++n) {
+    admitted += filter.admit(make_key(n), 2);
+  }
+  CHECK(admitted < 2048 / 20);
+
+  // While keys requested again are admitted.
+  admitted = 0;
+  for (uint64_t n = 0; n < 1024; ++n) {
+    admitted += filter.admit(make_key(n), 2);
+  }
+  CHECK(admitted == 1024);
+}
+
+TEST_CASE("CacheAdmission aging")
+{
+  CacheAdmission filter(1024);
+  CacheKey       key = make_key(0);
+
+  CHECK_FALSE(filter.admit(key, 2));
+  // A full sample of other requests ages the first one out.
+  for (uint64_t n = 1; n < 1024; ++n) {
+    filter.admit(make_key(n), 2);
+  }
+  CHECK_FALSE(filter.rejected(key, 2));
+  CHECK_FALSE(filter.admit(key, 2));
+
+  // Frequent keys keep half their count.
+  for (int i = 0; i < 8; ++i) {
+    filter.admit(key, 2);
+  }
+  for (uint64_t n = 1; n < 1024; ++n) {
+    filter.admit(make_key(1024 + n), 2);
+  }
+  CHECK(filter.admit(key, 5));
+}
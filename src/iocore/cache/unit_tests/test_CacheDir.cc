@@ -102,6 +102,41 @@ public:
     CacheKey key;
     rand_CacheKey(&key);
 
+    // test incremental sync
+    {
+      size_t            dirlen    = stripe->dirlen();
+      size_t            fixed_len = stripe->headerlen() + ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
+      char             *buf       = static_cast<char *>(ats_memalign(ats_pagesize(), dirlen));
+      std::vector<bool> pages;
+
+      // a cleared directory has to be written in full to both copies
+      CHECK(stripe->copy_dirty_dir(0, buf, pages) == dirlen);
+      CHECK(memcmp(buf, stripe->raw_dir, dirlen) == 0);
+      CHECK(stripe->copy_dirty_dir(0, buf, pages) == fixed_len);
+
+      dir_insert(&key, stripe, &dir);
+      Dir *last_collision = nullptr;
+      Dir  found;
+      REQUIRE(dir_probe(&key, stripe, &found, &last_collision));
+      size_t entry = reinterpret_cast<char *>(last_collision) - stripe->raw_dir;
+
+      size_t copied = stripe->copy_dirty_dir(0, buf, pages);
+      CHECK(copied > fixed_len);
+      CHECK(copied < dirlen);
+      CHECK(pages[entry / STORE_BLOCK_SIZE]);
+      CHECK(memcmp(buf + entry, last_collision, SIZEOF_DIR) == 0);
+      CHECK(stripe->copy_dirty_dir(0, buf, pages) == fixed_len);
+
+      // the other copy has not been written at all yet
+      CHECK(stripe->copy_dirty_dir(1, buf, pages) == dirlen);
+      CHECK(stripe->copy_dirty_dir(1, buf, pages) == fixed_len);
+
+      dir_delete(&key, stripe, &found);
+      CHECK(stripe->copy_dirty_dir(1, buf, pages) > fixed_len);
+      CHECK(pages[entry / STORE_BLOCK_SIZE]);
+      ats_free(buf);
+    }
+
     int  s   = key.slice32(0) % stripe->segments, i, j;
     Dir *seg = stripe->dir_segment(s);
 
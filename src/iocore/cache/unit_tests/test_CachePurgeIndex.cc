@@ -0,0 +1,224 @@
+/** @file
+
+  Test purges through the cache purge index
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../CachePurgeIndex.h"
+#include "../P_CacheDir.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define SMALL_FILE 10 * 1024
+
+#define PURGED_URL "http://www.scw11.com/purge/a"
+#define KEPT_URL   "http://www.scw11.com/keep/b"
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+
+CryptoHash
+make_key(unsigned i)
+{
+  CryptoHash key;
+  key.u64[0] = i;
+  key.u64[1] = ~static_cast<uint64_t>(i);
+  return key;
+}
+
+CryptoHash
+url_cache_key(const char *url)
+{
+  HTTPInfo info;
+  info.create();
+  build_hdrs(info, url);
+  CryptoHash key = generate_key(info).hash;
+  info.destroy();
+  return key;
+}
+
+bool
+in_directory(CryptoHash const &key)
+{
+  StripeSM *stripe = theCache->key_to_stripe(&key, "www.scw11.com", sizeof("www.scw11.com") - 1);
+  Dir       dir;
+  Dir      *last_collision = nullptr;
+
+  SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+  return dir_probe(&key, stripe, &dir, &last_collision);
+}
+
+} // namespace
+
+TEST_CASE("url keys")
+{
+  CHECK(CachePurgeIndex::url_key("http://WWW.Example.com:8080/A/b?c=D") == "www.example.com/A/b?c=D");
+  CHECK(CachePurgeIndex::url_key("https://example.com") == "example.com");
+  CHECK(CachePurgeIndex::url_key("example.com/a") == "example.com/a");
+  CHECK(CachePurgeIndex::url_key("example.com/a://b") == "example.com/a://b");
+  CHECK(CachePurgeIndex::url_host("example.com/a/b") == "example.com");
+}
+
+TEST_CASE("purge index")
+{
+  CachePurgeIndex                    index{1000};
+  std::vector<CachePurgeIndex::Item> items;
+
+  for (unsigned i = 0; i < 100; ++i) {
+    std::string url = "example.com/" + std::string(i % 2 ? "odd/" : "even/") + std::to_string(i);
+    index.insert(make_key(i), url, i % 10 ? "all, some" : "all ten");
+  }
+  REQUIRE(index.size() == 100);
+
+  SECTION("surrogate key")
+  {
+    CHECK(index.remove_tag("ten", items) == 10);
+    CHECK(items.size() == 10);
+    CHECK(index.remove_tag("ten", items) == 0);
+    CHECK(index.remove_tag("some", items) == 90);
+    CHECK(index.size() == 0);
+    CHECK(index.remove_tag("all", items) == 0);
+  }
+
+  SECTION("url prefix")
+  {
+    CHECK(index.remove_prefix("example.com/odd/", items) == 50);
+    for (auto const &item : items) {
+      CHECK(item.url.starts_with("example.com/odd/"));
+    }
+    CHECK(index.remove_tag("all", items) == 50);
+    CHECK(index.size() == 0);
+  }
+
+  SECTION("surrogate keys of alternates are merged")
+  {
+    index.insert(make_key(1), "example.com/moved", "other");
+    CHECK(index.size() == 100);
+    CHECK(index.remove_prefix("example.com/odd/1", items) == 5);
+    CHECK(index.remove_tag("other", items) == 1);
+    CHECK(items.back().url == "example.com/moved");
+  }
+
+  SECTION("save and load")
+  {
+    std::string path = (std::filesystem::temp_directory_path() / "test_CachePurgeIndex.txt").string();
+    REQUIRE(index.save(path));
+
+    CachePurgeIndex loaded{1000};
+    CHECK(loaded.load(path) == 100);
+    CHECK(loaded.size() == 100);
+    CHECK(loaded.remove_tag("ten", items) == 10);
+    CHECK(loaded.remove_prefix("example.com/even/", items) == 40);
+    std::remove(path.c_str());
+
+    CHECK(loaded.load(path) == -1);
+  }
+}
+
+TEST_CASE("purge index is bounded")
+{
+  CachePurgeIndex                    index{64};
+  std::vector<CachePurgeIndex::Item> items;
+
+  // One shard, the first indexed go first.
+  for (unsigned i = 0; i < 10; ++i) {
+    index.insert(make_key(i * 64), "example.com/" + std::to_string(i), "tag");
+  }
+  CHECK(index.size() == 1);
+  CHECK(index.remove_tag("tag", items) == 1);
+  CHECK(items.back().url == "example.com/9");
+}
+
+class PurgeCheck : public TestContChain
+{
+public:
+  PurgeCheck() { SET_HANDLER(&PurgeCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CryptoHash       purged = url_cache_key(PURGED_URL);
+    CryptoHash       kept   = url_cache_key(KEPT_URL);
+    CachePurgeResult result;
+
+    // Both writes were indexed as they closed.
+    CHECK(cache_purge_index->size() == 2);
+    REQUIRE(in_directory(purged));
+    REQUIRE(in_directory(kept));
+
+    REQUIRE(cacheProcessor.purge_url_prefix("http://WWW.scw11.com/purge/", result));
+    CHECK(result.indexed == 1);
+    CHECK(result.purged == 1);
+    CHECK(!in_directory(purged));
+    CHECK(in_directory(kept));
+
+    cache_purge_index->insert(kept, CachePurgeIndex::url_key(KEPT_URL), "group");
+    result = {};
+    REQUIRE(cacheProcessor.purge_surrogate_key("group", result));
+    CHECK(result.indexed == 1);
+    CHECK(result.purged == 1);
+    CHECK(!in_directory(kept));
+    CHECK(cache_purge_index->size() == 0);
+
+    CHECK(Metrics::Counter::load(cache_rsb.purge_requests) == 2);
+    CHECK(Metrics::Counter::load(cache_rsb.purge_objects) == 2);
+
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+class CachePurgeInit : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    CacheTestHandler *h  = new CacheTestHandler(SMALL_FILE, PURGED_URL);
+    CacheTestHandler *h2 = new CacheTestHandler(SMALL_FILE, KEPT_URL);
+    TerminalTest     *tt = new TerminalTest;
+    h->add(h2);
+    h->add(new PurgeCheck);
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("purge cached objects")
+{
+  cache_purge_index = new CachePurgeIndex(1000);
+  init_cache(256 * 1024 * 1024);
+
+  CachePurgeInit *init = new CachePurgeInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -0,0 +1,317 @@
+/** @file
+
+  Unit tests for reading and recovering stripe directories on startup.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheDir.h"
+#include "../P_CacheDoc.h"
+#include "../StripeSM.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+extern void register_cache_stats(CacheStatsBlock *rsb, const std::string prefix);
+
+namespace
+{
+
+/* A layout of stripes of different sizes on one file. The directory of the
+   first is recovered by scanning the data, the second has a write ahead
+   marker and the marker of the third covers the whole stripe.
+ */
+constexpr int   STRIPES                = 3;
+constexpr off_t STRIPE_BLOCKS[STRIPES] = {STORE_BLOCKS_PER_STRIPE, 2 * STORE_BLOCKS_PER_STRIPE, STORE_BLOCKS_PER_STRIPE};
+constexpr int   ENTRIES                = 64;
+constexpr off_t WINDOW                 = 16 * 1024 * 1024;
+
+enum Place { BEHIND, NEAR, FAR, PLACES };
+
+struct Keys {
+  std::vector<CacheKey> at[PLACES];
+};
+
+void
+insert_entries(StripeSM *stripe, Keys &keys)
+{
+  off_t data_len = stripe->skip + stripe->len - stripe->start;
+  Dir   dir;
+
+  for (int p = 0; p < PLACES; p++) {
+    for (int i = 0; i < ENTRIES; i++) {
+      off_t pos = 0;
+      switch (p) {
+      case BEHIND:
+        pos = stripe->start + i * CACHE_BLOCK_SIZE * 16;
+        break;
+      case NEAR:
+        pos = stripe->header->write_pos + AGG_SIZE / 2 + i * CACHE_BLOCK_SIZE;
+        break;
+      default:
+        pos = stripe->header->write_pos + data_len / 4 + i * CACHE_BLOCK_SIZE;
+        break;
+      }
+      CacheKey key;
+      rand_CacheKey(&key);
+      dir_clear(&dir);
+      // Data past the write position is from the previous cycle.
+      dir_set_phase(&dir, p == BEHIND ? stripe->header->phase : !stripe->header->phase);
+      dir_set_head(&dir, true);
+      dir_set_offset(&dir, stripe->offset_to_vol_offset(pos));
+      REQUIRE(dir_insert(&key, stripe, &dir));
+      keys.at[p].push_back(key);
+    }
+  }
+}
+
+int
+count_found(StripeSM *stripe, std::vector<CacheKey> const &keys)
+{
+  int n = 0;
+  for (auto const &key : keys) {
+    Dir  dir;
+    Dir *last_collision = nullptr;
+    n                  += dir_probe(&key, stripe, &dir, &last_collision) ? 1 : 0;
+  }
+  return n;
+}
+
+// Write the directory to the copy the next sync would, as the sync does.
+void
+write_dir_copy(StripeSM *stripe)
+{
+  size_t dirlen = stripe->dirlen();
+
+  stripe->header->sync_serial++;
+  stripe->footer->sync_serial = stripe->header->sync_serial;
+  off_t copy                  = stripe->header->sync_serial & 1;
+  REQUIRE(pwrite(stripe->fd, stripe->raw_dir, dirlen, stripe->skip + copy * dirlen) == static_cast<ssize_t>(dirlen));
+}
+
+StripteHeaderFooter
+read_footer(StripeSM *stripe, int copy)
+{
+  size_t              dirlen = stripe->dirlen();
+  StripteHeaderFooter footer;
+  off_t               pos = stripe->skip + copy * dirlen + dirlen - ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
+  REQUIRE(pread(stripe->fd, &footer, sizeof(footer), pos) == sizeof(footer));
+  return footer;
+}
+
+} // namespace
+
+class CacheStartupTest : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    REQUIRE(CacheProcessor::IsCacheEnabled() == CACHE_INITIALIZED);
+
+    _file = std::tmpfile();
+    REQUIRE(_file != nullptr);
+    _disk.hw_sector_size = STORE_BLOCK_SIZE;
+    register_cache_stats(&_vol.vol_rsb, "unit_test.startup");
+    // Never the last volume, so the test cache is not opened.
+    _cache.cache_read_done = 1;
+    _cache.total_nvol      = 1000;
+
+    // Room for the stripes of both phases after the stripes of the cache.
+    _saved_stripes  = gstripes;
+    _saved_nstripes = gnstripes;
+    _stripes.reset(new StripeSM *[_saved_nstripes + 2 * STRIPES]());
+    std::copy(gstripes, gstripes + _saved_nstripes, _stripes.get());
+    gstripes = _stripes.get();
+
+    this->_open(true);
+    SET_HANDLER(&CacheStartupTest::populate);
+    this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+    return EVENT_DONE;
+  }
+
+  int
+  populate(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    if (_cache.total_initialized_vol < STRIPES) {
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+      return EVENT_CONT;
+    }
+
+    for (int i = 0; i < STRIPES; i++) {
+      StripeSM *stripe = _stripe[i];
+      SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+
+      off_t data_len               = stripe->skip + stripe->len - stripe->start;
+      stripe->header->write_serial = 10;
+      stripe->header->write_pos    = ROUND_TO_STORE_BLOCK(stripe->start + data_len / 2);
+      stripe->header->agg_pos      = stripe->header->write_pos;
+      stripe->header->dirty        = 1;
+      insert_entries(stripe, _keys[i]);
+
+      if (i == 0) {
+        // The scan checks the write before the sync, and stops at the first
+        // document that was not written after it.
+        Doc doc;
+        memset(static_cast<void *>(&doc), 0, sizeof(doc));
+        doc.magic                      = DOC_MAGIC;
+        doc.len                        = 64 * 1024;
+        doc.write_serial               = stripe->header->write_serial;
+        doc.sync_serial                = stripe->header->sync_serial + 1;
+        stripe->header->last_write_pos = stripe->header->write_pos - stripe->round_to_approx_size(doc.len);
+        REQUIRE(pwrite(stripe->fd, &doc, sizeof(doc), stripe->header->last_write_pos) == sizeof(doc));
+        stripe->footer->write_ahead = 0;
+      } else {
+        stripe->header->last_write_pos = stripe->header->write_pos;
+        stripe->footer->write_ahead    = i == 1 ? WINDOW / STORE_BLOCK_SIZE : WRITE_AHEAD_ALL;
+      }
+      write_dir_copy(stripe);
+    }
+
+    // Read the directories back in many small pieces.
+    cache_config_dir_read_size       = 64 * 1024;
+    cache_config_dir_recovery_window = WINDOW;
+    _dir_read_time                   = Metrics::Counter::load(_vol.vol_rsb.init_dir_read_time);
+    this->_open(false);
+    SET_HANDLER(&CacheStartupTest::recovered);
+    this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+    return EVENT_CONT;
+  }
+
+  int
+  recovered(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    if (_cache.total_initialized_vol < 2 * STRIPES) {
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+      return EVENT_CONT;
+    }
+    CHECK(_cache.total_good_nvol == 2 * STRIPES);
+    CHECK(Metrics::Counter::load(_vol.vol_rsb.init_dir_read_time) > _dir_read_time);
+
+    {
+      StripeSM *stripe = _stripe[0];
+      SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+      // The scan clears an evacuation size past the last document.
+      CHECK(count_found(stripe, _keys[0].at[BEHIND]) == ENTRIES);
+      CHECK(count_found(stripe, _keys[0].at[NEAR]) == 0);
+      CHECK(count_found(stripe, _keys[0].at[FAR]) == ENTRIES);
+      CHECK(Metrics::Counter::load(_vol.vol_rsb.init_recover_bytes) > 0);
+    }
+    {
+      StripeSM *stripe = _stripe[1];
+      SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+      // The window is cleared without reading any data.
+      CHECK(count_found(stripe, _keys[1].at[BEHIND]) == ENTRIES);
+      CHECK(count_found(stripe, _keys[1].at[NEAR]) == 0);
+      CHECK(count_found(stripe, _keys[1].at[FAR]) == ENTRIES);
+      CHECK(stripe->footer->write_ahead == 0);
+      CHECK(stripe->header->sync_serial > 1);
+      CHECK((stripe->header->sync_serial & 1) == 0);
+    }
+    {
+      StripeSM *stripe = _stripe[2];
+      SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+      // Everything may have been overwritten.
+      CHECK(count_found(stripe, _keys[2].at[BEHIND]) == 0);
+      CHECK(count_found(stripe, _keys[2].at[FAR]) == 0);
+      CHECK(stripe->header->write_pos == stripe->start);
+    }
+
+    SET_HANDLER(&CacheStartupTest::marker);
+    return this->marker(EVENT_IMMEDIATE, nullptr);
+  }
+
+  int
+  marker(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    StripeSM *stripe = _stripe[1];
+    SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+    REQUIRE(stripe->write_ahead.enabled());
+
+    // The first write waits for the footers to cover it.
+    off_t end = stripe->header->write_pos + AGG_SIZE;
+    if (!stripe->write_ahead.covers(end)) {
+      CHECK(++_marker_tries < 500);
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+      return EVENT_CONT;
+    }
+    CHECK(_marker_tries > 0);
+    CHECK(Metrics::Counter::load(_vol.vol_rsb.write_ahead_writes) > 0);
+    for (int copy = 0; copy < 2; copy++) {
+      StripteHeaderFooter footer = read_footer(stripe, copy);
+      INFO("copy " << copy);
+      CHECK(footer.write_ahead != 0);
+      CHECK(static_cast<off_t>(footer.write_ahead) * STORE_BLOCK_SIZE >= stripe->write_distance(footer.write_pos, end));
+    }
+
+    gstripes  = _saved_stripes;
+    gnstripes = _saved_nstripes;
+    test_done();
+    return EVENT_DONE;
+  }
+
+private:
+  void
+  _open(bool clear)
+  {
+    off_t skip = START_POS;
+    for (int i = 0; i < STRIPES; i++) {
+      _stripe[i]            = new StripeSM();
+      _stripe[i]->disk      = &_disk;
+      _stripe[i]->fd        = fileno(_file);
+      _stripe[i]->cache     = &_cache;
+      _stripe[i]->cache_vol = &_vol;
+      _stripe[i]->init(const_cast<char *>("startup_test"), STRIPE_BLOCKS[i], skip, clear);
+      skip += STRIPE_BLOCKS[i] * STORE_BLOCK_SIZE;
+    }
+  }
+
+  std::FILE                    *_file = nullptr;
+  CacheDisk                     _disk;
+  CacheVol                      _vol;
+  Cache                         _cache;
+  StripeSM                     *_stripe[STRIPES] = {};
+  Keys                          _keys[STRIPES];
+  std::unique_ptr<StripeSM *[]> _stripes;
+  StripeSM                    **_saved_stripes  = nullptr;
+  int                           _saved_nstripes = 0;
+  int64_t                       _dir_read_time  = 0;
+  int                           _marker_tries   = 0;
+};
+
+TEST_CASE("CacheStartup")
+{
+  init_cache(0);
+
+  CacheStartupTest *init = new CacheStartupTest;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+
+  return;
+}
@@ -0,0 +1,227 @@
+/** @file
+
+  Test copies of cached objects between the storage tiers
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheDir.h"
+#include "../P_CacheDisk.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#define LARGE_FILE 3 * 1024 * 1024
+
+#define TIER_URL  "http://www.scw11.com/tier"
+#define TIER_HOST "www.scw11.com"
+
+// Required by main.h
+int  cache_vols           = 2;
+bool reuse_existing_cache = false;
+
+namespace
+{
+
+CryptoHash
+url_cache_key(const char *url)
+{
+  HTTPInfo info;
+  info.create();
+  build_hdrs(info, url);
+  CryptoHash key = generate_key(info).hash;
+  info.destroy();
+  return key;
+}
+
+bool
+in_directory(StripeSM *stripe, CryptoHash const &key)
+{
+  Dir  dir;
+  Dir *last_collision = nullptr;
+
+  SCOPED_MUTEX_LOCK(lock, stripe->mutex, this_ethread());
+  return dir_probe(&key, stripe, &dir, &last_collision);
+}
+
+StripeSM *
+fast_stripe(CryptoHash const &key)
+{
+  return theCache->key_to_fast_stripe(&key, TIER_HOST, sizeof(TIER_HOST) - 1);
+}
+
+StripeSM *
+slow_stripe(CryptoHash const &key)
+{
+  return theCache->key_to_stripe(&key, TIER_HOST, sizeof(TIER_HOST) - 1);
+}
+
+} // namespace
+
+class CacheReadAgain : public CacheTestHandler
+{
+public:
+  CacheReadAgain(size_t size, const char *url) : CacheTestHandler()
+  {
+    this->_rt        = new CacheReadTest(size, this, url);
+    this->_rt->mutex = this->mutex;
+
+    SET_HANDLER(&CacheReadAgain::start_test);
+  }
+
+  int
+  start_test(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    this_ethread()->schedule_imm(this->_rt);
+    return 0;
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_READ:
+      base->do_io_read();
+      break;
+    case VC_EVENT_READ_READY:
+      base->reenable();
+      break;
+    case VC_EVENT_READ_COMPLETE:
+      base->close();
+      delete this;
+      break;
+    default:
+      REQUIRE(false);
+      break;
+    }
+  }
+};
+
+// Waits for the promotion started by the first read.
+class PromotionCheck : public TestContChain
+{
+public:
+  PromotionCheck() { SET_HANDLER(&PromotionCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CryptoHash key = url_cache_key(TIER_URL);
+
+    if (Metrics::Counter::load(cache_rsb.tier_promotions) == 0 && Metrics::Counter::load(cache_rsb.tier_copy_aborts) == 0 &&
+        ++_waits < 500) {
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+      return EVENT_CONT;
+    }
+
+    REQUIRE(fast_stripe(key) != nullptr);
+    CHECK(fast_stripe(key)->disk->fast_tier);
+    CHECK(!slow_stripe(key)->disk->fast_tier);
+    CHECK(Metrics::Counter::load(cache_rsb.tier_promotions) == 1);
+    CHECK(Metrics::Counter::load(cache_rsb.tier_copy_aborts) == 0);
+    CHECK(Metrics::Counter::load(cache_rsb.tier_slow_hits) == 1);
+    CHECK(in_directory(fast_stripe(key), key));
+    CHECK(in_directory(slow_stripe(key), key));
+
+    delete this;
+    return EVENT_DONE;
+  }
+
+private:
+  int _waits = 0;
+};
+
+class FastReadCheck : public TestContChain
+{
+public:
+  FastReadCheck() { SET_HANDLER(&FastReadCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CHECK(Metrics::Counter::load(cache_rsb.tier_fast_hits) == 1);
+    CHECK(Metrics::Counter::load(cache_rsb.tier_slow_hits) == 1);
+
+    // No more copies, so the next read is from the slow tier.
+    cache_config_tier_max_copies = 0;
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+class RewriteCheck : public TestContChain
+{
+public:
+  RewriteCheck() { SET_HANDLER(&RewriteCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CryptoHash key = url_cache_key(TIER_URL);
+
+    // The write removed the copy in the fast tier.
+    CHECK(!in_directory(fast_stripe(key), key));
+    CHECK(in_directory(slow_stripe(key), key));
+    CHECK(Metrics::Counter::load(cache_rsb.tier_fast_hits) == 1);
+    CHECK(Metrics::Counter::load(cache_rsb.tier_slow_hits) == 2);
+
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+class CacheTierInit : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    CacheTestHandler *h  = new CacheTestHandler(LARGE_FILE, TIER_URL);
+    CacheTestHandler *h2 = new CacheTestHandler(LARGE_FILE, TIER_URL);
+    TerminalTest     *tt = new TerminalTest;
+    h->add(new PromotionCheck);
+    h->add(new CacheReadAgain(LARGE_FILE, TIER_URL));
+    h->add(new FastReadCheck);
+    h->add(h2);
+    h->add(new RewriteCheck);
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("storage tiers")
+{
+  // The second span is the fast tier.
+  std::filesystem::path config = std::filesystem::temp_directory_path() / "test_CacheTier";
+  std::filesystem::create_directories(config);
+  std::ofstream{config / "storage.config"} << "var/trafficserver 256M\nvar/trafficserver2 32M tier=fast\n";
+  Layout::get()->sysconfdir = config.string();
+
+  init_cache(256 * 1024 * 1024);
+
+  CacheTierInit *init = new CacheTierInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -0,0 +1,75 @@
+/** @file
+
+  Test writing large objects in fragments larger than the target fragment size
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#define LARGE_FILE  10 * 1024 * 1024
+#define MEDIUM_FILE 3 * 1024 * 1024 / 2
+
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+class FragmentSizeCheck : public TestContChain
+{
+public:
+  FragmentSizeCheck() { SET_HANDLER(&FragmentSizeCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    // Only the large object is split in fewer, larger fragments.
+    CHECK(Metrics::Counter::load(cache_rsb.large_fragment_objects) == 1);
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+class FragmentSizeCacheInit : public CacheInit
+{
+public:
+  FragmentSizeCacheInit() {}
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    CacheTestHandler *h  = new CacheTestHandler(LARGE_FILE);
+    CacheTestHandler *h2 = new CacheTestHandler(MEDIUM_FILE, "http://www.scw11.com");
+    TerminalTest     *tt = new TerminalTest;
+    h->add(h2);
+    h->add(new FragmentSizeCheck);
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("cache write -> read in large fragments", "cache")
+{
+  init_cache(256 * 1024 * 1024);
+  cache_config_target_fragment_size = 1 * 1024 * 1024;
+  cache_config_max_fragment_size    = 4 * 1024 * 1024;
+  FragmentSizeCacheInit *init       = new FragmentSizeCacheInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -397,6 +397,23 @@ private:
   bool _is_read_start = false;
 };
 
+// The reader of the first test took the fragments from the writer.
+class CacheRWWFanoutCheck : public TestContChain
+{
+public:
+  CacheRWWFanoutCheck() { SET_HANDLER(&CacheRWWFanoutCheck::check); }
+
+  int
+  check(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CHECK(Metrics::Counter::load(cache_rsb.read_busy_fanout_writers) == 1);
+    CHECK(Metrics::Counter::load(cache_rsb.read_busy_fanout_readers) == 1);
+    CHECK(Metrics::Counter::load(cache_rsb.read_busy_fanout_bytes) > 0);
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
 class CacheRWWCacheInit : public CacheInit
 {
 public:
@@ -409,6 +426,7 @@ public:
     CacheRWWEOSTest   *crww_eos = new CacheRWWEOSTest(LARGE_FILE, "ttp://www.scw44.com/");
     TerminalTest      *tt       = new TerminalTest();
 
+    crww->add(new CacheRWWFanoutCheck);
     crww->add(crww_l);
     crww->add(crww_eos);
     crww->add(tt);
@@ -26,10 +26,16 @@
 
 #include "tscore/EventNotify.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
 
 // Required by main.h
 int  cache_vols           = 1;
@@ -394,3 +400,155 @@ TEST_CASE("aggWrite behavior with f.evacuator set")
   ats_free(stripe.raw_dir);
   ats_free(stripe.get_preserved_dirs().evacuate);
 }
+
+TEST_CASE("aggWrite behavior while an aggregation write is in progress")
+{
+  StripeSM            stripe;
+  StripteHeaderFooter header;
+  CacheVol            cache_vol;
+  auto               *file{init_stripe_for_writing(stripe, header, cache_vol)};
+  WaitingVC           first{&stripe};
+  WaitingVC           second{&stripe};
+  char const         *source = "yay";
+  for (WaitingVC *vc : {&first, &second}) {
+    vc->set_test_data(source, 4);
+    vc->set_write_len(4);
+    vc->set_agg_len(stripe.round_to_approx_size(vc->write_len + vc->header_len + vc->frag_len + sizeof(Doc)));
+  }
+  first.f.sync          = 1;
+  first.f.use_first_key = 1;
+  first.write_serial    = 1;
+  header.write_serial   = 10;
+  // Documents are block aligned, as they are outside of tests.
+  header.write_pos = stripe.start + 64 * CACHE_BLOCK_SIZE;
+  stripe.add_writer(&first);
+
+  off_t first_offset = header.write_pos;
+  int   flushed      = 0;
+  {
+    // Holding the stripe lock keeps aggWriteDone from completing the write.
+    SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+    stripe.aggWrite(EVENT_NONE, 0);
+    REQUIRE(stripe.is_io_in_progress());
+    flushed = header.agg_pos - header.write_pos;
+    REQUIRE(0 < flushed);
+
+    stripe.add_writer(&second);
+    stripe.aggregate_during_write(EVENT_NONE);
+
+    // The second writer is copied behind the buffer being written.
+    CHECK(first_offset == stripe.vol_offset(&first.dir));
+    CHECK(first_offset + flushed == stripe.vol_offset(&second.dir));
+    CHECK(flushed + static_cast<int>(second.agg_len) == stripe.get_agg_buf_pos());
+    CHECK(header.write_serial + 1 == second.write_serial);
+    CHECK(nullptr == stripe.get_pending_writers().head);
+  }
+  second.wait_for_callback();
+  first.wait_for_callback();
+
+  {
+    // The sync writer is called back once the buffer after its own is
+    // written, so both buffers are on disk by now.
+    SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+    CHECK(first_offset + flushed + second.agg_len == header.write_pos);
+    CHECK(12 == header.write_serial);
+    CHECK(0 == stripe.get_agg_buf_pos());
+
+    Doc doc;
+    fseek(file, first_offset, SEEK_SET);
+    REQUIRE(1 == fread(&doc, sizeof(Doc), 1, file));
+    CHECK(DOC_MAGIC == doc.magic);
+    CHECK(10 == doc.write_serial);
+
+    fseek(file, first_offset + flushed, SEEK_SET);
+    REQUIRE(1 == fread(&doc, sizeof(Doc), 1, file));
+    CHECK(DOC_MAGIC == doc.magic);
+    CHECK(11 == doc.write_serial);
+  }
+
+  ats_free(stripe.raw_dir);
+  ats_free(stripe.get_preserved_dirs().evacuate);
+}
+
+namespace
+{
+class TimedVC final : public FakeVC
+{
+public:
+  TimedVC(StripeSM *stripe, std::atomic<int> &done) : _done{done}
+  {
+    SET_HANDLER(&TimedVC::handle_call);
+    this->stripe = stripe;
+    this->dir    = *stripe->dir;
+  }
+
+  int
+  handle_call(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    this->called_at = ink_get_hrtime();
+    ++this->_done;
+    return EVENT_CONT;
+  }
+
+  ink_hrtime queued_at = 0;
+  ink_hrtime called_at = 0;
+
+private:
+  std::atomic<int> &_done;
+};
+} // namespace
+
+// Run with: test_CacheStripe "[bench]"
+TEST_CASE("Throughput and latency of aggregation writes", "[.][bench]")
+{
+  constexpr int WRITERS    = 32768;
+  constexpr int WRITE_SIZE = 1024;
+
+  StripeSM            stripe;
+  StripteHeaderFooter header;
+  CacheVol            cache_vol;
+  init_stripe_for_writing(stripe, header, cache_vol);
+  std::atomic<int>    done{0};
+  std::vector<char>   source(WRITE_SIZE, 'x');
+
+  std::vector<std::unique_ptr<TimedVC>> writers;
+  for (int i = 0; i < WRITERS; ++i) {
+    auto vc = std::make_unique<TimedVC>(&stripe, done);
+    vc->set_test_data(source.data(), WRITE_SIZE);
+    vc->set_write_len(WRITE_SIZE);
+    vc->set_agg_len(stripe.round_to_approx_size(vc->write_len + sizeof(Doc)));
+    // Do not let the backlog limit drop writers.
+    vc->set_readers(1);
+    writers.push_back(std::move(vc));
+  }
+
+  ink_hrtime start = ink_get_hrtime();
+  for (auto &vc : writers) {
+    SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+    vc->queued_at = ink_get_hrtime();
+    stripe.add_writer(vc.get());
+    if (!stripe.is_io_in_progress()) {
+      stripe.aggWrite(EVENT_NONE, nullptr);
+    } else {
+      stripe.aggregate_during_write(EVENT_NONE);
+    }
+  }
+  while (done < WRITERS) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ink_hrtime elapsed = ink_get_hrtime() - start;
+
+  ink_hrtime total = 0;
+  ink_hrtime worst = 0;
+  for (auto &vc : writers) {
+    total += vc->called_at - vc->queued_at;
+    worst  = std::max(worst, vc->called_at - vc->queued_at);
+  }
+  std::printf("%d writes of %d bytes: %.1f MB/s, latency mean %" PRId64 " us, max %" PRId64 " us\n", WRITERS, WRITE_SIZE,
+              static_cast<double>(WRITERS) * WRITE_SIZE / (static_cast<double>(elapsed) / HRTIME_SECOND) / (1024 * 1024),
+              ink_hrtime_to_usec(total / WRITERS), ink_hrtime_to_usec(worst));
+  CHECK(WRITERS == done);
+
+  ats_free(stripe.raw_dir);
+  ats_free(stripe.get_preserved_dirs().evacuate);
+}
@@ -44,6 +44,10 @@ ink_event_system_init(ts::ModuleVersion v)
 
   REC_EstablishStaticConfigInt32(thread_freelist_low_watermark, "proxy.config.allocator.thread_freelist_low_watermark");
 
+  REC_EstablishStaticConfigInt32(thread_freelist_adaptive, "proxy.config.allocator.thread_freelist_adaptive");
+
+  LockProfiler::init();
+
   int   chunk_sizes[DEFAULT_BUFFER_SIZES] = {0};
   char *chunk_sizes_string                = REC_ConfigReadString("proxy.config.allocator.iobuf_chunk_sizes");
   if (chunk_sizes_string && !parse_buffer_chunk_sizes(chunk_sizes_string, chunk_sizes)) {
@@ -29,8 +29,10 @@
 #include "tscore/ink_defs.h"
 #include "P_EventSystem.h"
 #include "swoc/Lexicon.h"
+#include "tsutil/Metrics.h"
 
 #include <optional>
+#include <string>
 
 //
 // General Buffer Allocator
@@ -47,6 +49,16 @@ int64_t                       default_large_iobuffer_size = DEFAULT_LARGE_BUFFER
 int64_t                       default_small_iobuffer_size = DEFAULT_SMALL_BUFFER_SIZE;
 int64_t                       max_iobuffer_size           = DEFAULT_BUFFER_SIZES - 1;
 
+namespace
+{
+struct BufferSizeClassMetrics {
+  ts::Metrics::Gauge::AtomicType *allocated = nullptr;
+  ts::Metrics::Gauge::AtomicType *inuse     = nullptr;
+};
+
+BufferSizeClassMetrics buffer_size_class_metrics[DEFAULT_BUFFER_SIZES];
+} // end anonymous namespace
+
 //
 // Initialization
 //
@@ -71,6 +83,26 @@ init_buffer_allocators(int iobuffer_advice, int chunk_sizes[DEFAULT_BUFFER_SIZES
       snprintf(name, 64, "ioBufAllocator[%d]", i);
     }
     ioBufAllocator[i].re_init(name, s, n, a, use_hugepages, iobuffer_advice);
+
+    if (buffer_size_class_metrics[i].allocated == nullptr) {
+      std::string size                       = std::to_string(s);
+      buffer_size_class_metrics[i].allocated = ts::Metrics::Gauge::createPtr("proxy.process.iobuffer.allocated.", size);
+      buffer_size_class_metrics[i].inuse     = ts::Metrics::Gauge::createPtr("proxy.process.iobuffer.inuse.", size);
+    }
+  }
+}
+
+void
+update_buffer_allocator_metrics()
+{
+  for (int i = 0; i < DEFAULT_BUFFER_SIZES; i++) {
+    const InkFreeList *fl = ioBufAllocator[i].freelist();
+    auto const        &m  = buffer_size_class_metrics[i];
+    if (fl == nullptr || m.allocated == nullptr) {
+      continue;
+    }
+    ts::Metrics::Gauge::store(m.allocated, static_cast<int64_t>(fl->allocated) * fl->type_size);
+    ts::Metrics::Gauge::store(m.inuse, static_cast<int64_t>(fl->used) * fl->type_size);
   }
 }
 
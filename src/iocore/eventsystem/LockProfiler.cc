@@ -0,0 +1,227 @@
+/** @file
+
+  Sampling of the contention on ProxyMutex locks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "iocore/eventsystem/LockProfiler.h"
+#include "iocore/eventsystem/Lock.h"
+#include "records/RecCore.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+using namespace std::literals;
+
+namespace
+{
+struct ClassStats {
+  uint64_t                    try_failures = 0;
+  uint64_t                    waits        = 0;
+  ink_hrtime                  wait_time    = 0;
+  LockProfiler::WaitHistogram wait_histogram;
+};
+
+struct SiteStats {
+  uint64_t   try_failures = 0;
+  uint64_t   waits        = 0;
+  ink_hrtime wait_time    = 0;
+};
+
+/// Lock class, site and holder site.
+using SiteKey = std::tuple<std::string_view, std::string_view, std::string_view>;
+
+// The samples. Only sampled contention takes this lock, and never while it takes another.
+std::mutex                             samples_mutex;
+std::map<std::string_view, ClassStats> classes;
+std::map<SiteKey, SiteStats>           sites;
+uint64_t                               dropped = 0;
+
+thread_local unsigned contended = 0;
+
+bool
+sampled()
+{
+  int rate = LockProfiler::sample_rate();
+  return rate <= 1 || ++contended % rate == 0;
+}
+
+std::string_view
+class_of(ProxyMutex const *m)
+{
+  return m->lock_class ? std::string_view{m->lock_class} : LockProfiler::UNCLASSIFIED;
+}
+
+// The site without the directory of the file.
+std::string_view
+short_site(const char *site)
+{
+  if (site == nullptr) {
+    return {};
+  }
+
+  std::string_view s{site};
+
+  if (auto n = s.rfind('/'); n != s.npos) {
+    s.remove_prefix(n + 1);
+  }
+  return s;
+}
+
+// A sample of @a wait spent in a blocking lock, or of a failed try lock if @a wait is negative.
+void
+record(ProxyMutex const *m, const char *site, const char *holder, ink_hrtime wait)
+{
+  std::lock_guard lock{samples_mutex};
+  ClassStats     &c = classes[class_of(m)];
+
+  if (wait < 0) {
+    ++c.try_failures;
+  } else {
+    ++c.waits;
+    c.wait_time += wait;
+    c.wait_histogram(ink_hrtime_to_usec(wait));
+  }
+
+  SiteKey key{class_of(m), short_site(site), short_site(holder)};
+  auto    spot = sites.find(key);
+
+  if (spot == sites.end()) {
+    if (sites.size() >= LockProfiler::MAX_SITES) {
+      ++dropped;
+      return;
+    }
+    spot = sites.emplace(key, SiteStats{}).first;
+  }
+  if (wait < 0) {
+    ++spot->second.try_failures;
+  } else {
+    ++spot->second.waits;
+    spot->second.wait_time += wait;
+  }
+}
+
+int
+update_config(const char *name, RecDataT /* data_type ATS_UNUSED */, RecData data, void * /* cookie ATS_UNUSED */)
+{
+  if (name == "proxy.config.lock_profiling.enabled"sv) {
+    LockProfiler::set_enabled(data.rec_int != 0);
+  } else if (name == "proxy.config.lock_profiling.sample_rate"sv) {
+    LockProfiler::set_sample_rate(data.rec_int);
+  }
+  return 0;
+}
+
+template <typename T>
+uint64_t
+contention(T const &stats)
+{
+  return stats.try_failures + stats.waits;
+}
+} // namespace
+
+void
+LockProfiler::set_enabled(bool enable)
+{
+  _enabled.store(enable, std::memory_order_relaxed);
+}
+
+void
+LockProfiler::set_sample_rate(int n)
+{
+  _sample_rate.store(std::max(n, 1), std::memory_order_relaxed);
+}
+
+void
+LockProfiler::init()
+{
+  set_enabled(REC_ConfigReadInteger("proxy.config.lock_profiling.enabled") != 0);
+  set_sample_rate(REC_ConfigReadInteger("proxy.config.lock_profiling.sample_rate"));
+
+  RecRegisterConfigUpdateCb("proxy.config.lock_profiling.enabled", update_config, nullptr);
+  RecRegisterConfigUpdateCb("proxy.config.lock_profiling.sample_rate", update_config, nullptr);
+}
+
+void
+LockProfiler::try_failed(ProxyMutex *m, const char *site)
+{
+  if (sampled()) {
+    record(m, site, m->holder_site.load(std::memory_order_relaxed), -1);
+  }
+}
+
+void
+LockProfiler::acquire(ProxyMutex *m, const char *site)
+{
+  if (!ink_mutex_try_acquire(&m->the_mutex)) {
+    if (sampled()) {
+      const char *holder = m->holder_site.load(std::memory_order_relaxed);
+      ink_hrtime  start  = ink_get_hrtime();
+
+      ink_mutex_acquire(&m->the_mutex);
+      record(m, site, holder, ink_get_hrtime() - start);
+    } else {
+      ink_mutex_acquire(&m->the_mutex);
+    }
+  }
+  m->holder_site.store(site, std::memory_order_relaxed);
+}
+
+auto
+LockProfiler::report(size_t top) -> Report
+{
+  Report r;
+
+  {
+    std::lock_guard lock{samples_mutex};
+
+    for (auto const &[name, stats] : classes) {
+      r.classes.push_back({name, stats.try_failures, stats.waits, stats.wait_time, stats.wait_histogram});
+    }
+    for (auto const &[key, stats] : sites) {
+      auto const &[name, site, holder] = key;
+      r.sites.push_back({name, site, holder, stats.try_failures, stats.waits, stats.wait_time});
+    }
+    r.dropped = dropped;
+  }
+
+  auto by_contention = [](auto const &lhs, auto const &rhs) {
+    return std::make_tuple(contention(lhs), lhs.wait_time) > std::make_tuple(contention(rhs), rhs.wait_time);
+  };
+
+  std::sort(r.classes.begin(), r.classes.end(), by_contention);
+  std::sort(r.sites.begin(), r.sites.end(), by_contention);
+  r.classes.resize(std::min(top, r.classes.size()));
+  r.sites.resize(std::min(top, r.sites.size()));
+
+  return r;
+}
+
+void
+LockProfiler::reset()
+{
+  std::lock_guard lock{samples_mutex};
+
+  classes.clear();
+  sites.clear();
+  dropped = 0;
+}
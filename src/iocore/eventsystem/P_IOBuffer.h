@@ -823,10 +823,43 @@ TS_INLINE void
 MIOBuffer::add_block()
 {
   if (this->_writer == nullptr || this->_writer->next == nullptr) {
+    // Grow the block size if the consumers are a full block or more behind the producer.
+    if (adaptive_max_index != BUFFER_SIZE_NOT_ALLOCATED && size_index < adaptive_max_index && this->_writer != nullptr &&
+        is_max_read_avail_more_than(block_size() - 1)) {
+      ++size_index;
+    }
     append_block(size_index);
   }
 }
 
+TS_INLINE void
+MIOBuffer::set_adaptive_size_index(int64_t max_index)
+{
+  ink_assert(BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index));
+  if (max_index > size_index && BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(max_index)) {
+    adaptive_start_index = size_index;
+    adaptive_max_index   = max_index;
+  }
+}
+
+TS_INLINE bool
+MIOBuffer::release_idle_blocks()
+{
+  if (this->_writer == nullptr || is_max_read_avail_more_than(0)) {
+    return false;
+  }
+  this->_writer = nullptr;
+  for (auto &reader : readers) {
+    if (reader.allocated()) {
+      reader.reset();
+    }
+  }
+  if (adaptive_max_index != BUFFER_SIZE_NOT_ALLOCATED) {
+    size_index = adaptive_start_index;
+  }
+  return true;
+}
+
 TS_INLINE void
 MIOBuffer::check_add_block()
 {
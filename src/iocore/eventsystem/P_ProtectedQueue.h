@@ -36,6 +36,7 @@ ProtectedQueue::ProtectedQueue()
 {
   Event e;
   ink_mutex_init(&lock);
+  ink_mutex_init(&ready_lock);
   ink_atomiclist_init(&al, "ProtectedQueue", (char *)&e.link.next - (char *)&e);
   ink_cond_init(&might_have_data);
 }
@@ -81,3 +82,31 @@ ProtectedQueue::dequeue_local()
   }
   return e;
 }
+
+// Called from the same thread. The event stays in the protected queue until it is run.
+TS_INLINE void
+ProtectedQueue::enqueue_ready(Event *e)
+{
+  ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
+  e->in_the_prot_queue = 1;
+  ink_mutex_acquire(&ready_lock);
+  readyQueue.enqueue(e);
+  ready_count.fetch_add(1, std::memory_order_relaxed);
+  ink_mutex_release(&ready_lock);
+}
+
+TS_INLINE Event *
+ProtectedQueue::dequeue_ready()
+{
+  if (ready_count.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  ink_mutex_acquire(&ready_lock);
+  Event *e = readyQueue.dequeue();
+  if (e) {
+    ready_count.fetch_sub(1, std::memory_order_relaxed);
+    e->in_the_prot_queue = 0;
+  }
+  ink_mutex_release(&ready_lock);
+  return e;
+}
@@ -96,3 +96,41 @@ ProtectedQueue::wait(ink_hrtime timeout)
     ink_cond_timedwait(&might_have_data, &lock, &ts);
   }
 }
+
+Event *
+ProtectedQueue::steal_ready()
+{
+  // Leave the queue to its thread if it is taking from it right now.
+  if (ready_count.load(std::memory_order_relaxed) == 0 || !ink_mutex_try_acquire(&ready_lock)) {
+    return nullptr;
+  }
+  Event *e = readyQueue.dequeue();
+  if (e) {
+    ready_count.fetch_sub(1, std::memory_order_relaxed);
+    e->in_the_prot_queue = 0;
+  }
+  ink_mutex_release(&ready_lock);
+  return e;
+}
+
+Event *
+ProtectedQueue::steal_external()
+{
+  if (INK_ATOMICLIST_EMPTY(al)) {
+    return nullptr;
+  }
+
+  // The list is LIFO, so this is the event sent last. Only an immediate event can run on another thread, any other is put
+  // back for the thread it was sent to.
+  Event *e = static_cast<Event *>(ink_atomiclist_pop(&al));
+  if (e && e->timeout_at != 0) {
+    if (ink_atomiclist_push(&al, e) == nullptr) {
+      e->ethread->tail_cb->signalActivity();
+    }
+    e = nullptr;
+  }
+  if (e) {
+    e->in_the_prot_queue = 0;
+  }
+  return e;
+}
@@ -23,18 +23,49 @@
 #include "iocore/eventsystem/ProxyAllocator.h"
 #include "tscore/ink_assert.h"
 
+#include <algorithm>
+
 int        thread_freelist_high_watermark = 512;
 int        thread_freelist_low_watermark  = 32;
+int        thread_freelist_adaptive       = 0;
 extern int cmd_disable_pfreelist;
 
+namespace
+{
+/// How far past thread_freelist_high_watermark an adaptive thread cache may grow.
+constexpr int ADAPTIVE_MAX_SCALE = 8;
+
+/** Adjust the limit of a thread cache that just overflowed.
+
+    If the cache kept missing since it was last drained, the thread is bouncing items off the global freelist and
+    gets a larger cache. If it hardly missed at all it shrinks back towards the configured size.
+*/
+void
+adapt_limit(ProxyAllocator &l)
+{
+  int limit = std::max(l.limit, thread_freelist_high_watermark);
+
+  if (l.misses > l.hits / 4) {
+    limit = std::min(limit * 2, thread_freelist_high_watermark * ADAPTIVE_MAX_SCALE);
+  } else if (l.misses < l.hits / 64) {
+    limit = std::max(limit / 2, thread_freelist_high_watermark);
+  }
+  l.limit = limit;
+}
+} // namespace
+
 void *
 thread_alloc(Allocator &a, ProxyAllocator &l)
 {
-  if (!cmd_disable_pfreelist && l.freelist) {
-    void *v    = l.freelist;
-    l.freelist = *static_cast<void **>(l.freelist);
-    --(l.allocated);
-    return v;
+  if (!cmd_disable_pfreelist) {
+    if (l.freelist) {
+      void *v    = l.freelist;
+      l.freelist = *static_cast<void **>(l.freelist);
+      --(l.allocated);
+      ++(l.hits);
+      return v;
+    }
+    ++(l.misses);
   }
   return a.alloc_void();
 }
@@ -42,10 +73,25 @@ thread_alloc(Allocator &a, ProxyAllocator &l)
 void
 thread_freeup(Allocator &a, ProxyAllocator &l)
 {
+  int low_watermark = thread_freelist_low_watermark;
+
+  a.record_thread_cache(l.hits, l.misses);
+  if (thread_freelist_adaptive) {
+    adapt_limit(l);
+    // Keep half of the cache so the next burst of allocations is still served locally.
+    low_watermark = std::max(low_watermark, l.limit / 2);
+  }
+  l.hits   = 0;
+  l.misses = 0;
+
+  if (!l.is_full()) {
+    return;
+  }
+
   void  *head  = l.freelist;
   void  *tail  = l.freelist;
   size_t count = 0;
-  while (l.freelist && l.allocated > thread_freelist_low_watermark) {
+  while (l.freelist && l.allocated > low_watermark) {
     tail       = l.freelist;
     l.freelist = *static_cast<void **>(l.freelist);
     --(l.allocated);
@@ -58,5 +104,5 @@ thread_freeup(Allocator &a, ProxyAllocator &l)
     a.free_void_bulk(head, tail, count);
   }
 
-  ink_assert(l.allocated >= thread_freelist_low_watermark);
+  ink_assert(l.allocated >= low_watermark);
 }
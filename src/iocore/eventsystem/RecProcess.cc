@@ -24,6 +24,7 @@
 #include "tscore/ink_platform.h"
 #include "tscore/EventNotify.h"
 #include "tsutil/Metrics.h"
+#include "tsutil/MetricsFile.h"
 
 #include "iocore/eventsystem/Tasks.h"
 
@@ -44,6 +45,8 @@ static Event      *raw_stat_sync_cont_event;
 static Event      *config_update_cont_event;
 static Event      *sync_cont_event;
 
+static ts::MetricsFile::Writer *g_metrics_file;
+
 static DbgCtl dbg_ctl_statsproc{"statsproc"};
 
 //-------------------------------------------------------------------------
@@ -80,6 +83,30 @@ RecProcess_set_remote_sync_interval_ms(int ms)
   }
 }
 
+//-------------------------------------------------------------------------
+// Export the metrics to a file, updated with the raw stats
+//-------------------------------------------------------------------------
+void
+RecProcess_set_metrics_file(const char *path)
+{
+  Dbg(dbg_ctl_statsproc, "metrics file -> %s", path);
+  delete g_metrics_file;
+  g_metrics_file = new ts::MetricsFile::Writer(path);
+}
+
+static void
+update_metrics_file()
+{
+  static bool failed = false;
+
+  if (g_metrics_file->update()) {
+    failed = false;
+  } else if (!failed) {
+    Warning("unable to write the metrics file '%s': %s", g_metrics_file->path().c_str(), strerror(errno));
+    failed = true;
+  }
+}
+
 //-------------------------------------------------------------------------
 // raw_stat_sync_cont
 //-------------------------------------------------------------------------
@@ -93,6 +120,12 @@ struct raw_stat_sync_cont : public Continuation {
 
     // This needs to be called periodically even after the old metrics sync is removed
     ts::Metrics::Derived::update_derived();
+    update_buffer_allocator_metrics();
+
+    // The file has the derived metrics too, so it is written after those are.
+    if (g_metrics_file) {
+      update_metrics_file();
+    }
 
     return EVENT_CONT;
   }
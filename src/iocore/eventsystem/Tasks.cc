@@ -39,6 +39,12 @@ TasksProcessor::register_event_type()
 int
 TasksProcessor::start(int task_threads, size_t stacksize)
 {
+  int work_stealing = 0;
+
+  REC_ReadConfigInteger(work_stealing, "proxy.config.task_threads.work_stealing");
+  if (work_stealing && ET_TASK != ET_CALL) {
+    eventProcessor.enable_work_stealing(ET_TASK);
+  }
   eventProcessor.spawn_event_threads(ET_TASK, std::max(1, task_threads), stacksize);
   return 0;
 }
@@ -41,7 +41,7 @@ thread_local Thread *Thread::this_thread_ptr;
 
 Thread::Thread()
 {
-  mutex = new_ProxyMutex();
+  mutex = new_ProxyMutex("thread");
 }
 
 Thread::~Thread()
@@ -195,7 +195,12 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
       free_event(e);
     } else if (!e->timeout_at) { // IMMEDIATE
       ink_assert(e->period == 0);
-      process_event(e, e->callback_event);
+      if (steal_group != NO_STEAL_GROUP) {
+        EventQueueExternal.enqueue_ready(e);
+        ts::Metrics::Gauge::increment(eventProcessor.thread_group[steal_group]._queued);
+      } else {
+        process_event(e, e->callback_event);
+      }
     } else if (e->timeout_at > 0) { // INTERVAL
       EventQueue.enqueue(e, ink_get_hrtime());
     } else { // NEGATIVE
@@ -213,6 +218,64 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
     }
     ++(*nq_count);
   }
+
+  if (steal_group != NO_STEAL_GROUP) {
+    process_ready();
+  }
+}
+
+// Run the immediate events taken in by process_queue, as long as no idle thread of the group steals them first.
+void
+EThread::process_ready()
+{
+  auto  &group = eventProcessor.thread_group[steal_group];
+  Event *e;
+
+  // Wake a peer to help if there is more to run than the next event.
+  if (group._count > 1 && EventQueueExternal.ready_count.load(std::memory_order_relaxed) > 1) {
+    group._thread[(id + 1 + generator.random() % (group._count - 1)) % group._count]->tail_cb->signalActivity();
+  }
+
+  while ((e = EventQueueExternal.dequeue_ready())) {
+    ts::Metrics::Gauge::decrement(group._queued);
+    if (e->timeout_at) { // Rescheduled while it waited.
+      EventQueueExternal.enqueue_local(e);
+    } else {
+      process_event(e, e->callback_event);
+    }
+  }
+}
+
+// Run an immediate event queued on another thread of the group, which is busy.
+bool
+EThread::steal_event()
+{
+  auto &group = eventProcessor.thread_group[steal_group];
+  int   start = generator.random() % group._count;
+
+  for (int i = 0; i < group._count; ++i) {
+    EThread *victim = group._thread[(start + i) % group._count];
+    Event   *e;
+
+    if (victim == this) {
+      continue;
+    }
+    if ((e = victim->EventQueueExternal.steal_ready())) {
+      ts::Metrics::Gauge::decrement(group._queued);
+      if (e->timeout_at) { // Rescheduled while it waited, it stays with its thread.
+        victim->EventQueueExternal.enqueue(e);
+        continue;
+      }
+    } else if (!(e = victim->EventQueueExternal.steal_external())) {
+      continue;
+    }
+
+    e->ethread = this;
+    ts::Metrics::Counter::increment(group._steals);
+    process_event(e, e->callback_event);
+    return true;
+  }
+  return false;
 }
 
 void
@@ -284,6 +347,14 @@ EThread::execute_regular()
 
     next_time             = EventQueue.earliest_timeout();
     ink_hrtime sleep_time = next_time - ink_get_hrtime();
+
+    // Nothing is due here, help a busy thread of the group instead of waiting.
+    if (sleep_time > 0 && steal_group != NO_STEAL_GROUP && EventQueueExternal.localQueue.empty() &&
+        INK_ATOMICLIST_EMPTY(EventQueueExternal.al) && steal_event()) {
+      ++ev_count;
+      sleep_time = 0;
+    }
+
     if (sleep_time > 0) {
       if (EventQueueExternal.localQueue.empty()) {
         sleep_time = std::min(sleep_time, HRTIME_MSECONDS(thread_max_heartbeat_mseconds));
@@ -371,9 +442,35 @@ EThread::Metrics::Slice::operator+=(Slice const &that)
   this->_duration._max  = std::max(this->_duration._max, that._duration._max);
   this->_count         += that._count;
   this->_wait          += that._wait;
+  this->_idle          += that._idle;
   return *this;
 }
 
+int
+EThread::Metrics::busy_permille()
+{
+  Slice *current = current_slice.load(std::memory_order_acquire);
+
+  if (current == nullptr || current->_duration._start == 0) {
+    return 0;
+  }
+  // A loop stuck in an event leaves the current slice behind.
+  if (ink_get_hrtime() - current->_duration._start > 2 * HRTIME_SECOND) {
+    return 1000;
+  }
+
+  Slice *slice = prev_slice(current);
+
+  if (slice->_duration._start == 0) {
+    return 0;
+  }
+  // The slice covers the rest of its second from the first loop in it.
+  ink_hrtime span = HRTIME_SECOND - slice->_duration._start % HRTIME_SECOND;
+  ink_hrtime idle = std::min(slice->_idle, span);
+
+  return 1000 - static_cast<int>(idle * 1000 / span);
+}
+
 void
 EThread::Metrics::summarize(Metrics &global)
 {
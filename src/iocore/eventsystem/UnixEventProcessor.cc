@@ -22,6 +22,8 @@
  */
 
 #include "P_EventSystem.h"
+#include <algorithm>
+#include <cctype>
 #include <sched.h>
 #if TS_USE_HWLOC
 #if __has_include(<alloca.h>)
@@ -72,9 +74,10 @@ protected:
   void *alloc_numa_stack(EThread *t, size_t stacksize);
 
 private:
-  hwloc_obj_type_t obj_type  = HWLOC_OBJ_MACHINE;
-  int              obj_count = 0;
-  char const      *obj_name  = nullptr;
+  hwloc_obj_type_t obj_type    = HWLOC_OBJ_MACHINE;
+  int              obj_count   = 0;
+  char const      *obj_name    = nullptr;
+  bool             numa_depots = false; ///< Put each thread on the freelist depot of its NUMA node.
 #endif
 };
 
@@ -256,6 +259,10 @@ ThreadAffinityInitializer::init()
 
   obj_count = hwloc_get_nbobjs_by_type(ink_get_topology(), obj_type);
   Dbg(dbg_ctl_iocore_thread, "Affinity: %d %ss: %d PU: %d", affinity, obj_name, obj_count, ink_number_of_processors());
+
+  int depots = 0;
+  REC_ReadConfigInteger(depots, "proxy.config.allocator.numa_depots");
+  numa_depots = depots != 0;
 }
 
 int
@@ -277,6 +284,18 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
     Dbg(dbg_ctl_iocore_thread, "EThread: %d %s: %d", _name, obj->logical_index);
 #endif // HWLOC_API_VERSION
     hwloc_set_thread_cpubind(ink_get_topology(), t->tid, obj->cpuset, HWLOC_CPUBIND_STRICT);
+
+    // If the thread is confined to a single NUMA node, allocate from that node's freelist depots.
+    if (numa_depots) {
+      hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+      hwloc_cpuset_to_nodeset(ink_get_topology(), obj->cpuset, nodeset);
+      if (hwloc_bitmap_weight(nodeset) == 1) {
+        int node = hwloc_bitmap_first(nodeset);
+        ink_freelist_set_numa_node(node);
+        Dbg(dbg_ctl_iocore_thread, "EThread: %p freelist depot for NUMA node %d", t, node);
+      }
+      hwloc_bitmap_free(nodeset);
+    }
   } else {
     Warning("hwloc returned an unexpected number of objects -- CPU affinity disabled");
   }
@@ -426,6 +445,18 @@ EventProcessor::spawn_event_threads(char const *name, int n_threads, size_t stac
   return ev_type;
 }
 
+void
+EventProcessor::enable_work_stealing(EventType ev_type)
+{
+  ThreadGroupDescriptor *tg = &(thread_group[ev_type]);
+
+  // The net threads own the connections they poll, their events cannot run elsewhere.
+  ink_release_assert(ev_type != ET_CALL && ev_type < n_thread_groups);
+  ink_release_assert(tg->_count == 0);
+
+  tg->_work_stealing = true;
+}
+
 EventType
 EventProcessor::spawn_event_threads(EventType ev_type, int n_threads, size_t stacksize)
 {
@@ -447,12 +478,23 @@ EventProcessor::spawn_event_threads(EventType ev_type, int n_threads, size_t sta
 
   Dbg(dbg_ctl_iocore_thread, "Thread stack size set to %zu", stacksize);
 
+  if (tg->_work_stealing) {
+    std::string stem{"proxy.process.eventloop." + tg->_name};
+
+    std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return std::tolower(c); });
+    tg->_queued = ts::Metrics::Gauge::createPtr(stem, ".queued");
+    tg->_steals = ts::Metrics::Counter::createPtr(stem, ".steals");
+  }
+
   for (i = 0; i < n_threads; ++i) {
     EThread *t                   = new EThread(REGULAR, n_ethreads + i);
     all_ethreads[n_ethreads + i] = t;
     tg->_thread[i]               = t;
     t->id                        = i; // unfortunately needed to support affinity and NUMA logic.
     t->set_event_type(ev_type);
+    if (tg->_work_stealing) {
+      t->steal_group = ev_type;
+    }
     t->schedule_spawn(&thread_initializer);
   }
   tg->_count  = n_threads;
@@ -34,6 +34,139 @@
 #define TEST_TIME_SECOND 60
 #define TEST_THREADS     2
 
+TEST_CASE("EventSystem work stealing", "[iocore]")
+{
+  static constexpr int     N_TASKS = 8;
+  static std::atomic<bool> release;
+  static std::atomic<int>  ran;
+  static std::atomic<int>  ran_elsewhere;
+  static EThread          *blocked;
+
+  // Keeps its thread busy until the tasks sent to that thread have run elsewhere.
+  struct blocker : public Continuation {
+    blocker(ProxyMutex *m) : Continuation(m) { SET_HANDLER(&blocker::block); }
+
+    int
+    block(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+    {
+      blocked = this_ethread();
+      for (int i = 0; i < 1000 && !release; ++i) {
+        usleep(10000);
+      }
+      return 0;
+    }
+  };
+
+  struct task : public Continuation {
+    task() : Continuation(new_ProxyMutex()) { SET_HANDLER(&task::run); }
+
+    int
+    run(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+    {
+      if (this_ethread() != blocked) {
+        ++ran_elsewhere;
+      }
+      ++ran;
+      return 0;
+    }
+  };
+
+  EventType type = eventProcessor.register_event_type("ET_STEAL");
+  eventProcessor.enable_work_stealing(type);
+  eventProcessor.spawn_event_threads(type, 2, 1048576);
+
+  auto const &group = eventProcessor.thread_group[type];
+  blocker     block{new_ProxyMutex()};
+  task        tasks[N_TASKS];
+
+  group._thread[0]->schedule_imm(&block);
+  for (int i = 0; i < 1000 && !blocked; ++i) {
+    usleep(1000);
+  }
+  REQUIRE(blocked != nullptr);
+
+  for (auto &t : tasks) {
+    blocked->schedule_imm(&t);
+  }
+  for (int i = 0; i < 1000 && ran < N_TASKS; ++i) {
+    usleep(1000);
+  }
+  release = true;
+
+  CHECK(ran == N_TASKS);
+  CHECK(ran_elsewhere == N_TASKS);
+  CHECK(ts::Metrics::Counter::load(group._steals) >= N_TASKS); // The blocker may have been stolen too.
+  CHECK(ts::Metrics::Gauge::load(group._queued) == 0);
+}
+
+TEST_CASE("EventSystem lock profiling", "[iocore]")
+{
+  static std::atomic<bool> held;
+  static std::atomic<bool> contending;
+
+  // Holds its lock until the test thread has failed a try lock and waits on the lock.
+  struct holder : public Continuation {
+    Ptr<ProxyMutex> lock;
+
+    holder(Ptr<ProxyMutex> &m) : Continuation(new_ProxyMutex()), lock(m) { SET_HANDLER(&holder::hold); }
+
+    int
+    hold(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+    {
+      SCOPED_MUTEX_LOCK(l, lock, this_ethread());
+      held = true;
+      for (int i = 0; i < 1000 && !contending; ++i) {
+        usleep(1000);
+      }
+      usleep(20000);
+      return 0;
+    }
+  };
+
+  LockProfiler::set_enabled(true);
+  LockProfiler::set_sample_rate(1);
+  LockProfiler::reset();
+
+  Ptr<ProxyMutex> m{new_ProxyMutex("test.lock")};
+  holder          h{m};
+
+  eventProcessor.schedule_imm(&h, ET_CALL);
+  for (int i = 0; i < 1000 && !held; ++i) {
+    usleep(1000);
+  }
+  REQUIRE(held);
+
+  {
+    MUTEX_TRY_LOCK(l, m, this_ethread());
+    CHECK_FALSE(l.is_locked());
+  }
+  contending = true;
+  {
+    SCOPED_MUTEX_LOCK(l, m, this_ethread());
+  }
+  LockProfiler::set_enabled(false);
+
+  auto report = LockProfiler::report(10);
+
+  REQUIRE(report.classes.size() == 1);
+  CHECK(report.classes[0].name == "test.lock");
+  CHECK(report.classes[0].try_failures == 1);
+  CHECK(report.classes[0].waits == 1);
+  CHECK(report.classes[0].wait_time > 0);
+
+  REQUIRE(report.sites.size() == 2);
+  for (auto const &s : report.sites) {
+    CHECK(s.lock_class == "test.lock");
+    CHECK(s.site.starts_with("test_EventSystem.cc:"));
+    CHECK(s.holder.starts_with("test_EventSystem.cc:"));
+    CHECK(s.site != s.holder);
+  }
+  CHECK(report.dropped == 0);
+
+  LockProfiler::reset();
+  CHECK(LockProfiler::report(10).classes.empty());
+}
+
 TEST_CASE("EventSystem", "[iocore]")
 {
   static int count;
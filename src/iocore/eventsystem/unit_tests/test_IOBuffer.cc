@@ -328,6 +328,57 @@ TEST_CASE("MIOBuffer", "[iocore]")
 
     free_MIOBuffer(miob);
   }
+
+  SECTION("adaptive block size")
+  {
+    MIOBuffer      *miob   = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+    IOBufferReader *miob_r = miob->alloc_reader();
+    miob->set_adaptive_size_index(BUFFER_SIZE_INDEX_16K);
+
+    uint8_t buf[16384 + 1];
+    memset(buf, 0xAA, sizeof(buf));
+
+    SECTION("consumer keeps up")
+    {
+      miob->write(buf, 4096);
+      miob_r->consume(4096);
+      miob->write(buf, 1);
+      CHECK(miob->size_index == BUFFER_SIZE_INDEX_4K);
+      CHECK(miob->first_write_block()->block_size() == 4096);
+    }
+
+    SECTION("consumer falls behind")
+    {
+      miob->write(buf, 4096 + 1);
+      CHECK(miob->size_index == BUFFER_SIZE_INDEX_8K);
+      CHECK(miob->first_write_block()->block_size() == 8192);
+
+      miob->write(buf, 8192);
+      CHECK(miob->size_index == BUFFER_SIZE_INDEX_16K);
+      CHECK(miob->first_write_block()->block_size() == 16384);
+
+      miob->write(buf, 16384 + 1);
+      CHECK(miob->size_index == BUFFER_SIZE_INDEX_16K);
+      CHECK(miob_r->read_avail() == 4096 + 1 + 8192 + 16384 + 1);
+
+      SECTION("release idle blocks")
+      {
+        CHECK(miob->release_idle_blocks() == false);
+
+        miob_r->consume(miob_r->read_avail());
+        CHECK(miob->release_idle_blocks() == true);
+        CHECK(miob->first_write_block() == nullptr);
+        CHECK(miob->size_index == BUFFER_SIZE_INDEX_4K);
+        CHECK(miob_r->read_avail() == 0);
+
+        miob->write(buf, 10);
+        CHECK(miob->first_write_block()->block_size() == 4096);
+        CHECK(miob_r->read_avail() == 10);
+      }
+    }
+
+    free_MIOBuffer(miob);
+  }
 }
 
 TEST_CASE("block size parser", "[iocore]")
@@ -410,7 +410,7 @@ HostDBContinuation::init(HostDBHash const &the_hash, Options const &opt)
 
   host_res_style     = opt.host_res_style;
   dns_lookup_timeout = opt.timeout;
-  mutex              = new_ProxyMutex();
+  mutex              = new_ProxyMutex("hostdb");
   timeout            = nullptr;
   if (opt.cont) {
     action = opt.cont;
@@ -0,0 +1,98 @@
+/** @file
+
+  Placement of accepted connections on the net threads.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_ConnectionPlacement.h"
+#include "P_Net.h"
+
+#include <algorithm>
+#include <string>
+
+auto
+ConnectionPlacement::load(EThread *t) -> Load
+{
+  return {t->metrics.busy_permille(), get_NetHandler(t)->open_connections.load(std::memory_order_relaxed)};
+}
+
+EThread *
+ConnectionPlacement::assign_thread(EThread *local)
+{
+  EThread *preferred = local ? local : eventProcessor.assign_thread(ET_NET);
+
+  if (net_connection_placement != LOAD_AWARE) {
+    return preferred;
+  }
+
+  auto threads = eventProcessor.active_group_threads(ET_NET);
+  int  n       = threads.end() - threads.begin();
+
+  if (n < 2) {
+    return preferred;
+  }
+
+  EThread *candidate = threads.begin()[this_ethread()->generator.random() % n];
+  EThread *target    = choose(preferred, candidate, &ConnectionPlacement::load);
+
+  if (target != preferred) {
+    Metrics::Counter::increment(net_rsb.connections_steered);
+  }
+  return target;
+}
+
+void
+ConnectionPlacement::init_thread(EThread *t)
+{
+  NetHandler *nh     = get_NetHandler(t);
+  std::string prefix = "proxy.process.net.threads." + std::to_string(t->id);
+
+  nh->busy_metric        = Metrics::Gauge::createPtr(prefix + ".busy");
+  nh->connections_metric = Metrics::Gauge::createPtr(prefix + ".connections");
+}
+
+void
+ConnectionPlacement::update_metrics(EThread *t)
+{
+  NetHandler *nh = get_NetHandler(t);
+  Load        l  = load(t);
+
+  Metrics::Gauge::store(nh->busy_metric, l.busy / 10);
+  Metrics::Gauge::store(nh->connections_metric, l.connections);
+
+  // The first net thread also keeps the spread between the threads.
+  auto threads = eventProcessor.active_group_threads(ET_NET);
+
+  if (threads.begin() == threads.end() || *threads.begin() != t) {
+    return;
+  }
+
+  Load lo = l, hi = l;
+
+  for (EThread *peer : threads) {
+    Load pl        = load(peer);
+    lo.busy        = std::min(lo.busy, pl.busy);
+    hi.busy        = std::max(hi.busy, pl.busy);
+    lo.connections = std::min(lo.connections, pl.connections);
+    hi.connections = std::max(hi.connections, pl.connections);
+  }
+  Metrics::Gauge::store(net_rsb.threads_busy_imbalance, (hi.busy - lo.busy) / 10);
+  Metrics::Gauge::store(net_rsb.threads_connections_imbalance, hi.connections - lo.connections);
+}
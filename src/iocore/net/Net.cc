@@ -40,6 +40,9 @@ int net_accept_period  = 10;
 int net_retry_delay    = 10;
 int net_throttle_delay = 50; /* milliseconds */
 
+int net_park_idle_connections = 0;
+int net_connection_placement  = 0;
+
 // For the in/out congestion control: ToDo: this probably would be better as ports: specifications
 std::string_view net_ccp_in;
 std::string_view net_ccp_out;
@@ -52,6 +55,8 @@ configure_net()
 
   REC_EstablishStaticConfigInt32(net_retry_delay, "proxy.config.net.retry_delay");
   REC_EstablishStaticConfigInt32(net_throttle_delay, "proxy.config.net.throttle_delay");
+  REC_EstablishStaticConfigInt32(net_park_idle_connections, "proxy.config.net.park_idle_connections");
+  REC_EstablishStaticConfigInt32(net_connection_placement, "proxy.config.net.connection_placement");
 
   // These are not reloadable
   REC_ReadConfigInteger(net_event_period, "proxy.config.net.event_period");
@@ -88,6 +93,7 @@ register_net_stats()
   net_rsb.calls_to_write_nodata      = Metrics::Counter::createPtr("proxy.process.net.calls_to_write_nodata");
   net_rsb.calls_to_writetonet        = Metrics::Counter::createPtr("proxy.process.net.calls_to_writetonet");
   net_rsb.connections_currently_open = Metrics::Gauge::createPtr("proxy.process.net.connections_currently_open");
+  net_rsb.connections_steered        = Metrics::Counter::createPtr("proxy.process.net.connections_steered");
   net_rsb.connections_throttled_in   = Metrics::Counter::createPtr("proxy.process.net.connections_throttled_in");
   net_rsb.per_client_connections_throttled_in =
     Metrics::Counter::createPtr("proxy.process.net.per_client.connections_throttled_in");
@@ -127,6 +133,8 @@ register_net_stats()
     Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_lock_acquire_failure");
   net_rsb.keep_alive_queue_timeout_count   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_count");
   net_rsb.keep_alive_queue_timeout_total   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_total");
+  net_rsb.parked_connections               = Metrics::Counter::createPtr("proxy.process.net.parked_connections");
+  net_rsb.parked_bytes_released            = Metrics::Counter::createPtr("proxy.process.net.parked_bytes_released");
   net_rsb.read_bytes                       = Metrics::Counter::createPtr("proxy.process.net.read_bytes");
   net_rsb.read_bytes_count                 = Metrics::Counter::createPtr("proxy.process.net.read_bytes_count");
   net_rsb.requests_max_throttled_in        = Metrics::Counter::createPtr("proxy.process.net.max.requests_throttled_in");
@@ -134,6 +142,8 @@ register_net_stats()
   net_rsb.socks_connections_successful     = Metrics::Counter::createPtr("proxy.process.socks.connections_successful");
   net_rsb.socks_connections_unsuccessful   = Metrics::Counter::createPtr("proxy.process.socks.connections_unsuccessful");
   net_rsb.tcp_accept                       = Metrics::Counter::createPtr("proxy.process.tcp.total_accepts");
+  net_rsb.threads_busy_imbalance           = Metrics::Gauge::createPtr("proxy.process.net.threads.busy_imbalance");
+  net_rsb.threads_connections_imbalance    = Metrics::Gauge::createPtr("proxy.process.net.threads.connections_imbalance");
   net_rsb.write_bytes                      = Metrics::Counter::createPtr("proxy.process.net.write_bytes");
   net_rsb.write_bytes_count                = Metrics::Counter::createPtr("proxy.process.net.write_bytes_count");
   net_rsb.connection_tracker_table_size    = Metrics::Gauge::createPtr("proxy.process.net.connection_tracker_table_size");
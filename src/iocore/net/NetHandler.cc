@@ -105,6 +105,11 @@ NetHandler::startCop(NetEvent *ne)
   ink_assert(!open_list.in(ne));
 
   open_list.enqueue(ne);
+  open_connections.fetch_add(1, std::memory_order_relaxed);
+  if (cop_tick > 0) {
+    // Check the new NetEvent at the next tick, as the InactivityCop sweep would.
+    timeout_wheel.schedule(ne, timeout_wheel.now() + 1);
+  }
 }
 
 void
@@ -112,12 +117,55 @@ NetHandler::stopCop(NetEvent *ne)
 {
   ink_release_assert(ne->nh == this);
 
+  if (open_list.in(ne)) {
+    open_connections.fetch_sub(1, std::memory_order_relaxed);
+  }
   open_list.remove(ne);
   cop_list.remove(ne);
+  timeout_wheel.remove(ne);
+  if (ne->in_timeout_changed_list.exchange(false)) {
+    timeout_changed_list.remove(ne);
+  }
   remove_from_keep_alive_queue(ne);
   remove_from_active_queue(ne);
 }
 
+void
+NetHandler::start_timeout_wheel(ink_hrtime tick)
+{
+  ink_release_assert(tick > 0 && open_list.empty());
+
+  cop_tick      = tick;
+  timeout_wheel = TimingWheelOf(NetEvent, timeout_link)(ink_get_hrtime() / tick);
+}
+
+void
+NetHandler::schedule_timeout(NetEvent *ne, ink_hrtime now)
+{
+  ink_hrtime at = now + TIMEOUT_WHEEL_RECHECK_TICKS * cop_tick;
+
+  if (ne->next_inactivity_timeout_at) {
+    at = std::min(at, ne->next_inactivity_timeout_at);
+  } else if (ne->inactivity_timeout_in > 0) {
+    // Activity sets the deadline from the timeout, never earlier than this.
+    at = std::min(at, now + ne->inactivity_timeout_in);
+  }
+  if (ne->next_activity_timeout_at) {
+    at = std::min(at, ne->next_activity_timeout_at);
+  }
+
+  // The InactivityCop fires a timeout once the deadline is strictly in the past.
+  timeout_wheel.schedule(ne, at / cop_tick + 1);
+}
+
+void
+NetHandler::timeout_changed(NetEvent *ne)
+{
+  if (cop_tick > 0 && !ne->in_timeout_changed_list.exchange(true)) {
+    timeout_changed_list.push(ne);
+  }
+}
+
 int
 NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, void *)
 {
@@ -357,8 +405,10 @@ NetHandler::waitForActivity(ink_hrtime timeout)
 #endif
 
   // Polling event by PollCont
-  PollCont *p = get_PollCont(this->thread);
+  PollCont  *p          = get_PollCont(this->thread);
+  ink_hrtime poll_start = ink_get_hrtime();
   p->do_poll(timeout);
+  this->thread->metrics.record_idle_time(ink_get_hrtime() - poll_start);
 
   // Get & Process polling result
   PollDescriptor *pd = get_PollDescriptor(this->thread);
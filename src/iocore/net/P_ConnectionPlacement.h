@@ -0,0 +1,97 @@
+/** @file
+
+  Placement of accepted connections on the net threads.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+class EThread;
+
+/** Picks the ET_NET thread an accepted connection is handled on.
+
+    By default a connection stays on the thread that accepted it, or goes to the next thread in round robin order
+    if it was accepted on some other thread. With the load aware policy the thread it would have gone to is compared
+    with another thread picked at random, and the connection goes to the less loaded of the two. The load of a thread
+    is how busy its event loop was in the last second, from @c EThread::Metrics, and the number of connections open
+    on it. Comparing only two threads keeps the placement cheap, and does not make all the acceptors pile onto the
+    same least loaded thread.
+ */
+class ConnectionPlacement
+{
+public:
+  /// Values of proxy.config.net.connection_placement.
+  enum Policy {
+    ROUND_ROBIN = 0, ///< The accepting thread, or the next thread in order.
+    LOAD_AWARE  = 1, ///< The less loaded of that thread and a random one.
+  };
+
+  /// Load of a thread.
+  struct Load {
+    int      busy        = 0; ///< Thousandths of the last second the event loop was not waiting for activity.
+    uint32_t connections = 0; ///< Connections open on the thread.
+  };
+
+  /// Busy times within this many thousandths of each other are taken as equal, and the connections decide.
+  static constexpr int BUSY_MARGIN = 100;
+
+  /// Whether @a a is less loaded than @a b.
+  static bool
+  is_lighter(Load const &a, Load const &b)
+  {
+    if (std::abs(a.busy - b.busy) > BUSY_MARGIN) {
+      return a.busy < b.busy;
+    }
+    return a.connections < b.connections;
+  }
+
+  /** Choose between the thread a connection would go to and another one.
+
+      @param preferred The thread the connection goes to without load balancing.
+      @param candidate Another thread, picked at random.
+      @param load_of Functor that returns the @c Load of a thread.
+      @return @a candidate if it is less loaded than @a preferred, @a preferred otherwise.
+   */
+  template <typename T, typename F>
+  static T
+  choose(T preferred, T candidate, F &&load_of)
+  {
+    return candidate != preferred && is_lighter(load_of(candidate), load_of(preferred)) ? candidate : preferred;
+  }
+
+  /// The current load of the net thread @a t.
+  static Load load(EThread *t);
+
+  /** The net thread to hand an accepted connection to.
+
+      @param local The net thread the connection was accepted on, if it was accepted on one.
+      @return The thread, which is @a local if the connection stays where it is.
+   */
+  static EThread *assign_thread(EThread *local = nullptr);
+
+  /// Create the load metrics of the net thread @a t.
+  static void init_thread(EThread *t);
+
+  /// Update the load metrics of the net thread @a t, and the imbalance between the threads.
+  static void update_metrics(EThread *t);
+};
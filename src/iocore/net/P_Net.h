@@ -43,6 +43,7 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *calls_to_write;
   Metrics::Counter::AtomicType *calls_to_writetonet;
   Metrics::Gauge::AtomicType   *connections_currently_open;
+  Metrics::Counter::AtomicType *connections_steered;
   Metrics::Counter::AtomicType *connections_throttled_in;
   Metrics::Counter::AtomicType *per_client_connections_throttled_in;
   Metrics::Counter::AtomicType *connections_throttled_out;
@@ -55,6 +56,8 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *inactivity_cop_lock_acquire_failure;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_count;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_total;
+  Metrics::Counter::AtomicType *parked_connections;
+  Metrics::Counter::AtomicType *parked_bytes_released;
   Metrics::Counter::AtomicType *read_bytes;
   Metrics::Counter::AtomicType *read_bytes_count;
   Metrics::Counter::AtomicType *requests_max_throttled_in;
@@ -76,6 +79,8 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *socks_connections_successful;
   Metrics::Counter::AtomicType *socks_connections_unsuccessful;
   Metrics::Counter::AtomicType *tcp_accept;
+  Metrics::Gauge::AtomicType   *threads_busy_imbalance;
+  Metrics::Gauge::AtomicType   *threads_connections_imbalance;
   Metrics::Counter::AtomicType *write_bytes;
   Metrics::Counter::AtomicType *write_bytes_count;
   Metrics::Gauge::AtomicType   *connection_tracker_table_size;
@@ -94,6 +94,18 @@ public:
   virtual bool  add_to_active_queue() override;
   virtual void  remove_from_active_queue();
 
+  /** Release the idle buffers of a connection that waits for its next request.
+
+      Buffer blocks without unconsumed data are handed back to the allocator. They are allocated
+      again by the next read or write.
+
+      @return The number of buffer bytes released.
+  */
+  virtual int64_t park();
+
+  /// Bytes held by this connection object and the IO buffers of its VIOs.
+  int64_t memory_footprint() const;
+
   // The public interface is VIO::reenable()
   void reenable(VIO *vio) override;
   void reenable_re(VIO *vio) override;
@@ -336,14 +348,6 @@ UnixNetVConnection::get_inactivity_timeout()
   return inactivity_timeout_in;
 }
 
-inline void
-UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
-{
-  Dbg(_dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
-  active_timeout_in        = timeout_in;
-  next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
-}
-
 inline void
 UnixNetVConnection::cancel_inactivity_timeout()
 {
@@ -985,6 +985,22 @@ SSLNetVConnection::do_io_close(int lerrno)
   super::do_io_close(lerrno);
 }
 
+int64_t
+SSLNetVConnection::park()
+{
+  int64_t released = super::park();
+
+#if HAVE_SSL_FREE_BUFFERS
+  // OpenSSL allocates its record buffers again on the next read or write. This fails harmlessly
+  // if there is pending data in them.
+  if (this->ssl != nullptr && getSSLHandShakeComplete() && SSL_free_buffers(this->ssl) == 1) {
+    Dbg(dbg_ctl_ssl, "released the SSL buffers of parked vc %p", this);
+  }
+#endif
+
+  return released;
+}
+
 void
 SSLNetVConnection::clear()
 {
@@ -22,6 +22,7 @@
  */
 
 #include "iocore/net/AsyncSignalEventIO.h"
+#include "P_ConnectionPlacement.h"
 #include "P_Net.h"
 #include "P_UnixNet.h"
 #include "tscore/ink_hrtime.h"
@@ -84,6 +85,17 @@ public:
     NetHandler &nh  = *get_NetHandler(this_ethread());
 
     Dbg(dbg_ctl_inactivity_cop_check, "Checking inactivity on Thread-ID #%d", this_ethread()->id);
+    if (nh.cop_tick > 0) {
+      // Only the NetEvents which may have timed out by this tick are checked.
+      nh.timeout_wheel.advance(now / nh.cop_tick, [&nh](NetEvent *ne) { nh.cop_list.push(ne); });
+      SList(NetEvent, timeout_changed_link) changed(nh.timeout_changed_list.popall());
+      while (NetEvent *ne = changed.pop()) {
+        ne->in_timeout_changed_list = false;
+        if (nh.timeout_wheel.in(ne)) {
+          nh.schedule_timeout(ne, now);
+        }
+      }
+    }
     // The rest NetEvents in cop_list which are not triggered between InactivityCop runs.
     // Use pop() to catch any closes caused by callbacks.
     while (NetEvent *ne = nh.cop_list.pop()) {
@@ -91,6 +103,9 @@ public:
       MUTEX_TRY_LOCK(lock, ne->get_mutex(), this_ethread());
       if (!lock.is_locked()) {
         Metrics::Counter::increment(net_rsb.inactivity_cop_lock_acquire_failure);
+        if (nh.cop_tick > 0) {
+          nh.timeout_wheel.schedule(ne, nh.timeout_wheel.now() + 1);
+        }
         continue;
       }
 
@@ -120,6 +135,11 @@ public:
         Metrics::Counter::increment(net_rsb.default_inactivity_timeout_applied);
       }
 
+      if (nh.cop_tick > 0) {
+        // File the NetEvent again before the callback, which may close it.
+        nh.schedule_timeout(ne, now);
+      }
+
       if (ne->next_inactivity_timeout_at && ne->next_inactivity_timeout_at < now) {
         if (ne->is_default_inactivity_timeout()) {
           // track the connections that timed out due to default inactivity
@@ -142,11 +162,14 @@ public:
       }
     }
     // The cop_list is empty now.
-    // Let's reload the cop_list from open_list again.
-    forl_LL(NetEvent, ne, nh.open_list)
-    {
-      if (ne->get_thread() == this_ethread()) {
-        nh.cop_list.push(ne);
+    // Let's reload the cop_list from open_list again, unless the timer wheel
+    // tells which NetEvents to check.
+    if (nh.cop_tick == 0) {
+      forl_LL(NetEvent, ne, nh.open_list)
+      {
+        if (ne->get_thread() == this_ethread()) {
+          nh.cop_list.push(ne);
+        }
       }
     }
     // NetHandler will remove NetEvent from cop_list if it is triggered.
@@ -158,6 +181,8 @@ public:
     nh.manage_active_queue(nullptr, true); // close any connections over the active timeout
     nh.manage_keep_alive_queue();
 
+    ConnectionPlacement::update_metrics(this_ethread());
+
     return 0;
   }
 };
@@ -169,18 +194,24 @@ initialize_thread_for_net(EThread *thread)
 
   new (reinterpret_cast<ink_dummy_for_new *>(nh)) NetHandler();
   new (reinterpret_cast<ink_dummy_for_new *>(get_PollCont(thread))) PollCont(thread->mutex, nh);
-  nh->mutex  = new_ProxyMutex();
+  nh->mutex  = new_ProxyMutex("net.handler");
   nh->thread = thread;
+  ConnectionPlacement::init_thread(thread);
 
   PollCont       *pc = get_PollCont(thread);
   PollDescriptor *pd = pc->pollDescriptor;
 
   InactivityCop *inactivityCop = new InactivityCop(get_NetHandler(thread)->mutex);
   int            cop_freq      = 1;
+  int            timer_wheel   = 0;
 
   REC_ReadConfigInteger(cop_freq, "proxy.config.net.inactivity_check_frequency");
+  REC_ReadConfigInteger(timer_wheel, "proxy.config.net.inactivity_timer_wheel");
   memcpy(&nh->config, &NetHandler::global_config, sizeof(NetHandler::global_config));
   nh->configure_per_thread_values();
+  if (timer_wheel) {
+    nh->start_timeout_wheel(HRTIME_SECONDS(cop_freq));
+  }
   thread->schedule_every(inactivityCop, HRTIME_SECONDS(cop_freq));
 
   thread->set_tail_handler(nh);
@@ -25,6 +25,7 @@
 #include <tscore/ink_defs.h>
 
 #include "iocore/net/ConnectionTracker.h"
+#include "P_ConnectionPlacement.h"
 #include "P_Net.h"
 #include "tscore/ink_inet.h"
 
@@ -148,13 +149,12 @@ net_accept(NetAccept *na, void *ep, bool blockable)
 #endif
     SET_CONTINUATION_HANDLER(vc, &UnixNetVConnection::acceptEvent);
 
-    EThread    *t;
-    NetHandler *h;
-    if (e->ethread->is_event_type(ET_NET)) {
-      t = e->ethread;
-      h = get_NetHandler(t);
-      // Assign NetHandler->mutex to NetVC
-      vc->mutex = h->mutex;
+    // Keep the connection on this net thread, unless another one is less loaded.
+    EThread    *t = ConnectionPlacement::assign_thread(e->ethread->is_event_type(ET_NET) ? e->ethread : nullptr);
+    NetHandler *h = get_NetHandler(t);
+    // Assign NetHandler->mutex to NetVC
+    vc->mutex = h->mutex;
+    if (t == e->ethread) {
       MUTEX_TRY_LOCK(lock, h->mutex, t);
       if (!lock.is_locked()) {
         t->schedule_in(vc, HRTIME_MSECONDS(net_retry_delay));
@@ -162,10 +162,6 @@ net_accept(NetAccept *na, void *ep, bool blockable)
         vc->handleEvent(EVENT_NONE, e);
       }
     } else {
-      t = eventProcessor.assign_thread(ET_NET);
-      h = get_NetHandler(t);
-      // Assign NetHandler->mutex to NetVC
-      vc->mutex = h->mutex;
       t->schedule_imm(vc);
     }
   } while (count < additional_accepts);
@@ -441,7 +437,7 @@ NetAccept::do_blocking_accept(EThread *t)
 #endif
     SET_CONTINUATION_HANDLER(vc, &UnixNetVConnection::acceptEvent);
 
-    EThread    *localt = eventProcessor.assign_thread(ET_NET);
+    EThread    *localt = ConnectionPlacement::assign_thread();
     NetHandler *h      = get_NetHandler(localt);
     // Assign NetHandler->mutex to NetVC
     vc->mutex = h->mutex;
@@ -607,6 +603,14 @@ NetAccept::acceptFastEvent(int event, void *ep)
 #endif
     SET_CONTINUATION_HANDLER(vc, &UnixNetVConnection::acceptEvent);
 
+    // Hand the connection to a less loaded thread, if there is one.
+    if (EThread *target = ConnectionPlacement::assign_thread(t); target != t) {
+      vc->mutex = get_NetHandler(target)->mutex;
+      target->schedule_imm(vc);
+      vc = nullptr;
+      continue;
+    }
+
     // Assign NetHandler->mutex to NetVC
     vc->mutex = h->mutex;
     // We must be holding the lock already to do later do_io_read's
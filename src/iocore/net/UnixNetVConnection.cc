@@ -46,6 +46,22 @@ namespace
 DbgCtl dbg_ctl_socket{"socket"};
 DbgCtl dbg_ctl_inactivity_cop{"inactivity_cop"};
 DbgCtl dbg_ctl_iocore_net{"iocore_net"};
+DbgCtl dbg_ctl_net_park{"net_park"};
+
+// Bytes of the blocks currently allocated to @a buf, from the writer on.
+int64_t
+buffer_block_bytes(const MIOBuffer *buf)
+{
+  int64_t bytes = 0;
+  if (buf != nullptr) {
+    for (const IOBufferBlock *b = buf->_writer.get(); b != nullptr; b = b->next.get()) {
+      if (b->data) {
+        bytes += b->data->block_size();
+      }
+    }
+  }
+  return bytes;
+}
 
 } // end anonymous namespace
 
@@ -1354,6 +1370,9 @@ UnixNetVConnection::set_inactivity_timeout(ink_hrtime timeout_in)
   Dbg(dbg_ctl_socket, "Set inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   inactivity_timeout_in      = timeout_in;
   next_inactivity_timeout_at = (timeout_in > 0) ? ink_get_hrtime() + inactivity_timeout_in : 0;
+  if (nh != nullptr) {
+    nh->timeout_changed(this);
+  }
 }
 
 TS_INLINE void
@@ -1361,6 +1380,20 @@ UnixNetVConnection::set_default_inactivity_timeout(ink_hrtime timeout_in)
 {
   Dbg(dbg_ctl_socket, "Set default inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   default_inactivity_timeout_in = timeout_in;
+  if (nh != nullptr) {
+    nh->timeout_changed(this);
+  }
+}
+
+void
+UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
+{
+  Dbg(dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
+  active_timeout_in        = timeout_in;
+  next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
+  if (nh != nullptr) {
+    nh->timeout_changed(this);
+  }
 }
 
 TS_INLINE bool
@@ -1428,12 +1461,47 @@ UnixNetVConnection::add_to_keep_alive_queue()
 {
   MUTEX_TRY_LOCK(lock, nh->mutex, this_ethread());
   if (lock.is_locked()) {
+    if (net_park_idle_connections) {
+      int64_t released = this->park();
+      Metrics::Counter::increment(net_rsb.parked_connections);
+      Metrics::Counter::increment(net_rsb.parked_bytes_released, released);
+      Dbg(dbg_ctl_net_park, "parked vc %p: released %" PRId64 " bytes, now holding %" PRId64 " bytes", this, released,
+          this->memory_footprint());
+    }
+    // This could free this vc, do not touch it afterwards.
     nh->add_to_keep_alive_queue(this);
   } else {
     ink_release_assert(!"BUG: It must have acquired the NetHandler's lock before doing anything on keep_alive_queue.");
   }
 }
 
+int64_t
+UnixNetVConnection::park()
+{
+  int64_t released = 0;
+
+  for (MIOBuffer *buf : {read.vio.buffer.writer(), write.vio.buffer.writer()}) {
+    if (buf != nullptr) {
+      int64_t bytes = buffer_block_bytes(buf);
+      if (buf->release_idle_blocks()) {
+        released += bytes;
+      }
+    }
+  }
+
+  return released;
+}
+
+int64_t
+UnixNetVConnection::memory_footprint() const
+{
+  int64_t bytes = sizeof(*this) + buffer_block_bytes(read.vio.buffer.writer());
+  if (write.vio.buffer.writer() != read.vio.buffer.writer()) {
+    bytes += buffer_block_bytes(write.vio.buffer.writer());
+  }
+  return bytes;
+}
+
 void
 UnixNetVConnection::remove_from_keep_alive_queue()
 {
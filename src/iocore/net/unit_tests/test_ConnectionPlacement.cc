@@ -0,0 +1,156 @@
+/** @file
+
+  Catch based unit tests for the placement of accepted connections.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "../P_ConnectionPlacement.h"
+#include "../P_Net.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+
+#include <catch.hpp>
+
+namespace
+{
+constexpr int N_THREADS = 8;
+constexpr int HOT       = 0;
+
+using Loads = std::array<ConnectionPlacement::Load, N_THREADS>;
+
+// Place @a n connections the way the acceptors do, round robin or on the less loaded of that thread and a random one.
+void
+place(Loads &loads, int n, bool load_aware)
+{
+  std::minstd_rand rng{42};
+
+  for (int i = 0; i < n; ++i) {
+    int preferred = i % N_THREADS;
+    int target    = preferred;
+
+    if (load_aware) {
+      target = ConnectionPlacement::choose(preferred, static_cast<int>(rng() % N_THREADS), [&](int t) { return loads[t]; });
+    }
+    ++loads[target].connections;
+  }
+}
+
+// The spread of the connections over the threads other than the hot one.
+uint32_t
+spread(Loads const &loads)
+{
+  auto [lo, hi] = std::minmax_element(loads.begin() + 1, loads.end(), [](auto const &a, auto const &b) {
+    return a.connections < b.connections;
+  });
+  return hi->connections - lo->connections;
+}
+} // namespace
+
+TEST_CASE("The busy time decides unless it is close", "[placement]")
+{
+  using Load = ConnectionPlacement::Load;
+
+  CHECK(ConnectionPlacement::is_lighter(Load{300, 5000}, Load{900, 10}));
+  CHECK_FALSE(ConnectionPlacement::is_lighter(Load{900, 10}, Load{300, 5000}));
+  CHECK(ConnectionPlacement::is_lighter(Load{350, 10}, Load{300, 5000}));
+  CHECK_FALSE(ConnectionPlacement::is_lighter(Load{300, 10}, Load{300, 10}));
+  CHECK(ConnectionPlacement::choose(3, 3, [](int) { return Load{}; }) == 3);
+}
+
+TEST_CASE("Connections are steered away from a hot thread", "[placement]")
+{
+  constexpr int N_CONNECTIONS = 8000;
+
+  // One thread is saturated by its long lived connections, the others are lightly loaded.
+  Loads skewed;
+  skewed.fill({300, 100});
+  skewed[HOT] = {900, 1000};
+
+  Loads round_robin = skewed;
+  Loads load_aware  = skewed;
+
+  place(round_robin, N_CONNECTIONS, false);
+  place(load_aware, N_CONNECTIONS, true);
+
+  uint32_t rr_hot = round_robin[HOT].connections - skewed[HOT].connections;
+  uint32_t la_hot = load_aware[HOT].connections - skewed[HOT].connections;
+
+  INFO("new connections on the hot thread: round robin " << rr_hot << ", load aware " << la_hot);
+  CHECK(rr_hot == N_CONNECTIONS / N_THREADS);
+  // Only the connections that are offered nothing but the hot thread stay there.
+  CHECK(la_hot < rr_hot / 4);
+  CHECK(spread(load_aware) <= N_CONNECTIONS / N_THREADS / 20);
+}
+
+TEST_CASE("Connections even out when the busy times are close", "[placement]")
+{
+  constexpr int N_CONNECTIONS = 8000;
+
+  Loads close;
+  close.fill({300, 100});
+  close[HOT] = {350, 1000};
+
+  place(close, N_CONNECTIONS, true);
+
+  // Round robin would put N_CONNECTIONS / N_THREADS more there.
+  CHECK(close[HOT].connections - 1000 < N_CONNECTIONS / N_THREADS / 2);
+  CHECK(spread(close) <= N_CONNECTIONS / N_THREADS / 20);
+}
+
+TEST_CASE("The busy time is what the loop did not wait", "[placement]")
+{
+  using Slice = EThread::Metrics::Slice;
+
+  auto       metrics = std::make_unique<EThread::Metrics>();
+  ink_hrtime now     = ink_get_hrtime();
+  Slice     *current = &metrics->_slice[5];
+  Slice     *prev    = &metrics->_slice[4];
+
+  CHECK(metrics->busy_permille() == 0);
+
+  current->_duration._start = now;
+  metrics->current_slice.store(current);
+  CHECK(metrics->busy_permille() == 0);
+
+  SECTION("a whole second")
+  {
+    prev->_duration._start = (now / HRTIME_SECOND - 1) * HRTIME_SECOND;
+    prev->_idle            = HRTIME_MSECONDS(250);
+    CHECK(metrics->busy_permille() == 750);
+  }
+
+  SECTION("the part of the second after the first loop")
+  {
+    prev->_duration._start = (now / HRTIME_SECOND - 1) * HRTIME_SECOND + HRTIME_MSECONDS(500);
+    prev->_idle            = HRTIME_MSECONDS(250);
+    CHECK(metrics->busy_permille() == 500);
+  }
+
+  SECTION("a loop that has not come back")
+  {
+    prev->_duration._start    = (now / HRTIME_SECOND - 4) * HRTIME_SECOND;
+    prev->_idle               = HRTIME_SECOND;
+    current->_duration._start = now - HRTIME_SECONDS(3);
+    CHECK(metrics->busy_permille() == 1000);
+  }
+}
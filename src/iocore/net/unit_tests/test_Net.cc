@@ -23,6 +23,7 @@
 
 #include "iocore/net/NetProcessor.h"
 #include "iocore/net/NetVConnection.h"
+#include "../P_Net.h"
 
 #include <catch.hpp>
 
@@ -32,3 +33,38 @@ TEST_CASE("When we allocate a VC, it should not have a server name yet.")
   CHECK(nullptr == vc->get_server_name());
   vc->do_io_close();
 }
+
+TEST_CASE("A parked VC gives its idle buffers back.")
+{
+  auto           *vc     = static_cast<UnixNetVConnection *>(netProcessor.allocate_vc(this_ethread()));
+  MIOBuffer      *buf    = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+  IOBufferReader *reader = buf->alloc_reader();
+  vc->read.vio.buffer.writer_for(buf);
+
+  int64_t const active = vc->memory_footprint();
+  CHECK(active == static_cast<int64_t>(sizeof(*vc)) + BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_32K));
+
+  SECTION("buffer with unconsumed data is kept")
+  {
+    buf->write("GET", 3);
+    CHECK(vc->park() == 0);
+    CHECK(vc->memory_footprint() == active);
+    CHECK(reader->read_avail() == 3);
+  }
+
+  SECTION("idle buffer is released")
+  {
+    CHECK(vc->park() == BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_32K));
+    int64_t const idle = vc->memory_footprint();
+    CHECK(idle == static_cast<int64_t>(sizeof(*vc)));
+    INFO("bytes per connection: active " << active << ", idle " << idle);
+
+    // The buffer is usable again once data arrives.
+    buf->write("GET", 3);
+    CHECK(reader->read_avail() == 3);
+  }
+
+  vc->read.vio.buffer.clear();
+  free_MIOBuffer(buf);
+  vc->do_io_close();
+}
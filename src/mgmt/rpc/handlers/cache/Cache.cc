@@ -0,0 +1,86 @@
+/**
+   @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "mgmt/rpc/handlers/cache/Cache.h"
+#include "mgmt/rpc/handlers/common/ErrorUtils.h"
+#include "iocore/cache/Cache.h"
+
+namespace rpc::handlers::cache::field_names
+{
+static constexpr auto SURROGATE_KEYS{"surrogate_keys"};
+static constexpr auto URL_PREFIXES{"url_prefixes"};
+static constexpr auto SURROGATE_KEY{"surrogate_key"};
+static constexpr auto URL_PREFIX{"url_prefix"};
+static constexpr auto INDEXED{"indexed"};
+static constexpr auto PURGED{"purged"};
+static constexpr auto TIME{"time_us"};
+} // namespace rpc::handlers::cache::field_names
+
+namespace rpc::handlers::cache
+{
+namespace err   = rpc::handlers::errors;
+namespace field = field_names;
+
+namespace
+{
+using PurgeFn = bool (CacheProcessor::*)(std::string_view, CachePurgeResult &);
+
+/// Purge each of the names in @a names, appending a result for each to @a resp.
+bool
+purge_each(YAML::Node const &names, char const *kind, PurgeFn purge, swoc::Rv<YAML::Node> &resp)
+{
+  if (!names) {
+    return true;
+  }
+  for (auto &&it : names) {
+    std::string      name = it.as<std::string>();
+    CachePurgeResult result;
+
+    if (!(cacheProcessor.*purge)(name, result)) {
+      resp.errata().assign(std::error_code{err::Codes::CACHE}).note("The cache purge index is not enabled");
+      return false;
+    }
+
+    YAML::Node n;
+    n[kind]           = name;
+    n[field::INDEXED] = result.indexed;
+    n[field::PURGED]  = result.purged;
+    n[field::TIME]    = ink_hrtime_to_usec(result.time);
+    resp.result().push_back(std::move(n));
+  }
+  return true;
+}
+} // namespace
+
+swoc::Rv<YAML::Node>
+cache_purge(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params)
+{
+  swoc::Rv<YAML::Node> resp;
+
+  try {
+    if (purge_each(params[field::SURROGATE_KEYS], field::SURROGATE_KEY, &CacheProcessor::purge_surrogate_key, resp)) {
+      purge_each(params[field::URL_PREFIXES], field::URL_PREFIX, &CacheProcessor::purge_url_prefix, resp);
+    }
+  } catch (std::exception const &ex) {
+    resp.errata().assign(std::error_code{err::Codes::CACHE}).note("Invalid parameters: {}", ex.what());
+  }
+  return resp;
+}
+} // namespace rpc::handlers::cache
@@ -51,6 +51,8 @@ RPCHandlerLogicErrorCategory::message(int ev) const
     return {"Storage handling error."};
   case rpc::handlers::errors::Codes::PLUGIN:
     return {"Plugin handling error."};
+  case rpc::handlers::errors::Codes::CACHE:
+    return {"Cache handling error."};
   default:
     return "Generic handling error: " + std::to_string(ev);
   }
@@ -59,6 +59,7 @@ namespace rpc::handlers::records::utils
 // response request constants
 inline const std::string RECORD_NAME_REGEX_KEY{"record_name_regex"};
 inline const std::string RECORD_NAME_KEY{"record_name"};
+inline const std::string RECORD_NAME_PREFIX_KEY{"record_name_prefix"};
 inline const std::string RECORD_VALUE_KEY{"record_value"};
 inline const std::string RECORD_TYPES_KEY{"rec_types"};
 inline const std::string RECORD_UPDATE_TYPE_KEY{"update_type"};
@@ -176,4 +176,97 @@ template <> struct convert<RecRecord> {
   }
 };
 
+namespace detail
+{
+  // Scalars are emitted as text, the way a YAML::Node holds them.
+  inline std::string
+  scalar(int64_t value)
+  {
+    return std::to_string(value);
+  }
+  inline std::string
+  scalar(bool value)
+  {
+    return value ? "true" : "false";
+  }
+  inline std::string
+  scalar(RecFloat value)
+  {
+    return convert<RecFloat>::encode(value).Scalar();
+  }
+} // namespace detail
+
+///
+/// @brief Emit a RecRecord the same as @c convert<RecRecord> encodes it, without building the node first. This is used by the
+/// lookups that stream their result.
+///
+inline Emitter &
+operator<<(Emitter &json, const RecRecord &record)
+{
+  using detail::scalar;
+
+  json << BeginMap << Key << constants_rec::REC << Value << BeginMap;
+  json << Key << constants_rec::NAME << Value << (record.name ? record.name : "null");
+  json << Key << constants_rec::RECORD_TYPE << Value << scalar(static_cast<int64_t>(record.data_type));
+  json << Key << constants_rec::RECORD_VERSION << Value << scalar(static_cast<int64_t>(record.version));
+  json << Key << constants_rec::REGISTERED << Value << scalar(record.registered);
+  json << Key << constants_rec::RSB << Value << scalar(static_cast<int64_t>(record.rsb_id));
+  json << Key << constants_rec::ORDER << Value << scalar(static_cast<int64_t>(record.order));
+
+  if (REC_TYPE_IS_CONFIG(record.rec_type)) {
+    const RecConfigMeta &meta = record.config_meta;
+
+    json << Key << constants_rec::CONFIG_META << Value << BeginMap;
+    json << Key << constants_rec::ACCESS_TYPE << Value << scalar(static_cast<int64_t>(meta.access_type));
+    json << Key << constants_rec::UPDATE_STATUS << Value << scalar(static_cast<int64_t>(meta.update_required));
+    json << Key << constants_rec::UPDATE_TYPE << Value << scalar(static_cast<int64_t>(meta.update_type));
+    json << Key << constants_rec::CHECK_TYPE << Value << scalar(static_cast<int64_t>(meta.check_type));
+    json << Key << constants_rec::SOURCE << Value << scalar(static_cast<int64_t>(meta.source));
+    json << Key << constants_rec::CHECK_EXPR << Value << (meta.check_expr ? meta.check_expr : "null");
+    json << EndMap;
+  } else if (REC_TYPE_IS_STAT(record.rec_type)) {
+    json << Key << constants_rec::STAT_META << Value << BeginMap;
+    json << Key << constants_rec::PERSIST_TYPE << Value << scalar(static_cast<int64_t>(record.stat_meta.persist_type));
+    json << EndMap;
+  }
+
+  json << Key << constants_rec::CLASS << Value << scalar(static_cast<int64_t>(record.rec_type));
+
+  if (record.name) {
+    const auto it = ts::Overridable_Txn_Vars.find(record.name);
+    json << Key << constants_rec::OVERRIDABLE << Value << ((it == ts::Overridable_Txn_Vars.end()) ? "false" : "true");
+  }
+
+  switch (record.data_type) {
+  case RECD_INT:
+    json << Key << constants_rec::DATA_TYPE << Value << "INT";
+    json << Key << constants_rec::CURRENT_VALUE << Value << scalar(record.data.rec_int);
+    json << Key << constants_rec::DEFAULT_VALUE << Value << scalar(record.data_default.rec_int);
+    break;
+  case RECD_FLOAT:
+    json << Key << constants_rec::DATA_TYPE << Value << "FLOAT";
+    json << Key << constants_rec::CURRENT_VALUE << Value << scalar(record.data.rec_float);
+    json << Key << constants_rec::DEFAULT_VALUE << Value << scalar(record.data_default.rec_float);
+    break;
+  case RECD_STRING:
+    json << Key << constants_rec::DATA_TYPE << Value << "STRING";
+    json << Key << constants_rec::CURRENT_VALUE << Value << (record.data.rec_string ? record.data.rec_string : "null");
+    json << Key << constants_rec::DEFAULT_VALUE << Value
+         << (record.data_default.rec_string ? record.data_default.rec_string : "null");
+    break;
+  case RECD_COUNTER:
+    json << Key << constants_rec::DATA_TYPE << Value << "COUNTER";
+    json << Key << constants_rec::CURRENT_VALUE << Value << scalar(record.data.rec_counter);
+    json << Key << constants_rec::DEFAULT_VALUE << Value << scalar(record.data_default.rec_counter);
+    break;
+  default:
+    // this is an error, internal we should flag it
+    break;
+  }
+
+  json << EndMap << EndMap;
+
+  return json;
+}
+
 } // namespace YAML
@@ -22,8 +22,13 @@
 #include <system_error>
 #include <string>
 #include <string_view>
+#include <ostream>
+#include <strings.h>
+
+#include "tsutil/Regex.h"
 
 #include "../common/RecordsUtils.h"
+#include "../common/convert.h"
 // #include "common/yaml/codecs.h"
 ///
 /// @brief Local definitions to map requests and responsponses(not fully supported yet) to custom structures. All this definitions
@@ -38,9 +43,10 @@ const std::string ERROR_LIST_KEY{"errorList"};
 /// record requests.
 ///
 struct RequestRecordElement {
-  std::string      recName;        //!< Incoming record name, this is used for a regex as well.
-  bool             isRegex{false}; //!< set to true if the lookup should be done by using a regex instead a full name.
-  std::vector<int> recTypes;       //!< incoming rec_types
+  std::string      recName;         //!< Incoming record name, this is used for a regex or a prefix as well.
+  bool             isRegex{false};  //!< set to true if the lookup should be done by using a regex instead a full name.
+  bool             isPrefix{false}; //!< set to true if the lookup should be done by a name prefix instead a full name.
+  std::vector<int> recTypes;        //!< incoming rec_types
 
   /// @brief test if the requests is intended to use a regex.
   bool
@@ -48,6 +54,13 @@ struct RequestRecordElement {
   {
     return isRegex;
   }
+
+  /// @brief test if the requests is intended to match more than one record, by a regex or by a prefix.
+  bool
+  is_pattern_req() const
+  {
+    return isRegex || isPrefix;
+  }
 };
 
 ///
@@ -79,13 +92,15 @@ template <> struct convert<RequestRecordElement> {
   static bool
   decode(Node const &node, RequestRecordElement &info)
   {
-    if (!node[utils::RECORD_NAME_REGEX_KEY] && !node[utils::RECORD_NAME_KEY]) {
+    int keys = (node[utils::RECORD_NAME_REGEX_KEY] ? 1 : 0) + (node[utils::RECORD_NAME_PREFIX_KEY] ? 1 : 0) +
+               (node[utils::RECORD_NAME_KEY] ? 1 : 0);
+    if (keys == 0) {
       // if we don't get any specific name, seems a bit risky to send them all back. At least some * would be nice.
       return false;
     }
 
-    // if both are provided, we can't proceed.
-    if (node[utils::RECORD_NAME_REGEX_KEY] && node[utils::RECORD_NAME_KEY]) {
+    // if more than one is provided, we can't proceed.
+    if (keys > 1) {
       return false;
     }
 
@@ -118,6 +133,9 @@ template <> struct convert<RequestRecordElement> {
     if (auto n = node[utils::RECORD_NAME_REGEX_KEY]) {
       info.recName = n.as<std::string>();
       info.isRegex = true;
+    } else if (auto n = node[utils::RECORD_NAME_PREFIX_KEY]) {
+      info.recName  = n.as<std::string>();
+      info.isPrefix = true;
     } else {
       info.recName = node[utils::RECORD_NAME_KEY].as<std::string>();
       info.isRegex = false;
@@ -167,35 +185,92 @@ bitwise(std::vector<int> const &values)
 namespace utils = rpc::handlers::records::utils;
 namespace err   = rpc::handlers::errors;
 
-static auto
-find_record_by_name(RequestRecordElement const &element)
+///
+/// @brief The regexes and prefixes of a lookup, compiled once, and tested together in a single pass over the records.
+///
+class RecordFilters
 {
-  unsigned recType = bitwise(element.recTypes);
+public:
+  /// Add the pattern of @a element. @return false if it is not a valid regex.
+  bool
+  add(RequestRecordElement const &element)
+  {
+    Filter filter{bitwise(element.recTypes), element.recName, {}};
 
-  return utils::get_yaml_record(element.recName, [recType](RecT rec_type, std::error_code &ec) {
-    if ((recType & rec_type) == 0) {
-      ec = err::RecordError::REQUESTED_TYPE_MISMATCH;
+    if (element.is_regex_req() && !filter.regex.compile(element.recName, RE_CASE_INSENSITIVE)) {
       return false;
     }
+    filter.is_regex = element.is_regex_req();
+    _recType       |= filter.recType;
+    _filters.push_back(std::move(filter));
     return true;
-  });
-}
+  }
 
-static auto
-find_records_by_regex(RequestRecordElement const &element)
-{
-  unsigned recType = bitwise(element.recTypes);
+  bool
+  empty() const
+  {
+    return _filters.empty();
+  }
 
-  return utils::get_yaml_record_regex(element.recName, recType);
-}
+  /// The union of the record types of the filters.
+  unsigned
+  rec_type() const
+  {
+    return _recType;
+  }
 
-static auto
-find_records(RequestRecordElement const &element)
+  /// @return true if the record matches any of the filters.
+  bool
+  match(RecT rec_type, std::string_view name) const
+  {
+    for (auto const &filter : _filters) {
+      if ((filter.recType & rec_type) == 0) {
+        continue;
+      }
+      if (filter.is_regex) {
+        if (filter.regex.exec(name)) {
+          return true;
+        }
+      } else if (name.size() >= filter.prefix.size() && strncasecmp(name.data(), filter.prefix.data(), filter.prefix.size()) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct Filter {
+    unsigned    recType;
+    std::string prefix;
+    Regex       regex;
+    bool        is_regex{false};
+  };
+
+  std::vector<Filter> _filters;
+  unsigned            _recType{0};
+};
+
+/// State of the lookup, for the librecords callbacks.
+struct LookupContext {
+  YAML::Emitter  &json;
+  unsigned        recType{RECT_ALL}; //!< For lookups by name.
+  std::error_code ec;
+};
+
+void
+emit_record(const RecRecord *record, void *data)
 {
-  if (element.is_regex_req()) {
-    return find_records_by_regex(element);
+  auto &ctx = *static_cast<LookupContext *>(data);
+
+  if (!record) {
+    ctx.ec = err::RecordError::RECORD_NOT_FOUND;
+    return;
+  }
+  if ((ctx.recType & record->rec_type) == 0) {
+    ctx.ec = err::RecordError::REQUESTED_TYPE_MISMATCH;
+    return;
   }
-  return find_record_by_name(element);
+  ctx.json << *record;
 }
 
 } // namespace
@@ -204,11 +279,13 @@ namespace rpc::handlers::records
 {
 namespace err = rpc::handlers::errors;
 
-swoc::Rv<YAML::Node>
-lookup_records(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params)
+swoc::Errata
+lookup_records(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params, ResponseWriter &out)
 {
-  // TODO: we may want to deal with our own object instead of a node here.
-  YAML::Node recordList{YAML::NodeType::Sequence}, errorList{YAML::NodeType::Sequence};
+  // The errors are few, so they are kept until the records are written.
+  YAML::Node                        errorList{YAML::NodeType::Sequence};
+  std::vector<RequestRecordElement> names;
+  RecordFilters                     filters;
 
   for (auto &&node : params) {
     RequestRecordElement recordElement;
@@ -219,31 +296,52 @@ lookup_records(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &p
       continue;
     }
 
-    auto &&[recordNode, error] = find_records(recordElement);
-
-    if (error) {
-      ErrorInfo ei{error};
+    if (!recordElement.is_pattern_req()) {
+      names.push_back(std::move(recordElement));
+    } else if (!filters.add(recordElement)) {
+      ErrorInfo ei{err::RecordError::GENERAL_ERROR};
       ei.recordName = recordElement.recName;
 
       errorList.push_back(ei);
-      continue;
     }
+  }
 
-    // Regex lookup, will get us back a sequence, of nodes. In this case we will add them one by 1 so we get a list of objects and
-    // not a sequence inside the result object, this can be changed ofc but for now this is fine.
-    if (recordNode.IsSequence()) {
-      for (auto &&n : recordNode) {
-        recordList.push_back(std::move(n));
-      }
-    } else if (recordNode.IsMap()) {
-      recordList.push_back(std::move(recordNode));
+  // The records are emitted straight to the response, rather than into a node for all of them first.
+  ResponseStreamBuf buf{out};
+  std::ostream      stream{&buf};
+  YAML::Emitter     json{stream};
+
+  json << YAML::DoubleQuoted << YAML::Flow << YAML::BeginMap;
+  json << YAML::Key << RECORD_LIST_KEY << YAML::Value << YAML::BeginSeq;
+
+  for (auto const &element : names) {
+    LookupContext ctx{json, bitwise(element.recTypes)};
+
+    if (RecLookupRecord(element.recName.c_str(), emit_record, &ctx) != REC_ERR_OKAY && !ctx.ec) {
+      ctx.ec = err::RecordError::RECORD_NOT_FOUND;
+    }
+    if (ctx.ec) {
+      ErrorInfo ei{ctx.ec};
+      ei.recordName = element.recName;
+
+      errorList.push_back(ei);
     }
   }
 
-  YAML::Node resp;
+  // All the patterns are matched in one pass, so a record that matches more than one of them is listed once.
+  if (!filters.empty()) {
+    LookupContext ctx{json};
+
+    RecLookupMatchingRecords(
+      filters.rec_type(), [&filters](RecT rec_type, std::string_view name) { return filters.match(rec_type, name); }, emit_record,
+      &ctx);
+  }
+
   // Even if the records/errors are an empty list, we want them in the response.
-  resp[RECORD_LIST_KEY] = recordList;
-  resp[ERROR_LIST_KEY]  = errorList;
-  return resp;
+  json << YAML::EndSeq;
+  json << YAML::Key << ERROR_LIST_KEY << YAML::Value << errorList;
+  json << YAML::EndMap;
+
+  return {};
 }
 } // namespace rpc::handlers::records
@@ -22,6 +22,7 @@
 
 #include "../../../../iocore/cache/P_Cache.h"
 #include <tscore/TSSystemState.h>
+#include "iocore/eventsystem/LockProfiler.h"
 #include "mgmt/rpc/handlers/common/ErrorUtils.h"
 #include "mgmt/rpc/handlers/common/Utils.h"
 
@@ -30,6 +31,8 @@ namespace rpc::handlers::server
 namespace field_names
 {
   static constexpr auto NEW_CONNECTIONS{"no_new_connections"};
+  static constexpr auto TOP{"top"};
+  static constexpr auto RESET{"reset"};
 } // namespace field_names
 
 struct DrainInfo {
@@ -120,4 +123,72 @@ server_shutdown(YAML::Node const &)
 {
   sync_cache_dir_on_shutdown();
 }
+
+swoc::Rv<YAML::Node>
+get_lock_contention(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params)
+{
+  namespace field = field_names;
+  namespace utils = rpc::handlers::utils;
+
+  swoc::Rv<YAML::Node> resp;
+  size_t               top   = 10;
+  bool                 reset = false;
+
+  try {
+    if (params.IsMap()) {
+      if (auto n = params[field::TOP]; n) {
+        top = n.as<size_t>();
+      }
+      reset = utils::is_true_flag(params[field::RESET]);
+    }
+  } catch (std::exception const &ex) {
+    resp.errata().assign(std::error_code{errors::Codes::SERVER}).note("Invalid lock contention parameters: {}", ex.what());
+    return resp;
+  }
+
+  auto report = LockProfiler::report(top);
+
+  if (reset) {
+    LockProfiler::reset();
+  }
+
+  YAML::Node &result    = resp.result();
+  result["enabled"]     = LockProfiler::enabled();
+  result["sample_rate"] = LockProfiler::sample_rate();
+  result["dropped"]     = report.dropped;
+  result["classes"]     = YAML::Node{YAML::NodeType::Sequence};
+  result["sites"]       = YAML::Node{YAML::NodeType::Sequence};
+
+  for (auto &c : report.classes) {
+    YAML::Node node, histogram{YAML::NodeType::Sequence};
+
+    // Only the buckets with samples, by the smallest wait that falls in each.
+    for (unsigned idx = 0; idx < LockProfiler::WaitHistogram::N_BUCKETS; ++idx) {
+      if (auto count = c.wait_histogram[idx]; count > 0) {
+        YAML::Node bucket;
+        bucket["min_us"] = LockProfiler::WaitHistogram::min_for_bucket(idx);
+        bucket["count"]  = count;
+        histogram.push_back(bucket);
+      }
+    }
+    node["name"]           = std::string{c.name};
+    node["try_failures"]   = c.try_failures;
+    node["waits"]          = c.waits;
+    node["wait_time_us"]   = ink_hrtime_to_usec(c.wait_time);
+    node["wait_histogram"] = histogram;
+    result["classes"].push_back(node);
+  }
+  for (auto const &s : report.sites) {
+    YAML::Node node;
+
+    node["lock_class"]   = std::string{s.lock_class};
+    node["site"]         = std::string{s.site};
+    node["holder"]       = std::string{s.holder};
+    node["try_failures"] = s.try_failures;
+    node["waits"]        = s.waits;
+    node["wait_time_us"] = ink_hrtime_to_usec(s.wait_time);
+    result["sites"].push_back(node);
+  }
+  return resp;
+}
 } // namespace rpc::handlers::server
@@ -47,6 +47,87 @@ const std::string RPC_SERVICE_N_A_STR{"N/A"};
 // jsonrpc log tag.
 constexpr auto logTag    = "rpc";
 constexpr auto logTagMsg = "rpc.msg";
+
+///
+/// @brief Writes the responses of a call, within brackets and separated, if the call is a batch.
+///
+class BatchWriter
+{
+public:
+  BatchWriter(rpc::ResponseWriter &out, bool batch) : _out(out), _batch(batch) {}
+
+  /// Start the next response.
+  rpc::ResponseWriter &
+  next()
+  {
+    if (_batch) {
+      _out.write(_count == 0 ? "[" : ", ");
+    }
+    ++_count;
+    return _out;
+  }
+
+  /// Close the batch. @return true if any response was written.
+  bool
+  finish()
+  {
+    if (_batch && _count > 0) {
+      _out.write("]");
+    }
+    return _count > 0;
+  }
+
+private:
+  rpc::ResponseWriter &_out;
+  bool                 _batch;
+  int                  _count{0};
+};
+
+///
+/// @brief Writer handed to a streaming method. The response, up to the result, is written ahead of the first thing the method
+/// writes, so that if it writes nothing, it can still fail with a regular error response.
+///
+class ResultWriter : public rpc::ResponseWriter
+{
+public:
+  ResultWriter(BatchWriter &batch, std::string const &id) : _batch(batch), _id(id) {}
+
+  using rpc::ResponseWriter::write;
+  void
+  write(std::string_view data) override
+  {
+    if (!_out) {
+      _out = &_batch.next();
+      _out->write(R"({"jsonrpc": ")" + rpc::specs::JSONRPC_VERSION + R"(", "result": )");
+    }
+    _out->write(data);
+  }
+
+  /// @return true if the method wrote its result.
+  bool
+  started() const
+  {
+    return _out != nullptr;
+  }
+
+  /// Write the rest of the response, after the result.
+  void
+  finish()
+  {
+    YAML::Emitter json;
+    json << YAML::DoubleQuoted << YAML::Flow << YAML::BeginMap << YAML::Key << "id" << YAML::Value << _id << YAML::EndMap;
+    // The id, as the codec writes it, without the braces of the map.
+    std::string_view id{json.c_str(), json.size()};
+    _out->write(", ");
+    _out->write(id.substr(1, id.size() - 2));
+    _out->write("}");
+  }
+
+private:
+  BatchWriter         &_batch;
+  std::string const   &_id;
+  rpc::ResponseWriter *_out{nullptr};
+};
 } // namespace
 
 namespace rpc
@@ -99,7 +180,7 @@ JsonRPCManager::Dispatcher::register_service_descriptor_handler()
 }
 
 JsonRPCManager::Dispatcher::response_type
-JsonRPCManager::Dispatcher::dispatch(Context const &ctx, specs::RPCRequestInfo const &request) const
+JsonRPCManager::Dispatcher::dispatch(Context const &ctx, specs::RPCRequestInfo const &request, ResponseWriter &result) const
 {
   std::error_code ec;
   auto const     &handler = find_handler(request, ec);
@@ -123,7 +204,7 @@ JsonRPCManager::Dispatcher::dispatch(Context const &ctx, specs::RPCRequestInfo c
   }
 
   // just a method call.
-  return invoke_method_handler(handler, request);
+  return invoke_method_handler(handler, request, result);
 }
 
 JsonRPCManager::Dispatcher::InternalHandler const &
@@ -150,12 +231,12 @@ JsonRPCManager::Dispatcher::find_handler(specs::RPCRequestInfo const &request, s
 
 JsonRPCManager::Dispatcher::response_type
 JsonRPCManager::Dispatcher::invoke_method_handler(JsonRPCManager::Dispatcher::InternalHandler const &handler,
-                                                  specs::RPCRequestInfo const                       &request) const
+                                                  specs::RPCRequestInfo const &request, ResponseWriter &result) const
 {
   specs::RPCResponseInfo response{request.id};
 
   try {
-    auto rv = handler.invoke(request);
+    auto rv = handler.invoke(request, result);
 
     if (rv.is_ok()) {
       response.callResult.result = rv.result();
@@ -176,7 +257,9 @@ JsonRPCManager::Dispatcher::invoke_notification_handler(JsonRPCManager::Dispatch
                                                         specs::RPCRequestInfo const                       &notification) const
 {
   try {
-    handler.invoke(notification);
+    std::string          ignored;
+    StringResponseWriter out{ignored};
+    handler.invoke(notification, out);
   } catch (std::exception const &e) {
     Debug(logTag, "Oops, something happened during the callback(notification) invocation: %s", e.what());
     // it's a notification so we do not care much.
@@ -206,6 +289,21 @@ JsonRPCManager::remove_handler(std::string_view name)
 
 std::optional<std::string>
 JsonRPCManager::handle_call(Context const &ctx, std::string const &request)
+{
+  std::string          resp;
+  StringResponseWriter out{resp};
+
+  if (!handle_call(ctx, request, out)) {
+    // We will not have a response for notification(s); This could be a batch of notifications only.
+    return std::nullopt;
+  }
+  Debug(logTagMsg, "<-- JSONRPC Response\n '%s'", resp.c_str());
+
+  return resp;
+}
+
+bool
+JsonRPCManager::handle_call(Context const &ctx, std::string const &request, ResponseWriter &out)
 {
   Debug(logTagMsg, "--> JSONRPC request\n'%s'", request.c_str());
 
@@ -219,10 +317,12 @@ JsonRPCManager::handle_call(Context const &ctx, std::string const &request)
     if (ec) {
       specs::RPCResponseInfo resp;
       resp.error.ec = ec;
-      return Encoder::encode(resp);
+      out.write(Encoder::encode(resp));
+      return true;
     }
 
-    specs::RPCResponse response{msg.is_batch()};
+    // Each response is written as soon as it is ready, rather than the whole batch at the end.
+    BatchWriter batch{out, msg.is_batch()};
     for (auto const &[req, decode_error] : msg.get_messages()) {
       // As per jsonrpc specs we do care about invalid messages as long as they are well-formed,  our decode logic will make their
       // best to build up a request, if any errors were detected during decoding, we will save the error and make it part of the
@@ -230,12 +330,19 @@ JsonRPCManager::handle_call(Context const &ctx, std::string const &request)
       if (!decode_error) {
         // request seems ok and ready to be dispatched. The dispatcher will tell us if the method exist and if so, it will dispatch
         // the call and gives us back the response.
-        auto encodedResponse = _dispatcher.dispatch(ctx, req);
-
-        if (encodedResponse) {
+        ResultWriter result{batch, req.id};
+        auto         encodedResponse = _dispatcher.dispatch(ctx, req, result);
+
+        if (result.started()) {
+          // A streaming method wrote its result, any error it reported after that can only be logged.
+          if (encodedResponse && (encodedResponse->error.ec || !encodedResponse->callResult.errata.is_ok())) {
+            Debug(logTag, "Error from '%s' after its result was written, the response is incomplete.", req.method.c_str());
+          }
+          result.finish();
+        } else if (encodedResponse) {
           // if any error was detected during invocation or before, the response will have the error field set, so this will
           // internally be converted to the right response type.
-          response.add_message(std::move(*encodedResponse));
+          batch.next().write(Encoder::encode(*encodedResponse));
         } // else it's a notification and no error.
 
       } else {
@@ -243,31 +350,25 @@ JsonRPCManager::handle_call(Context const &ctx, std::string const &request)
         specs::RPCResponseInfo resp{req.id};
         // resp.error.assign(swoc::Errata(decode_error));
         resp.error.ec = decode_error;
-        response.add_message(std::move(resp));
+        batch.next().write(Encoder::encode(resp));
       }
     }
 
-    // We will not have a response for notification(s); This could be a batch of notifications only.
-    std::optional<std::string> resp;
-
-    if (!response.is_notification()) {
-      resp = Encoder::encode(response);
-      Debug(logTagMsg, "<-- JSONRPC Response\n '%s'", (*resp).c_str());
-    }
-
-    return resp;
+    return batch.finish();
   } catch (std::exception const &ex) {
     ec = error::RPCErrorCode::INTERNAL_ERROR;
   }
 
   specs::RPCResponseInfo resp;
   resp.error.ec = ec;
-  return {Encoder::encode(resp)};
+  out.write(Encoder::encode(resp));
+
+  return true;
 }
 
 // ---------------------------- InternalHandler ---------------------------------
 inline swoc::Rv<YAML::Node>
-JsonRPCManager::Dispatcher::InternalHandler::invoke(specs::RPCRequestInfo const &request) const
+JsonRPCManager::Dispatcher::InternalHandler::invoke(specs::RPCRequestInfo const &request, ResponseWriter &result) const
 {
   swoc::Rv<YAML::Node> ret;
   std::visit(swoc::meta::vary{[](std::monostate) -> void { /* no op */ },
@@ -293,6 +394,10 @@ JsonRPCManager::Dispatcher::InternalHandler::invoke(specs::RPCRequestInfo const
                                 // swoc::Rv this will handle both, error and success cases.
                                 ret = std::move(g_rpcHandlerResponseData);
                                 lock.unlock();
+                              },
+                              [&ret, &request, &result](StreamingMethod const &handler) -> void {
+                                // The result goes straight to the writer, only an error comes back.
+                                ret.errata() = handler.cb(request.id, request.params, result);
                               }},
              this->_func);
   return ret;
@@ -305,6 +410,7 @@ JsonRPCManager::Dispatcher::InternalHandler::is_method() const
   switch (index) {
   case VariantTypeIndexId::METHOD:
   case VariantTypeIndexId::METHOD_FROM_PLUGIN:
+  case VariantTypeIndexId::STREAMING_METHOD:
     return true;
     break;
   default:;
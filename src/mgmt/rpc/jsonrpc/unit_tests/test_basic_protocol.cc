@@ -49,6 +49,12 @@ struct JsonRpcUnitTest : rpc::JsonRPCManager {
   {
     return base::add_method_handler(name, std::forward<Func>(call), nullptr, {});
   }
+  template <typename Func>
+  bool
+  add_streaming_method_handler(const std::string &name, Func &&call)
+  {
+    return base::add_streaming_method_handler(name, std::forward<Func>(call), nullptr, {});
+  }
 
   std::optional<std::string>
   handle_call(std::string const &jsonString)
@@ -608,3 +614,60 @@ TEST_CASE("Call method with invalid ID", "[invalid_id]")
     REQUIRE(*resp == expected);
   }
 }
+
+TEST_CASE("Register/call streaming method", "[method][streaming]")
+{
+  JsonRpcUnitTest rpc;
+
+  // Writes the params back, a piece at a time, or fails before it writes anything.
+  REQUIRE(rpc.add_streaming_method_handler(
+    "test_streaming", [](std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params, rpc::ResponseWriter &out) {
+      swoc::Errata errata;
+      if (params["return_error"].as<std::string>() == "yes") {
+        errata.assign(ERR1).note(err);
+        return errata;
+      }
+      out.write("{\"list\": [");
+      for (int i = 0; i < params["count"].as<int>(); ++i) {
+        if (i > 0) {
+          out.write(", ");
+        }
+        YAML::Node n;
+        n["i"] = i;
+        out.write(n);
+      }
+      out.write("]}");
+      return errata;
+    }));
+  REQUIRE(rpc.add_method_handler("test_callback_ok_or_error", &test_callback_ok_or_error));
+
+  SECTION("The result is the same as a regular method's")
+  {
+    const auto json =
+      rpc.handle_call(R"({"jsonrpc": "2.0", "method": "test_streaming", "params": {"return_error": "no", "count": 3}, "id": "15"})");
+    REQUIRE(json);
+    const std::string_view expected = R"({"jsonrpc": "2.0", "result": {"list": [{"i": "0"}, {"i": "1"}, {"i": "2"}]}, "id": "15"})";
+    REQUIRE(*json == expected);
+  }
+
+  SECTION("An error before anything is written is a regular error response")
+  {
+    const auto json =
+      rpc.handle_call(R"({"jsonrpc": "2.0", "method": "test_streaming", "params": {"return_error": "yes", "count": 3}, "id": "16"})");
+    REQUIRE(json);
+    const std::string_view expected =
+      R"({"jsonrpc": "2.0", "error": {"code": 9, "message": "Error during execution", "data": [{"code": 9999, "message": "Just an error message to add more meaning to the failure"}]}, "id": "16"})";
+    REQUIRE(*json == expected);
+  }
+
+  SECTION("In a batch, with other methods")
+  {
+    const auto json = rpc.handle_call(
+      R"([{"jsonrpc": "2.0", "method": "test_callback_ok_or_error", "params": {"return_error": "no"}, "id": "17"})"
+      R"(,{"jsonrpc": "2.0", "method": "test_streaming", "params": {"return_error": "no", "count": 0}, "id": "18"}])");
+    REQUIRE(json);
+    const std::string_view expected =
+      R"([{"jsonrpc": "2.0", "result": {"ran": "ok"}, "id": "17"}, {"jsonrpc": "2.0", "result": {"list": []}, "id": "18"}])";
+    REQUIRE(*json == expected);
+  }
+}
@@ -29,6 +29,7 @@
 #include <memory>
 #include <optional>
 #include <chrono>
+#include <cctype>
 #include <cerrno>
 #include <cstring>
 #include <system_error>
@@ -47,8 +48,111 @@
 namespace
 {
 constexpr size_t MAX_REQUEST_BUFFER_SIZE{32000};
+// The responses are written out in pieces of about this size, so that a large one is not held whole in memory.
+constexpr size_t RESPONSE_FLUSH_SIZE{64 * 1024};
 constexpr auto   logTag = "rpc.net";
 
+///
+/// @brief The size of the json text at the start of @a data, if it is a whole object or array. 0 if it is not whole yet, or if it
+/// is not an object or an array, which the decoder is left to report.
+///
+/// This only finds where a request ends, so that more than one can be read from a connection.
+///
+size_t
+json_text_size(std::string_view data)
+{
+  int  depth{0};
+  bool in_string{false};
+  bool escape{false};
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    char c = data[i];
+
+    if (in_string) {
+      if (escape) {
+        escape = false;
+      } else if (c == '\\') {
+        escape = true;
+      } else if (c == '"') {
+        in_string = false;
+      }
+      continue;
+    }
+
+    switch (c) {
+    case '{':
+    case '[':
+      ++depth;
+      break;
+    case '}':
+    case ']':
+      if (--depth <= 0) {
+        return depth == 0 ? i + 1 : 0;
+      }
+      break;
+    case '"':
+      if (depth == 0) {
+        return 0;
+      }
+      in_string = true;
+      break;
+    default:
+      if (depth == 0 && !isspace(static_cast<unsigned char>(c))) {
+        return 0;
+      }
+      break;
+    }
+  }
+
+  return 0;
+}
+
+std::string_view
+skip_space(std::string_view data)
+{
+  while (!data.empty() && isspace(static_cast<unsigned char>(data.front()))) {
+    data.remove_prefix(1);
+  }
+  return data;
+}
+
+///
+/// @brief Writes the responses to the client, buffered.
+///
+template <typename Client> class ClientResponseWriter : public rpc::ResponseWriter
+{
+public:
+  explicit ClientResponseWriter(Client &client) : _client(client) {}
+
+  using rpc::ResponseWriter::write;
+  void
+  write(std::string_view data) override
+  {
+    _buffer.append(data);
+    if (_buffer.size() >= RESPONSE_FLUSH_SIZE) {
+      flush();
+    }
+  }
+
+  void
+  flush()
+  {
+    if (_buffer.empty() || _ec) {
+      return;
+    }
+    // After an error, the rest of the responses are dropped, the client is gone.
+    if (_client.write(_buffer, _ec); _ec) {
+      Debug(logTag, "Error sending the response: %s", _ec.message().c_str());
+    }
+    _buffer.clear();
+  }
+
+private:
+  Client         &_client;
+  std::string     _buffer;
+  std::error_code _ec;
+};
+
 // Quick check for errors(base on the errno);
 bool check_for_transient_errors();
 
@@ -219,24 +323,13 @@ IPCSocketServer::run()
 
     std::error_code ec;
     if (int fd = this->accept(ec); !ec) {
-      Client client{fd};
-
-      if (auto [ok, errStr] = client.read_all(bw); ok) {
-        const auto   json = std::string{bw.data(), bw.size()};
-        rpc::Context ctx;
-        // we want to make sure the peer's credentials are ok.
-        ctx.get_auth().add_checker(
-          [&](TSRPCHandlerOptions const &opt, swoc::Errata &errata) -> void { late_check_peer_credentials(fd, opt, errata); });
-
-        if (auto response = rpc::JsonRPCManager::instance().handle_call(ctx, json); response) {
-          // seems a valid response.
-          if (client.write(*response, ec); ec) {
-            Debug(logTag, "Error sending the response: %s", ec.message().c_str());
-          }
-        } // it was a notification.
-      } else {
-        Debug(logTag, "Error detected while reading: %s", errStr.c_str());
-      }
+      Client       client{fd};
+      rpc::Context ctx;
+      // we want to make sure the peer's credentials are ok.
+      ctx.get_auth().add_checker(
+        [&](TSRPCHandlerOptions const &opt, swoc::Errata &errata) -> void { late_check_peer_credentials(fd, opt, errata); });
+
+      this->handle_client(client, ctx, bw);
     } else {
       Debug(logTag, "Error while accepting a new connection on the socket: %s", ec.message().c_str());
     }
@@ -247,6 +340,61 @@ IPCSocketServer::run()
   this->close();
 }
 
+void
+IPCSocketServer::handle_client(Client &client, rpc::Context const &ctx, swoc::FixedBufferWriter &bw) const
+{
+  ClientResponseWriter<Client> out{client};
+  std::string                  errStr;
+
+  auto handle_call = [&](std::string_view request) {
+    // Notifications have no response.
+    rpc::JsonRPCManager::instance().handle_call(ctx, std::string{request}, out);
+  };
+
+  for (;;) {
+    auto status = client.read_all(bw, errStr);
+
+    if (status == Client::ReadStatus::READ_ERROR) {
+      Debug(logTag, "Error detected while reading: %s", errStr.c_str());
+      break;
+    }
+
+    // Answer every whole request read so far, in order. A client may send more than one without waiting for the responses.
+    std::string_view data{bw.data(), bw.size()};
+    size_t           used{0};
+    for (size_t n; (n = json_text_size(data.substr(used))) > 0; used += n) {
+      handle_call(data.substr(used, n));
+    }
+    std::string_view rest = skip_space(data.substr(used));
+
+    if (status == Client::ReadStatus::PEER_CLOSED) {
+      // Whatever is left is not a whole request, and will not be.
+      if (!rest.empty() || used == 0) {
+        Debug(logTag, "Error detected while reading: %s", errStr.c_str());
+      }
+      break;
+    }
+    if (status == Client::ReadStatus::NO_MORE_DATA) {
+      // No more data is coming, what is left is handled as is, if it's not a valid request the decoder will say so.
+      if (!rest.empty()) {
+        handle_call(rest);
+      }
+      break;
+    }
+    // The buffer is full, if there is no whole request in it there never will be.
+    if (used == 0) {
+      Debug(logTag, "Error detected while reading: %s", errStr.c_str());
+      break;
+    }
+    // Keep what is left of the next request, and read the rest of it.
+    bw.clear();
+    std::memmove(bw.aux_data(), rest.data(), rest.size());
+    bw.commit(rest.size());
+  }
+
+  out.flush();
+}
+
 bool
 IPCSocketServer::stop()
 {
@@ -394,47 +542,61 @@ IPCSocketServer::Client::read(swoc::MemSpan<char> span) const
   return ::read(_fd, span.data(), span.size());
 }
 
-std::tuple<bool, std::string>
-IPCSocketServer::Client::read_all(swoc::FixedBufferWriter &bw) const
+IPCSocketServer::Client::ReadStatus
+IPCSocketServer::Client::read_all(swoc::FixedBufferWriter &bw, std::string &error) const
 {
-  std::string buff;
+  using namespace std::chrono_literals;
+
+  // Data left in the buffer is the start of a request, wait for the rest of it as for any other chunk.
+  if (bw.size() && !this->poll_for_data(1ms)) {
+    return ReadStatus::NO_MORE_DATA;
+  }
+
   while (bw.remaining() > 0) {
     auto ret = read({bw.aux_data(), bw.remaining()});
     if (ret < 0) {
       if (check_for_transient_errors()) {
         continue;
       } else {
-        return {false, swoc::bwprint(buff, "Error reading the socket: {}", swoc::bwf::Errno{})};
+        swoc::bwprint(error, "Error reading the socket: {}", swoc::bwf::Errno{});
+        return ReadStatus::READ_ERROR;
       }
     }
 
     if (ret == 0) {
       if (bw.size()) {
-        return {false, swoc::bwprint(buff, "Peer disconnected after reading {} bytes.", bw.size())};
+        swoc::bwprint(error, "Peer disconnected after reading {} bytes.", bw.size());
+      } else {
+        swoc::bwprint(error, "Peer disconnected. EOF");
       }
-      return {false, swoc::bwprint(buff, "Peer disconnected. EOF")};
+      return ReadStatus::PEER_CLOSED;
     }
     bw.commit(ret);
     if (bw.remaining() > 0) {
-      using namespace std::chrono_literals;
       if (!this->poll_for_data(1ms)) {
-        return {true, buff};
+        return ReadStatus::NO_MORE_DATA;
       }
       continue;
-    } else {
-      swoc::bwprint(buff, "Buffer is full, we hit the limit: {}", bw.capacity());
-      break;
     }
   }
 
-  return {false, buff};
+  swoc::bwprint(error, "Buffer is full, we hit the limit: {}", bw.capacity());
+  return ReadStatus::BUFFER_FULL;
 }
 
 void
-IPCSocketServer::Client::write(std::string const &data, std::error_code &ec) const
+IPCSocketServer::Client::write(std::string_view data, std::error_code &ec) const
 {
-  if (::write(_fd, data.c_str(), data.size()) < 0) {
-    ec = std::make_error_code(static_cast<std::errc>(errno));
+  while (!data.empty()) {
+    auto ret = ::write(_fd, data.data(), data.size());
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ec = std::make_error_code(static_cast<std::errc>(errno));
+      return;
+    }
+    data.remove_prefix(ret);
   }
 }
 IPCSocketServer::Config::Config()
@@ -173,6 +173,13 @@ struct ScopedLocalSocket : shared::rpc::IPCSocketClient {
     }
   }
 
+  // Tell the server there are no more requests.
+  void
+  shutdown_write()
+  {
+    ::shutdown(_sock, SHUT_WR);
+  }
+
   // basic read, if fail, why it fail is irrelevant in this test.
   std::string
   read()
@@ -422,6 +429,51 @@ TEST_CASE("Test with chunks - incomplete message", "[socket][chunks]")
   REQUIRE(rpc::test_remove_handler("do_nothing"));
 }
 
+TEST_CASE("Test with pipelined requests", "[socket][pipeline]")
+{
+  REQUIRE(rpc::add_method_handler("do_nothing", &do_nothing));
+
+  auto request = [](int size, std::string_view id) {
+    return R"({"jsonrpc": "2.0", "method": "do_nothing", "params": { "msg": ")" + random_string(size) + R"("}, "id": ")" +
+           std::string{id} + R"("})";
+  };
+  auto response = [](int size, std::string_view id) {
+    return R"({"jsonrpc": "2.0", "result": {"size": ")" + std::to_string(size) + R"("}, "id": ")" + std::string{id} + R"("})";
+  };
+
+  SECTION("Sending requests back to back, then shutting down the writing side")
+  {
+    REQUIRE_NOTHROW([&]() {
+      ScopedLocalSocket rpc_client;
+      rpc_client.connect();
+      rpc_client.send_in_chunks<3>(request(10, "pipe-1") + "\n" + request(20, "pipe-2") + request(30, "pipe-3"));
+      rpc_client.shutdown_write();
+      auto resp = rpc_client.read();
+      REQUIRE(resp == response(10, "pipe-1") + response(20, "pipe-2") + response(30, "pipe-3"));
+    }());
+  }
+
+  SECTION("Sending more requests than the server's buffer holds")
+  {
+    // 10 of 4000 bytes each, more than the 32000 the server reads at once.
+    std::string requests, expected;
+    for (int i = 0; i < 10; ++i) {
+      requests += request(4000, "pipe-big-" + std::to_string(i));
+      expected += response(4000, "pipe-big-" + std::to_string(i));
+    }
+    REQUIRE_NOTHROW([&]() {
+      ScopedLocalSocket rpc_client;
+      rpc_client.connect();
+      rpc_client.send_in_chunks<1>(requests);
+      rpc_client.shutdown_write();
+      auto resp = rpc_client.read();
+      REQUIRE(resp == expected);
+    }());
+  }
+
+  REQUIRE(rpc::test_remove_handler("do_nothing"));
+}
+
 // Enable toggle
 TEST_CASE("Test rpc enable toggle feature - default enabled.", "[default values]")
 {
@@ -139,6 +139,7 @@ bool
 reloadUrlRewrite()
 {
   UrlRewrite *newTable, *oldTable;
+  ink_hrtime  start = ink_get_hrtime();
 
   Note("%s loading ...", ts::filename::REMAP);
   Dbg(dbg_ctl_url_rewrite, "%s updated, reloading...", ts::filename::REMAP);
@@ -157,6 +158,8 @@ reloadUrlRewrite()
     // Release the old one
     oldTable->release();
 
+    Dbg(dbg_ctl_url_rewrite, "%s: %d rules loaded in %" PRId64 " ms, generation %" PRIu64, ts::filename::REMAP,
+        newTable->rule_count(), ink_hrtime_to_msec(ink_get_hrtime() - start), newTable->generation());
     Dbg(dbg_ctl_url_rewrite, msg_format, ts::filename::REMAP);
     Note(msg_format, ts::filename::REMAP);
     return true;
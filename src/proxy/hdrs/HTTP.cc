@@ -2033,9 +2033,9 @@ HTTPCacheAlt::copy(HTTPCacheAlt *to_copy)
 {
   m_magic = to_copy->m_magic;
   // m_writeable =      to_copy->m_writeable;
-  m_unmarshal_len = to_copy->m_unmarshal_len;
-  m_id            = to_copy->m_id;
-  m_rid           = to_copy->m_rid;
+  m_unmarshal_len    = to_copy->m_unmarshal_len;
+  m_id               = to_copy->m_id;
+  m_vary_fingerprint = to_copy->m_vary_fingerprint;
   memcpy(&m_object_key[0], &to_copy->m_object_key[0], CRYPTO_HASH_SIZE);
   m_object_size[0] = to_copy->m_object_size[0];
   m_object_size[1] = to_copy->m_object_size[1];
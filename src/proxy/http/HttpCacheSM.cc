@@ -204,7 +204,10 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
     break;
 
   case CACHE_EVENT_OPEN_WRITE_FAILED: {
-    if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
+    // A write the cache did not admit fails the same way again, it is not retried.
+    bool not_admitted = reinterpret_cast<intptr_t>(data) == -ECACHE_NOT_ADMITTED;
+
+    if (!not_admitted && master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
       // fall back to open_read_tries
       // Note that when CACHE_WL_FAIL_ACTION_READ_RETRY is configured, max_cache_open_write_retries
       // is automatically ignored. Make sure to not disable max_cache_open_read_retries
@@ -232,7 +235,7 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
       }
     }
 
-    if (read_retry_on_write_fail || !write_retry_done()) {
+    if (!not_admitted && (read_retry_on_write_fail || !write_retry_done())) {
       // Retry open write;
       open_write_cb = false;
       do_schedule_in();
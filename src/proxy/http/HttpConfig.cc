@@ -987,6 +987,7 @@ HttpConfig::startup()
   HttpEstablishStaticConfigLongLong(c.max_post_size, "proxy.config.http.max_post_size");
   HttpEstablishStaticConfigLongLong(c.max_payload_iobuf_index, "proxy.config.payload.io.max_buffer_index");
   HttpEstablishStaticConfigLongLong(c.max_msg_iobuf_index, "proxy.config.msg.io.max_buffer_index");
+  HttpEstablishStaticConfigByte(c.adaptive_buffer_sizing, "proxy.config.http.adaptive_buffer_sizing");
 
   // ##############################################################################
   // #
@@ -1238,6 +1239,7 @@ HttpConfig::reconfigure()
   params->max_post_size                  = m_master.max_post_size;
   params->max_payload_iobuf_index        = m_master.max_payload_iobuf_index;
   params->max_msg_iobuf_index            = m_master.max_msg_iobuf_index;
+  params->adaptive_buffer_sizing         = INT_TO_BOOL(m_master.adaptive_buffer_sizing);
 
   params->oride.cache_required_headers = m_master.oride.cache_required_headers;
   params->oride.cache_range_lookup     = INT_TO_BOOL(m_master.oride.cache_range_lookup);
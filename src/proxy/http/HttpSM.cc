@@ -2447,6 +2447,13 @@ HttpSM::state_cache_open_write(int event, void *data)
       t_state.cache_info.write_lock_state  = HttpTransact::CACHE_WL_FAIL;
       break;
     }
+    // The object is not requested often enough to be written, serve it from the origin.
+    if (cache_sm.get_last_error() == -ECACHE_NOT_ADMITTED) {
+      SMDbg(dbg_ctl_http, "CACHE_EVENT_OPEN_WRITE_FAILED, write not admitted");
+      t_state.cache_open_write_fail_action = CACHE_WL_FAIL_ACTION_DEFAULT;
+      t_state.cache_info.write_lock_state  = HttpTransact::CACHE_WL_FAIL;
+      break;
+    }
     if (t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_DEFAULT) {
       t_state.cache_info.write_lock_state = HttpTransact::CACHE_WL_FAIL;
       break;
@@ -6966,6 +6973,28 @@ HttpSM::find_http_resp_buffer_size(int64_t content_length)
   return alloc_index;
 }
 
+// MIOBuffer *HttpSM::new_server_response_buffer()
+//
+//   Allocates the buffer for the server response body. If the
+//     length is not known and adaptive sizing is enabled the
+//     buffer starts small and grows with the transfer rate up
+//     to the usual size.
+//
+MIOBuffer *
+HttpSM::new_server_response_buffer()
+{
+  int64_t alloc_index = find_server_buffer_size();
+
+  if (t_state.http_config_param->adaptive_buffer_sizing && t_state.hdr_info.response_content_length == HTTP_UNDEFINED_CL &&
+      alloc_index > static_cast<int64_t>(HTTP_HEADER_BUFFER_SIZE_INDEX)) {
+    MIOBuffer *buf = new_MIOBuffer(HTTP_HEADER_BUFFER_SIZE_INDEX);
+    buf->set_adaptive_size_index(alloc_index);
+    return buf;
+  }
+
+  return new_MIOBuffer(alloc_index);
+}
+
 // int HttpSM::server_transfer_init()
 //
 //    Moves data from the header buffer into the reply buffer
@@ -7013,11 +7042,9 @@ HttpSM::server_transfer_init(MIOBuffer *buf, int hdr_size)
 HttpTunnelProducer *
 HttpSM::setup_server_transfer_to_transform()
 {
-  int64_t alloc_index;
   int64_t nbytes;
 
-  alloc_index               = find_server_buffer_size();
-  MIOBuffer      *buf       = new_MIOBuffer(alloc_index);
+  MIOBuffer      *buf       = new_server_response_buffer();
   IOBufferReader *buf_start = buf->alloc_reader();
   nbytes                    = server_transfer_init(buf, 0);
 
@@ -7085,14 +7112,13 @@ HttpTunnelProducer *
 HttpSM::setup_server_transfer()
 {
   SMDbg(dbg_ctl_http, "Setup Server Transfer");
-  int64_t alloc_index, hdr_size;
+  int64_t hdr_size;
   int64_t nbytes;
 
-  alloc_index = find_server_buffer_size();
 #ifndef USE_NEW_EMPTY_MIOBUFFER
-  MIOBuffer *buf = new_MIOBuffer(alloc_index);
+  MIOBuffer *buf = new_server_response_buffer();
 #else
-  MIOBuffer *buf = new_empty_MIOBuffer(alloc_index);
+  MIOBuffer *buf = new_empty_MIOBuffer(find_server_buffer_size());
   buf->append_block(HTTP_HEADER_BUFFER_SIZE_INDEX);
 #endif
   buf->water_mark           = static_cast<int>(t_state.txn_conf->default_buffer_water_mark);
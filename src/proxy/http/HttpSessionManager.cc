@@ -51,7 +51,7 @@ initialize_thread_for_http_sessions(EThread *thread)
 
 HttpSessionManager httpSessionManager;
 
-ServerSessionPool::ServerSessionPool() : Continuation(new_ProxyMutex()), m_ip_pool(1023), m_fqdn_pool(1023)
+ServerSessionPool::ServerSessionPool() : Continuation(new_ProxyMutex("http.session_pool")), m_ip_pool(1023), m_fqdn_pool(1023)
 {
   SET_HANDLER(&ServerSessionPool::eventHandler);
   m_ip_pool.set_expansion_policy(IPTable::MANUAL);
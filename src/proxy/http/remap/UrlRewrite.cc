@@ -55,6 +55,65 @@ SetHomePageRedirectFlag(url_mapping *new_mapping, URL &new_to_url)
 
   new_mapping->homePageRedirect = (from_path && !to_path) ? true : false;
 }
+
+/** Per thread cache of remap hash table lookups.
+
+    The trie search for a host only looks at the request path up to the longest "from" path in the
+    store, so entries are keyed by the store, scheme, port, host and that prefix of the path. Each
+    entry records the generation of the table that produced it. A table reload changes the
+    generation, which invalidates every entry without any cross thread coordination.
+*/
+class RemapLookupCache
+{
+public:
+  struct Entry {
+    uint64_t                         generation = 0; ///< Generation of the table, 0 if unused.
+    uint64_t                         hash       = 0;
+    const UrlRewrite::MappingsStore *store      = nullptr;
+    int                              scheme     = 0;
+    int                              port       = 0;
+    url_mapping                     *mapping    = nullptr;
+    std::string                      key; ///< Host, '/', path prefix.
+
+    bool
+    match(uint64_t gen, uint64_t h, const UrlRewrite::MappingsStore *s, int sch, int p, std::string_view host,
+          std::string_view path) const
+    {
+      return generation == gen && hash == h && store == s && scheme == sch && port == p &&
+             key.size() == host.size() + 1 + path.size() && 0 == memcmp(key.data(), host.data(), host.size()) &&
+             0 == memcmp(key.data() + host.size() + 1, path.data(), path.size());
+    }
+  };
+
+  Entry &
+  slot(int size, uint64_t hash)
+  {
+    if (_entries.size() != static_cast<size_t>(size)) {
+      _entries.clear();
+      _entries.resize(size);
+    }
+    return _entries[hash % size];
+  }
+
+private:
+  std::vector<Entry> _entries;
+};
+
+thread_local RemapLookupCache remap_lookup_cache;
+
+// Not in http_rsb, the remap library is also linked without HttpConfig.
+struct RemapLookupCacheMetrics {
+  Metrics::Counter::AtomicType *hits   = Metrics::Counter::createPtr("proxy.process.http.remap.lookup_cache_hits");
+  Metrics::Counter::AtomicType *misses = Metrics::Counter::createPtr("proxy.process.http.remap.lookup_cache_misses");
+};
+
+RemapLookupCacheMetrics &
+remap_lookup_cache_metrics()
+{
+  static RemapLookupCacheMetrics metrics;
+  return metrics;
+}
+
 } // end anonymous namespace
 
 bool
@@ -102,6 +161,8 @@ UrlRewrite::load()
   }
 
   REC_ReadConfigInteger(reverse_proxy, "proxy.config.reverse_proxy.enabled");
+  REC_ReadConfigInteger(_lookup_cache_size, "proxy.config.url_remap.lookup_cache_size");
+  remap_lookup_cache_metrics();
 
   /* Initialize the plugin factory */
   pluginFactory.setRuntimeDir(RecConfigReadRuntimeDir()).addSearchDir(RecConfigReadPluginDir());
@@ -286,9 +347,10 @@ UrlRewrite::PrintRemapHitsStore(MappingsStore &store)
 
 */
 url_mapping *
-UrlRewrite::_tableLookup(std::unique_ptr<URLTable> &h_table, URL *request_url, int request_port, char *request_host,
-                         int request_host_len)
+UrlRewrite::_tableLookup(MappingsStore &store, URL *request_url, int request_port, char *request_host, int request_host_len)
 {
+  std::unique_ptr<URLTable> &h_table = store.hash_lookup;
+
   if (!h_table) {
     h_table.reset(new URLTable);
   }
@@ -308,6 +370,42 @@ UrlRewrite::_tableLookup(std::unique_ptr<URLTable> &h_table, URL *request_url, i
   return um;
 }
 
+/**
+  Same as _tableLookup, but consults the per thread lookup cache first and
+  records the result, including a failed lookup, in the cache.
+
+*/
+url_mapping *
+UrlRewrite::_cachedTableLookup(MappingsStore &store, URL *request_url, int request_port, char *request_host,
+                               int request_host_len)
+{
+  int         path_len = 0;
+  const char *path     = request_url->path_get(&path_len);
+  int         scheme   = request_url->scheme_get_wksidx();
+
+  std::string_view host{request_host, static_cast<size_t>(request_host_len)};
+  std::string_view prefix{path, static_cast<size_t>(std::min(path_len, store.max_path_len))};
+  uint64_t         hash = std::hash<std::string_view>{}(host) ^ (std::hash<std::string_view>{}(prefix) * 31) ^
+                          (static_cast<uint64_t>(request_port) << 8) ^ static_cast<uint64_t>(scheme + 1);
+
+  RemapLookupCache::Entry &entry = remap_lookup_cache.slot(_lookup_cache_size, hash);
+  if (entry.match(_generation, hash, &store, scheme, request_port, host, prefix)) {
+    Metrics::Counter::increment(remap_lookup_cache_metrics().hits);
+    return entry.mapping;
+  }
+
+  Metrics::Counter::increment(remap_lookup_cache_metrics().misses);
+  entry.mapping    = _tableLookup(store, request_url, request_port, request_host, request_host_len);
+  entry.generation = _generation;
+  entry.hash       = hash;
+  entry.store      = &store;
+  entry.scheme     = scheme;
+  entry.port       = request_port;
+  entry.key.assign(host).append(1, '/').append(prefix);
+
+  return entry.mapping;
+}
+
 // This is only used for redirects and reverse rules, and the homepageredirect flag
 // can never be set. The end result is that request_url is modified per remap container.
 void
@@ -705,7 +803,7 @@ UrlRewrite::_addToStore(MappingsStore &store, url_mapping *new_mapping, RegexMap
     store.regex_list.enqueue(reg_map);
     retval = true;
   } else {
-    retval = TableInsert(store.hash_lookup, new_mapping, src_host);
+    retval = TableInsert(store, new_mapping, src_host);
   }
   if (retval) {
     ++count;
@@ -758,9 +856,9 @@ UrlRewrite::InsertForwardMapping(mapping_type maptype, url_mapping *mapping, con
   bool success;
 
   if (maptype == FORWARD_MAP_WITH_RECV_PORT) {
-    success = TableInsert(forward_mappings_with_recv_port.hash_lookup, mapping, src_host);
+    success = TableInsert(forward_mappings_with_recv_port, mapping, src_host);
   } else {
-    success = TableInsert(forward_mappings.hash_lookup, mapping, src_host);
+    success = TableInsert(forward_mappings, mapping, src_host);
   }
 
   if (success) {
@@ -844,8 +942,10 @@ UrlRewrite::BuildTable(const char *path)
 
 */
 bool
-UrlRewrite::TableInsert(std::unique_ptr<URLTable> &h_table, url_mapping *mapping, const char *src_host)
+UrlRewrite::TableInsert(MappingsStore &store, url_mapping *mapping, const char *src_host)
 {
+  std::unique_ptr<URLTable> &h_table = store.hash_lookup;
+
   if (!h_table) {
     h_table.reset(new URLTable);
   }
@@ -874,6 +974,11 @@ UrlRewrite::TableInsert(std::unique_ptr<URLTable> &h_table, url_mapping *mapping
     Warning("Could not insert new mapping: duplicated entry exists");
     return false;
   }
+
+  int from_path_len = 0;
+  mapping->fromURL.path_get(&from_path_len);
+  store.max_path_len = std::max(store.max_path_len, from_path_len);
+
   return true;
 }
 
@@ -902,7 +1007,9 @@ UrlRewrite::_mappingLookup(MappingsStore &mappings, URL *request_url, int reques
 
   bool         retval       = false;
   int          rank_ceiling = -1;
-  url_mapping *mapping      = _tableLookup(mappings.hash_lookup, request_url, request_port, request_host_lower, request_host_len);
+  url_mapping *mapping      = _lookup_cache_size > 0 ?
+                                _cachedTableLookup(mappings, request_url, request_port, request_host_lower, request_host_len) :
+                                _tableLookup(mappings, request_url, request_port, request_host_lower, request_host_len);
   if (mapping != nullptr) {
     rank_ceiling = mapping->getRank();
     Dbg(dbg_ctl_url_rewrite, "Found 'simple' mapping with rank %d", rank_ceiling);
@@ -69,6 +69,7 @@ InkAtomicList *Log::flush_data_list;
 
 // Log private objects
 int      Log::preproc_threads;
+int      Log::flush_threads = 1;
 int      Log::init_status                = 0;
 int      Log::config_flags               = 0;
 bool     Log::logging_mode_changed       = false;
@@ -159,7 +160,7 @@ Log::change_configuration()
   such as checking the amount of space used, seeing if it's time to roll
   files, and flushing idle log buffers.  Most of these tasks require having
   exclusive access to the back-end structures, which is controlled by the
-  flush_thread.  Therefore, we will simply instruct the flush thread to
+  first flush thread.  Therefore, we will simply instruct that thread to
   execute a periodic_tasks() function once per period.  To ensure that the
   tasks are executed AT LEAST once each period, we'll register a call-back
   with the system and trigger the flush thread's condition variable.  To
@@ -992,6 +993,11 @@ Log::init_fields()
   global_field_list.add(field, false);
   field_symbol_hash.emplace("vs", field);
 
+  field = new LogField("log_sample_rate", "lsr", LogField::sINT, &LogAccess::marshal_log_sample_rate,
+                       &LogAccess::unmarshal_int_to_str);
+  global_field_list.add(field, false);
+  field_symbol_hash.emplace("lsr", field);
+
   init_status |= FIELDS_INITIALIZED;
 }
 
@@ -1057,6 +1063,7 @@ Log::init(int flags)
 
     config->read_configuration_variables();
     preproc_threads = config->preproc_threads;
+    flush_threads   = config->flush_threads;
 
     int val = static_cast<int>(REC_ConfigReadInteger("proxy.config.log.logging_enabled"));
     if (val < LOG_MODE_NONE || val > LOG_MODE_FULL) {
@@ -1110,7 +1117,7 @@ Log::init_when_enabled()
 
     // create the flush thread
     create_threads();
-    eventProcessor.schedule_every(new PeriodicWakeup(preproc_threads, 1), HRTIME_SECOND, ET_CALL);
+    eventProcessor.schedule_every(new PeriodicWakeup(preproc_threads, flush_threads), HRTIME_SECOND, ET_CALL);
 
     init_status |= FULLY_INITIALIZED;
   }
@@ -1140,16 +1147,19 @@ Log::create_threads()
     eventProcessor.spawn_thread(preproc_cont, desc, stacksize);
   }
 
-  // Now, only one flush thread is supported.
-  // TODO: Enable multiple flush threads, such as
-  //       one flush thread per file.
+  // start the flush threads
   //
-  flush_notify    = new EventNotify;
-  flush_data_list = new InkAtomicList;
-
-  ink_atomiclist_init(flush_data_list, "Logging flush buffer list", 0);
-  Continuation *flush_cont = new LoggingFlushContinuation(0);
-  eventProcessor.spawn_thread(flush_cont, "[LOG_FLUSH]", stacksize);
+  // Each log file is written by one of them, so its writes are kept in
+  // order, and the first one also runs the periodic tasks.
+  flush_notify    = new EventNotify[flush_threads];
+  flush_data_list = new InkAtomicList[flush_threads];
+
+  for (int i = 0; i < flush_threads; i++) {
+    ink_atomiclist_init(&flush_data_list[i], "Logging flush buffer list", 0);
+    Continuation *flush_cont = new LoggingFlushContinuation(i);
+    snprintf(desc, sizeof(desc), "[LOG_FLUSH %d]", i);
+    eventProcessor.spawn_thread(flush_cont, desc, stacksize);
+  }
 }
 
 /*-------------------------------------------------------------------------
@@ -1310,21 +1320,22 @@ Log::preproc_thread_main(void *args)
 }
 
 void *
-Log::flush_thread_main(void * /* args ATS_UNUSED */)
+Log::flush_thread_main(void *args)
 {
+  int                                        idx = *static_cast<int *>(args);
   LogBuffer                                 *logbuffer;
   LogFlushData                              *fdata;
   ink_hrtime                                 now, last_time = 0;
   int                                        len, total_bytes;
   SLL<LogFlushData, LogFlushData::Link_link> link, invert_link;
 
-  Log::flush_notify->lock();
+  Log::flush_notify[idx].lock();
 
   while (true) {
     if (TSSystemState::is_event_system_shut_down()) {
       return nullptr;
     }
-    fdata = static_cast<LogFlushData *>(ink_atomiclist_popall(flush_data_list));
+    fdata = static_cast<LogFlushData *>(ink_atomiclist_popall(&flush_data_list[idx]));
 
     // invert the list
     //
@@ -1355,6 +1366,13 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
         ink_release_assert(!"Unknown file format type!");
       }
 
+      Metrics::Gauge::decrement(logfile->m_flush_pending, total_bytes);
+      Metrics::Gauge::store(logfile->m_flush_lag, ink_hrtime_to_msec(ink_get_hrtime() - fdata->m_queued));
+
+      // deleting fdata may release the last reference to the file, which must outlive the lock
+      Ptr<LogFile>          file_ref(logfile);
+      ink_scoped_mutex_lock lock(&logfile->m_flush_mutex);
+
       // make sure we're open & ready to write
       logfile->check_fd();
       if (!logfile->is_open()) {
@@ -1369,28 +1387,43 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
       // This should always be true because we just checked it.
       ink_assert(logfilefd >= 0);
 
-      // write *all* data to target file as much as possible
-      //
-      while (total_bytes - bytes_written) {
+      if (logfile->m_compressor) {
+        // compressed data is written as a whole, or dropped
+        //
         if (Log::config->logging_space_exhausted) {
           Dbg(dbg_ctl_log, "logging space exhausted, failed to write file:%s, have dropped (%d) bytes.", logfile->get_name(),
-              (total_bytes - bytes_written));
+              total_bytes);
 
-          Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes - bytes_written);
-          break;
+          Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes);
+        } else if ((len = logfile->write_compressed(buf, total_bytes)) < 0) {
+          Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes);
+        } else {
+          bytes_written = len;
         }
-
-        len = ::write(logfilefd, &buf[bytes_written], total_bytes - bytes_written);
-
-        if (len < 0) {
-          SiteThrottledError("Failed to write log to %s: [tried %d, wrote %d, %s]", logfile->get_name(),
-                             total_bytes - bytes_written, bytes_written, strerror(errno));
-
-          Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes - bytes_written);
-          break;
+      } else {
+        // write *all* data to target file as much as possible
+        //
+        while (total_bytes - bytes_written) {
+          if (Log::config->logging_space_exhausted) {
+            Dbg(dbg_ctl_log, "logging space exhausted, failed to write file:%s, have dropped (%d) bytes.", logfile->get_name(),
+                (total_bytes - bytes_written));
+
+            Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes - bytes_written);
+            break;
+          }
+
+          len = ::write(logfilefd, &buf[bytes_written], total_bytes - bytes_written);
+
+          if (len < 0) {
+            SiteThrottledError("Failed to write log to %s: [tried %d, wrote %d, %s]", logfile->get_name(),
+                               total_bytes - bytes_written, bytes_written, strerror(errno));
+
+            Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes - bytes_written);
+            break;
+          }
+          Dbg(dbg_ctl_log, "Successfully wrote some stuff to %s", logfile->get_name());
+          bytes_written += len;
         }
-        Dbg(dbg_ctl_log, "Successfully wrote some stuff to %s", logfile->get_name());
-        bytes_written += len;
       }
 
       Metrics::Counter::increment(log_rsb.bytes_written_to_disk, bytes_written);
@@ -1405,7 +1438,7 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
     // Time to work on periodic events??
     //
     now = ink_get_hrtime() / HRTIME_SECOND;
-    if (now >= last_time + periodic_tasks_interval) {
+    if (idx == 0 && now >= last_time + periodic_tasks_interval) {
       Dbg(dbg_ctl_log_preproc, "periodic tasks for %" PRId64, (int64_t)now);
       periodic_tasks(now);
       last_time = ink_get_hrtime() / HRTIME_SECOND;
@@ -1415,10 +1448,10 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
     // check the queue and find there is nothing to do, then wait
     // again.
     //
-    Log::flush_notify->wait();
+    Log::flush_notify[idx].wait();
   }
 
   /* NOTREACHED */
-  Log::flush_notify->unlock();
+  Log::flush_notify[idx].unlock();
   return nullptr;
 }
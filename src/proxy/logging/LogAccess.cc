@@ -119,6 +119,65 @@ LogAccess::init()
   }
 }
 
+/*-------------------------------------------------------------------------
+  LogAccess::marshal_cache_init
+
+  Keep the fields marshalled by a log object for the next ones, for the
+  fields with a LogField::marshal_slot() less than @a slots.
+  -------------------------------------------------------------------------*/
+
+void
+LogAccess::marshal_cache_init(int slots)
+{
+  m_marshal_cache       = static_cast<MarshalCacheEntry *>(m_arena.alloc(slots * sizeof(MarshalCacheEntry)));
+  m_marshal_cache_slots = slots;
+  marshal_cache_clear();
+}
+
+/*-------------------------------------------------------------------------
+  LogAccess::marshal_cache_clear
+
+  Forget the marshalled fields, as a filter changed the field values.
+  -------------------------------------------------------------------------*/
+
+void
+LogAccess::marshal_cache_clear()
+{
+  if (m_marshal_cache) {
+    memset(static_cast<void *>(m_marshal_cache), 0, m_marshal_cache_slots * sizeof(MarshalCacheEntry));
+  }
+}
+
+void
+LogAccess::marshal_cache_store(int slot, const char *buf, unsigned len)
+{
+  if (slot >= 0 && slot < m_marshal_cache_slots && len > 0) {
+    char *data = static_cast<char *>(m_arena.alloc(len, INK_MIN_ALIGN));
+    memcpy(data, buf, len);
+    m_marshal_cache[slot].data = data;
+    m_marshal_cache[slot].len  = len;
+  }
+}
+
+/*-------------------------------------------------------------------------
+  LogAccess::is_priority_entry
+
+  A transaction without a response to the client failed, and is a priority
+  as well.
+  -------------------------------------------------------------------------*/
+
+bool
+LogAccess::is_priority_entry() const
+{
+  if (!m_proxy_response) {
+    return true;
+  }
+
+  HTTPStatus status = m_proxy_response->status_get();
+
+  return status < HTTP_STATUS_OK || status >= HTTP_STATUS_MULTIPLE_CHOICES;
+}
+
 int
 LogAccess::marshal_proxy_host_name(char *buf)
 {
@@ -1586,6 +1645,17 @@ LogAccess::marshal_proxy_protocol_dst_ip(char *buf)
   return marshal_ip(buf, ip);
 }
 
+/*-------------------------------------------------------------------------
+  -------------------------------------------------------------------------*/
+int
+LogAccess::marshal_log_sample_rate(char *buf)
+{
+  if (buf) {
+    marshal_int(buf, m_sample_rate);
+  }
+  return INK_MIN_ALIGN;
+}
+
 /*-------------------------------------------------------------------------
   -------------------------------------------------------------------------*/
 int
@@ -0,0 +1,245 @@
+/** @file
+
+  Streaming compression of ASCII log files.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/logging/LogCompressor.h"
+
+#include "tscore/ink_config.h"
+#include "tscore/Diags.h"
+
+#include <cerrno>
+#include <unistd.h>
+#include <zlib.h>
+
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
+namespace
+{
+// gzip headers and trailers, rather than the zlib ones.
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+
+class GzipCompressor : public LogCompressor
+{
+public:
+  explicit GzipCompressor(int level)
+  {
+    _ok = deflateInit2(&_zs, level > 0 ? level : Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+  }
+
+  ~GzipCompressor() override
+  {
+    if (_ok) {
+      deflateEnd(&_zs);
+    }
+  }
+
+  int
+  write(int fd, const char *data, int len) override
+  {
+    _zs.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    _zs.avail_in = len;
+    _started     = true;
+    return deflate_to(fd, Z_SYNC_FLUSH);
+  }
+
+  int
+  finish(int fd) override
+  {
+    if (!_started) {
+      return 0;
+    }
+    _zs.avail_in = 0;
+    int bytes    = deflate_to(fd, Z_FINISH);
+    deflateReset(&_zs);
+    _started = false;
+    return bytes;
+  }
+
+  bool
+  ok() const
+  {
+    return _ok;
+  }
+
+private:
+  int
+  deflate_to(int fd, int flush)
+  {
+    int  bytes = 0;
+    char out[OUTPUT_BUFFER_SIZE];
+
+    do {
+      _zs.next_out  = reinterpret_cast<Bytef *>(out);
+      _zs.avail_out = sizeof(out);
+      int err       = deflate(&_zs, flush);
+      if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) {
+        Error("Failed to compress log data: %s", _zs.msg ? _zs.msg : "deflate error");
+        return -1;
+      }
+      int len = sizeof(out) - _zs.avail_out;
+      if (len > 0 && write_all(fd, out, len) < 0) {
+        return -1;
+      }
+      bytes += len;
+    } while (_zs.avail_out == 0);
+
+    return bytes;
+  }
+
+  z_stream _zs      = {};
+  bool     _ok      = false;
+  bool     _started = false;
+};
+
+#if HAVE_ZSTD_H
+class ZstdCompressor : public LogCompressor
+{
+public:
+  explicit ZstdCompressor(int level) : _cctx(ZSTD_createCCtx())
+  {
+    if (_cctx && level > 0) {
+      ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, level);
+    }
+  }
+
+  ~ZstdCompressor() override { ZSTD_freeCCtx(_cctx); }
+
+  int
+  write(int fd, const char *data, int len) override
+  {
+    ZSTD_inBuffer in = {data, static_cast<size_t>(len), 0};
+
+    _started = true;
+    return compress_to(fd, in, ZSTD_e_flush);
+  }
+
+  int
+  finish(int fd) override
+  {
+    if (!_started) {
+      return 0;
+    }
+    ZSTD_inBuffer in = {nullptr, 0, 0};
+
+    _started = false;
+    return compress_to(fd, in, ZSTD_e_end);
+  }
+
+  bool
+  ok() const
+  {
+    return _cctx != nullptr;
+  }
+
+private:
+  int
+  compress_to(int fd, ZSTD_inBuffer &in, ZSTD_EndDirective mode)
+  {
+    int    bytes = 0;
+    char   out_buf[OUTPUT_BUFFER_SIZE];
+    size_t remaining;
+
+    do {
+      ZSTD_outBuffer out = {out_buf, sizeof(out_buf), 0};
+      remaining          = ZSTD_compressStream2(_cctx, &out, &in, mode);
+      if (ZSTD_isError(remaining)) {
+        Error("Failed to compress log data: %s", ZSTD_getErrorName(remaining));
+        ZSTD_CCtx_reset(_cctx, ZSTD_reset_session_only);
+        return -1;
+      }
+      if (out.pos > 0 && write_all(fd, out_buf, out.pos) < 0) {
+        return -1;
+      }
+      bytes += out.pos;
+    } while (remaining > 0 || in.pos < in.size);
+
+    return bytes;
+  }
+
+  ZSTD_CCtx *_cctx;
+  bool       _started = false;
+};
+#endif
+
+} // end anonymous namespace
+
+LogCompressor *
+LogCompressor::create(LogFileCompression compression, int level)
+{
+  switch (compression) {
+  case LOG_FILE_COMPRESSION_GZIP: {
+    auto *gzip = new GzipCompressor(level);
+    if (gzip->ok()) {
+      return gzip;
+    }
+    delete gzip;
+    break;
+  }
+  case LOG_FILE_COMPRESSION_ZSTD: {
+#if HAVE_ZSTD_H
+    auto *zstd = new ZstdCompressor(level);
+    if (zstd->ok()) {
+      return zstd;
+    }
+    delete zstd;
+#endif
+    break;
+  }
+  case LOG_FILE_COMPRESSION_NONE:
+    break;
+  }
+  return nullptr;
+}
+
+const char *
+LogCompressor::extension(LogFileCompression compression)
+{
+  switch (compression) {
+  case LOG_FILE_COMPRESSION_GZIP:
+    return ".gz";
+  case LOG_FILE_COMPRESSION_ZSTD:
+    return ".zst";
+  case LOG_FILE_COMPRESSION_NONE:
+    break;
+  }
+  return "";
+}
+
+int
+LogCompressor::write_all(int fd, const char *data, int len)
+{
+  int written = 0;
+
+  while (written < len) {
+    ssize_t n = ::write(fd, data + written, len - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    written += n;
+  }
+  return written;
+}
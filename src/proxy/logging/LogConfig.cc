@@ -164,6 +164,11 @@ LogConfig::read_configuration_variables()
     preproc_threads = val;
   }
 
+  val = static_cast<int>(REC_ConfigReadInteger("proxy.config.log.flush_threads"));
+  if (val > 0 && val <= 128) {
+    flush_threads = val;
+  }
+
   // ROLLING
 
   // we don't check for valid values of rolling_enabled, rolling_interval_sec,
@@ -357,6 +362,7 @@ LogConfig::display(FILE *fd)
   fprintf(fd, "   error_log_filename = %s\n", error_log_filename);
 
   fprintf(fd, "   preproc_threads = %d\n", preproc_threads);
+  fprintf(fd, "   flush_threads = %d\n", flush_threads);
   fprintf(fd, "   rolling_enabled = %d\n", rolling_enabled);
   fprintf(fd, "   rolling_interval_sec = %d\n", rolling_interval_sec);
   fprintf(fd, "   rolling_offset_hr = %d\n", rolling_offset_hr);
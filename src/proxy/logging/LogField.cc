@@ -32,6 +32,11 @@
 #include "swoc/TextView.h"
 #include "swoc/string_view_util.h"
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "proxy/hdrs/MIME.h"
 #include "proxy/logging/LogUtils.h"
 #include "proxy/logging/LogField.h"
@@ -180,6 +185,33 @@ struct cmp_str {
     return strcasecmp(a, b) < 0;
   }
 };
+
+/// Slots of the marshal cache, by the symbol and name of the fields.
+struct MarshalSlots {
+  std::mutex                           mutex;
+  std::unordered_map<std::string, int> slots;
+  std::atomic<int>                     count{0};
+
+  int
+  find(const char *symbol, const char *name)
+  {
+    std::string      key = std::string{symbol} + ':' + name;
+    std::scoped_lock lock{mutex};
+
+    auto [spot, added] = slots.try_emplace(key, count.load());
+    if (added) {
+      ++count;
+    }
+    return spot->second;
+  }
+
+  static MarshalSlots &
+  instance()
+  {
+    static MarshalSlots marshal_slots;
+    return marshal_slots;
+  }
+};
 } // namespace
 
 using milestone_map = std::map<swoc::TextView, TSMilestonesType, cmp_str>;
@@ -249,7 +281,8 @@ LogField::LogField(const char *name, const char *symbol, Type type, MarshalFunc
     m_milestone2(TS_MILESTONE_LAST_ENTRY),
     m_time_field(false),
     m_alias_map(nullptr),
-    m_set_func(_setfunc)
+    m_set_func(_setfunc),
+    m_marshal_slot(type == STRING ? MarshalSlots::instance().find(symbol, name) : NO_MARSHAL_SLOT)
 {
   ink_assert(m_name != nullptr);
   ink_assert(m_symbol != nullptr);
@@ -275,7 +308,8 @@ LogField::LogField(const char *name, const char *symbol, Type type, MarshalFunc
     m_milestone2(TS_MILESTONE_LAST_ENTRY),
     m_time_field(false),
     m_alias_map(map),
-    m_set_func(_setfunc)
+    m_set_func(_setfunc),
+    m_marshal_slot(type == STRING ? MarshalSlots::instance().find(symbol, name) : NO_MARSHAL_SLOT)
 {
   ink_assert(m_name != nullptr);
   ink_assert(m_symbol != nullptr);
@@ -341,7 +375,9 @@ LogField::LogField(const char *field, Container container)
     m_milestone2(TS_MILESTONE_LAST_ENTRY),
     m_time_field(false),
     m_alias_map(nullptr),
-    m_set_func(nullptr)
+    m_set_func(nullptr),
+    m_marshal_slot(container == MS || container == MSDMS ? NO_MARSHAL_SLOT :
+                                                           MarshalSlots::instance().find(container_names[container], field))
 {
   ink_assert(m_name != nullptr);
   ink_assert(m_symbol != nullptr);
@@ -410,13 +446,21 @@ LogField::LogField(const LogField &rhs)
     m_milestone2(TS_MILESTONE_LAST_ENTRY),
     m_time_field(rhs.m_time_field),
     m_alias_map(rhs.m_alias_map),
-    m_set_func(rhs.m_set_func)
+    m_set_func(rhs.m_set_func),
+    m_marshal_slot(rhs.m_marshal_slot)
 {
   ink_assert(m_name != nullptr);
   ink_assert(m_symbol != nullptr);
   ink_assert(m_type >= 0 && m_type < N_TYPES);
 }
 
+/// The number of slots of the marshal cache used by the fields so far.
+int
+LogField::marshal_slots()
+{
+  return MarshalSlots::instance().count.load();
+}
+
 /*-------------------------------------------------------------------------
   LogField::~LogField
   -------------------------------------------------------------------------*/
@@ -437,43 +481,13 @@ LogField::~LogField()
 unsigned
 LogField::marshal_len(LogAccess *lad)
 {
-  if (m_container == NO_CONTAINER) {
-    return (lad->*m_marshal_func)(nullptr);
-  }
+  unsigned len;
 
-  switch (m_container) {
-  case CQH:
-  case PSH:
-  case PQH:
-  case SSH:
-  case CSSH:
-    return lad->marshal_http_header_field(m_container, m_name, nullptr);
-
-  case ECQH:
-  case EPSH:
-  case EPQH:
-  case ESSH:
-  case ECSSH:
-    return lad->marshal_http_header_field_escapify(m_container, m_name, nullptr);
-
-  case ICFG:
-    return lad->marshal_config_int_var(m_name, nullptr);
-
-  case SCFG:
-    return lad->marshal_config_str_var(m_name, nullptr);
-
-  case RECORD:
-    return lad->marshal_record(m_name, nullptr);
-
-  case MS:
-    return lad->marshal_milestone(m_milestone1, nullptr);
-
-  case MSDMS:
-    return lad->marshal_milestone_diff(m_milestone1, m_milestone2, nullptr);
-
-  default:
-    return 0;
+  if (!lad->marshal_cache_len(m_marshal_slot, &len)) {
+    len = marshal_field(lad, nullptr);
+    lad->marshal_cache_set_len(m_marshal_slot, len);
   }
+  return len;
 }
 
 bool
@@ -500,6 +514,7 @@ LogField::isContainerUpdateFieldSupported(Container container)
 void
 LogField::updateField(LogAccess *lad, char *buf, int len)
 {
+  lad->marshal_cache_clear();
   if (m_container == NO_CONTAINER) {
     return (lad->*m_set_func)(buf, len);
   } else {
@@ -514,10 +529,30 @@ LogField::updateField(LogAccess *lad, char *buf, int len)
 /*-------------------------------------------------------------------------
   LogField::marshal
 
-  This routine will marshsal the given field into the buffer provided.
+  This routine will marshsal the given field into the buffer provided, or
+  copy it from the marshal cache of the LogAccess if another format
+  marshalled it already.
   -------------------------------------------------------------------------*/
 unsigned
 LogField::marshal(LogAccess *lad, char *buf)
+{
+  unsigned len;
+
+  if (!lad->marshal_cache_copy(m_marshal_slot, buf, &len)) {
+    len = marshal_field(lad, buf);
+    lad->marshal_cache_store(m_marshal_slot, buf, len);
+  }
+  return len;
+}
+
+/*-------------------------------------------------------------------------
+  LogField::marshal_field
+
+  Marshal the field into @a buf, or only return its marshalled length if
+  @a buf is @c nullptr.
+  -------------------------------------------------------------------------*/
+unsigned
+LogField::marshal_field(LogAccess *lad, char *buf)
 {
   if (m_container == NO_CONTAINER) {
     return (lad->*m_marshal_func)(buf);
@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
 
 #include "tscore/ink_platform.h"
@@ -60,6 +61,13 @@ namespace
 DbgCtl dbg_ctl_log_file{"log-file"};
 DbgCtl dbg_ctl_log{"log"};
 
+/// The flush thread for the file @a name, the same one for each configuration that logs to it.
+int
+flush_thread_for(const char *name)
+{
+  return Log::flush_threads > 1 ? std::hash<std::string_view>{}(name) % Log::flush_threads : 0;
+}
+
 } // end anonymous namespace
 
 /*-------------------------------------------------------------------------
@@ -70,7 +78,8 @@ DbgCtl dbg_ctl_log{"log"};
   -------------------------------------------------------------------------*/
 
 LogFile::LogFile(const char *name, const char *header, LogFileFormat format, uint64_t signature, size_t ascii_buffer_size,
-                 size_t max_line_size, int pipe_buffer_size, LogEscapeType escape_type)
+                 size_t max_line_size, int pipe_buffer_size, LogEscapeType escape_type, LogFileCompression compression,
+                 int compression_level)
   : m_file_format(format),
     m_name(ats_strdup(name)),
     m_escape_type(escape_type),
@@ -90,6 +99,21 @@ LogFile::LogFile(const char *name, const char *header, LogFileFormat format, uin
 
   m_fd                = -1;
   m_ascii_buffer_size = (ascii_buffer_size < max_line_size ? max_line_size : ascii_buffer_size);
+  m_flush_thread      = flush_thread_for(m_name);
+  ink_mutex_init(&m_flush_mutex);
+
+  if (compression != LOG_FILE_COMPRESSION_NONE) {
+    if (m_file_format != LOG_FILE_ASCII) {
+      Warning("Only ascii log files can be compressed, %s is written uncompressed", m_name);
+    } else if ((m_compressor = LogCompressor::create(compression, compression_level)) == nullptr) {
+      Warning("The compression of %s is not supported by this build, it is written uncompressed", m_name);
+    }
+  }
+
+  const char *basename = strrchr(m_name, '/');
+  std::string prefix   = std::string("proxy.process.log.") + (basename ? basename + 1 : m_name);
+  m_flush_lag          = Metrics::Gauge::createPtr(prefix, ".flush_lag_ms");
+  m_flush_pending      = Metrics::Gauge::createPtr(prefix, ".flush_pending_bytes");
 
   Dbg(dbg_ctl_log_file, "exiting LogFile constructor, m_name=%s, this=%p, escape_type=%d", m_name, this, escape_type);
 }
@@ -113,7 +137,9 @@ LogFile::~LogFile()
   // close_file() here ensures that we do not leak file descriptors.
   close_file();
 
+  delete m_compressor;
   delete m_log;
+  ink_mutex_destroy(&m_flush_mutex);
   ats_free(m_header);
   ats_free(m_name);
   Dbg(dbg_ctl_log_file, "exiting LogFile destructor, this=%p", this);
@@ -130,7 +156,8 @@ LogFile::change_name(const char *new_name)
   if (m_log) {
     m_log->change_name(new_name);
   }
-  m_name = ats_strdup(new_name);
+  m_name         = ats_strdup(new_name);
+  m_flush_thread = flush_thread_for(m_name);
 }
 
 /*-------------------------------------------------------------------------
@@ -226,7 +253,12 @@ LogFile::open_file()
   if (!file_exists) {
     if (m_file_format != LOG_FILE_BINARY && m_header && m_log) {
       Dbg(dbg_ctl_log_file, "writing header to LogFile %s", m_name);
-      writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
+      if (m_compressor) {
+        std::string header = std::string(m_header) + '\n';
+        write_compressed(header.data(), header.size());
+      } else {
+        writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
+      }
     }
   }
 
@@ -255,6 +287,9 @@ LogFile::close_file()
       }
       m_fd = -1;
     } else if (m_log) {
+      if (m_compressor && m_compressor->finish(get_fd()) < 0) {
+        Error("Error finishing the compression of LogFile %s: %s.", m_log->get_name(), strerror(errno));
+      }
       if (m_log->close_file()) {
         Error("Error closing LogFile %s: %s.", m_log->get_name(), strerror(errno));
       } else {
@@ -367,11 +402,16 @@ LogFile::roll(long interval_start, long interval_end, bool reopen_after_rolling)
     // the old/new object swap happens within lock/unlock calls within Diags.cc.
     // For logging log files, the rolling is implemented by renaming the original file and closing it.
     // Afterwards, the LogFile object will re-open a new file with the original file name using the original object.
-    // There is no need to protect against contention since the open/close/writes are all executed under a
-    // single log flush thread.
+    // The open/close/writes are executed by the flush thread of the file, and the periodic tasks of the first
+    // flush thread, so they are serialized by m_flush_mutex.
     // Since these two methods of using BaseLogFile are not compatible, we perform the logging log file specific
     // close file operation here within the containing LogFile object.
+    ink_scoped_mutex_lock lock(&m_flush_mutex);
+
     if (m_log->roll(interval_start, interval_end)) {
+      if (m_compressor && m_compressor->finish(get_fd()) < 0) {
+        Error("Error finishing the compression of LogFile %s: %s.", m_log->get_name(), strerror(errno));
+      }
       if (m_log->close_file()) {
         Error("Error closing LogFile %s: %s.", m_log->get_name(), strerror(errno));
       }
@@ -411,6 +451,8 @@ LogFile::reopen_if_moved()
     return false;
   }
 
+  ink_scoped_mutex_lock lock(&m_flush_mutex);
+
   // Both of the following log if there are problems.
   close_file();
   open_file();
@@ -472,9 +514,7 @@ LogFile::preproc_and_try_delete(LogBuffer *lb)
     Metrics::Counter::increment(log_rsb.num_flush_to_disk, lb->header()->entry_count);
     Metrics::Counter::increment(log_rsb.bytes_flush_to_disk, lb->header()->byte_count);
 
-    ink_atomiclist_push(Log::flush_data_list, flush_data);
-
-    Log::flush_notify->signal();
+    queue_flush(flush_data, lb->header()->byte_count);
 
     //
     // LogBuffer will be deleted in flush thread
@@ -651,9 +691,7 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
     Metrics::Counter::increment(log_rsb.num_flush_to_disk, fmt_entry_count);
     Metrics::Counter::increment(log_rsb.bytes_flush_to_disk, fmt_buf_bytes);
 
-    ink_atomiclist_push(Log::flush_data_list, flush_data);
-
-    Log::flush_notify->signal();
+    queue_flush(flush_data, fmt_buf_bytes);
 
     total_bytes += fmt_buf_bytes;
   }
@@ -661,6 +699,25 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
   return total_bytes;
 }
 
+void
+LogFile::queue_flush(LogFlushData *flush_data, int bytes)
+{
+  Metrics::Gauge::increment(m_flush_pending, bytes);
+  ink_atomiclist_push(&Log::flush_data_list[m_flush_thread], flush_data);
+  Log::flush_notify[m_flush_thread].signal();
+}
+
+int
+LogFile::write_compressed(const char *data, int len)
+{
+  int bytes = m_compressor->write(get_fd(), data, len);
+
+  if (bytes < 0) {
+    SiteThrottledError("Failed to write log to %s: [tried %d, %s]", m_name, len, strerror(errno));
+  }
+  return bytes;
+}
+
 bool
 LogFile::rolled_logfile(char *file)
 {
@@ -722,8 +779,8 @@ LogFile::writeln(char *data, int len, int fd, const char *path)
 void
 LogFile::check_fd()
 {
-  static bool     failure_last_call = false;
-  static unsigned stat_check_count  = 1;
+  static thread_local bool     failure_last_call = false;
+  static thread_local unsigned stat_check_count  = 1;
 
   if ((stat_check_count % Log::config->file_stat_frequency) == 0) {
     //
@@ -50,6 +50,9 @@ DbgCtl dbg_ctl_log{"log"};
 DbgCtl dbg_ctl_log_agg{"log-agg"};
 DbgCtl dbg_ctl_log_buffer{"log-buffer"};
 DbgCtl dbg_ctl_log_config_transfer{"log-config-transfer"};
+DbgCtl dbg_ctl_log_sampling{"log-sampling"};
+
+constexpr ink_hrtime SAMPLE_UPDATE_INTERVAL = HRTIME_SECOND;
 
 bool
 should_roll_on_time(Log::RollingEnabledValues roll)
@@ -103,7 +106,8 @@ LogBufferManager::preproc_buffers(LogBufferSink *sink)
 LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
                      const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec,
                      int rolling_offset_hr, int rolling_size_mb, bool /* auto_created ATS_UNUSED */, int rolling_max_count,
-                     int rolling_min_count, bool reopen_after_rolling, int pipe_buffer_size, bool fast)
+                     int rolling_min_count, bool reopen_after_rolling, int pipe_buffer_size, bool fast,
+                     LogFileCompression compression, int compression_level)
   : m_alt_filename(nullptr),
     m_flags(0),
     m_signature(0),
@@ -129,13 +133,13 @@ LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_di
     m_flags |= WRITES_TO_PIPE;
   }
 
-  generate_filenames(log_dir, basename, file_format);
+  generate_filenames(log_dir, basename, file_format, compression);
 
   // compute_signature is a static function
   m_signature = compute_signature(m_format, m_basename, m_flags);
 
   m_logFile = new LogFile(m_filename, header, file_format, m_signature, cfg->ascii_buffer_size, cfg->max_line_size,
-                          m_pipe_buffer_size, format->escape_type());
+                          m_pipe_buffer_size, format->escape_type(), compression, compression_level);
 
   if (m_reopen_after_rolling) {
     m_logFile->open_file();
@@ -173,7 +177,7 @@ LogObject::~LogObject()
 // 1.- 'stdout' and 'stderr' are treated as special strings indicating file
 //     descriptors for the stdout and stderr streams.
 // 2.- if no extension is given, add .log for ascii logs, and .blog for
-//     binary logs
+//     binary logs, followed by .gz or .zst for compressed ascii logs
 // 3.- if an extension is given, then do not modify filename and use that
 //     extension regardless of type of log
 // 4.- if there is a '.' at the end of the name, then do not add an extension
@@ -181,7 +185,7 @@ LogObject::~LogObject()
 //     two ('..').
 //
 void
-LogObject::generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format)
+LogObject::generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format, LogFileCompression compression)
 {
   ink_assert(log_dir && basename);
 
@@ -230,8 +234,12 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
     }
   }
 
+  // a compressed file is named for its compression too, e.g. squid.log.gz
+  const char *compression_ext     = ext && file_format == LOG_FILE_ASCII ? LogCompressor::extension(compression) : "";
+  int         compression_ext_len = static_cast<int>(strlen(compression_ext));
+
   int dir_len      = static_cast<int>(strlen(log_dir));
-  int basename_len = len + ext_len + 1;          // include null terminator
+  int basename_len = len + ext_len + compression_ext_len + 1; // include null terminator
   int total_len    = dir_len + 1 + basename_len; // include '/'
 
   m_filename = static_cast<char *>(ats_malloc(total_len));
@@ -246,6 +254,10 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
     memcpy(&m_filename[dir_len + len], ext, ext_len);
     memcpy(&m_basename[len], ext, ext_len);
   }
+  if (compression_ext_len) {
+    memcpy(&m_filename[dir_len + len + ext_len], compression_ext, compression_ext_len);
+    memcpy(&m_basename[len + ext_len], compression_ext, compression_ext_len);
+  }
   m_filename[total_len - 1]    = 0;
   m_basename[basename_len - 1] = 0;
 }
@@ -271,6 +283,55 @@ LogObject::add_filter(LogFilter *filter, bool copy)
   m_filter_list.add(filter, copy);
 }
 
+void
+LogObject::set_sampling(int max_rate, int occupancy, int lag_ms)
+{
+  m_sample_max_rate  = max_rate;
+  m_sample_occupancy = occupancy;
+  m_sample_lag_ms    = lag_ms;
+
+  if (m_sample_max_rate > 1 && !m_sample_rate_gauge) {
+    const char *name    = strrchr(m_filename, '/');
+    std::string prefix  = std::string("proxy.process.log.") + (name ? name + 1 : m_filename);
+    m_sample_rate_gauge = Metrics::Gauge::createPtr(prefix, ".sample_rate");
+    m_sampled_out       = Metrics::Counter::createPtr(prefix, ".entries_sampled_out");
+    Metrics::Gauge::store(m_sample_rate_gauge, 1);
+  }
+}
+
+void
+LogObject::update_sample_rate(ink_hrtime now)
+{
+  if (m_sample_max_rate <= 1 || now - m_sample_updated < SAMPLE_UPDATE_INTERVAL) {
+    return;
+  }
+  m_sample_updated = now;
+
+  // Buffers are dropped when too many wait to be preprocessed, and the
+  // flush lag of the file grows when they are written slower than logged.
+  int occupancy = 0;
+  for (int i = 0; i < m_flush_threads; ++i) {
+    occupancy = std::max(occupancy, m_buffer_manager[i].num_flush_buffers() * 100 / FLUSH_ARRAY_SIZE);
+  }
+  int64_t lag  = m_logFile ? Metrics::Gauge::load(m_logFile->m_flush_lag) : 0;
+  int     rate = m_sample_rate.load(std::memory_order_relaxed);
+  int     next = rate;
+
+  // Back off quickly while the object cannot keep up, and recover one step at a time once it can.
+  if (occupancy >= m_sample_occupancy || lag >= m_sample_lag_ms) {
+    next = std::min(rate * 2, m_sample_max_rate);
+  } else if (occupancy < m_sample_occupancy / 2 && lag < m_sample_lag_ms / 2) {
+    next = std::max(rate / 2, 1);
+  }
+
+  if (next != rate) {
+    Dbg(dbg_ctl_log_sampling, "%s: sample rate %d -> %d, occupancy = %d%%, flush lag = %" PRId64 " ms", m_basename, rate, next,
+        occupancy, lag);
+    m_sample_rate.store(next, std::memory_order_relaxed);
+    Metrics::Gauge::store(m_sample_rate_gauge, next);
+  }
+}
+
 // we compute the object signature from the fieldlist_str and the printf_str
 // of the LogFormat rather than from the format_str because the format_str
 // is not part of a LogBuffer header
@@ -608,6 +669,18 @@ LogObject::log(LogAccess *lad, std::string_view text_entry)
     Dbg(dbg_ctl_log, "entry wiped, ...");
   }
 
+  // Keep 1 in every sample rate entries, and all of the priority ones.
+  if (lad && !m_format->is_aggregate()) {
+    int rate = m_sample_rate.load(std::memory_order_relaxed);
+    if (rate > 1 && lad->is_priority_entry()) {
+      rate = 1;
+    } else if (rate > 1 && m_sample_count.fetch_add(1, std::memory_order_relaxed) % rate != 0) {
+      Metrics::Counter::increment(m_sampled_out);
+      return Log::SKIP;
+    }
+    lad->set_sample_rate(rate);
+  }
+
   if (lad && m_format->is_aggregate()) {
     // marshal the field data into the temp space provided by the
     // LogFormat object for aggregate formats
@@ -1165,7 +1238,14 @@ LogObjectManager::preproc_buffers(int idx)
 {
   size_t buffers_preproced = 0;
 
+  // The first preprocess thread, which is woken at least once a second,
+  // adjusts the sample rates to the buffers waiting for it.
+  ink_hrtime now = idx == 0 ? ink_get_hrtime() : 0;
+
   for (auto &_object : this->_objects) {
+    if (idx == 0) {
+      _object->update_sample_rate(now);
+    }
     buffers_preproced += _object->preproc_buffers(idx);
   }
 
@@ -1350,6 +1430,11 @@ LogObjectManager::log(LogAccess *lad)
 {
   int ret = Log::SKIP;
 
+  // The fields the formats have in common are marshalled once.
+  if (this->_objects.size() > 1) {
+    lad->marshal_cache_init(LogField::marshal_slots());
+  }
+
   for (unsigned i = 0; i < this->_objects.size(); i++) {
     ret |= _objects[i]->log(lad);
   }
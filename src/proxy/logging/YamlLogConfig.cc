@@ -118,6 +118,9 @@ TsEnumDescriptor ROLLING_MODE_TEXT = {
 TsEnumDescriptor ROLLING_MODE_LUA = {
   {{"log.roll.none", 0}, {"log.roll.time", 1}, {"log.roll.size", 2}, {"log.roll.both", 3}, {"log.roll.any", 4}}
 };
+TsEnumDescriptor COMPRESSION_TEXT = {
+  {{"none", LOG_FILE_COMPRESSION_NONE}, {"gzip", LOG_FILE_COMPRESSION_GZIP}, {"zstd", LOG_FILE_COMPRESSION_ZSTD}}
+};
 
 std::set<std::string> valid_log_object_keys = {"filename",
                                                "format",
@@ -132,7 +135,12 @@ std::set<std::string> valid_log_object_keys = {"filename",
                                                "rolling_max_count",
                                                "rolling_allow_empty",
                                                "pipe_buffer_size",
-                                               "fast"};
+                                               "fast",
+                                               "compression",
+                                               "compression_level",
+                                               "sampling_max_rate",
+                                               "sampling_occupancy",
+                                               "sampling_lag_ms"};
 
 LogObject *
 YamlLogConfig::decodeLogObject(const YAML::Node &node)
@@ -232,11 +240,51 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
     }
   }
 
+  // streaming compression of ascii files
+  int compression       = LOG_FILE_COMPRESSION_NONE;
+  int compression_level = 0;
+  if (node["compression"]) {
+    auto value  = node["compression"].as<std::string>();
+    compression = COMPRESSION_TEXT.get(value);
+    if (compression < 0) {
+      throw YAML::ParserException(node["compression"].Mark(), "unknown value " + value);
+    }
+    if (compression != LOG_FILE_COMPRESSION_NONE && file_type != LOG_FILE_ASCII) {
+      Warning("Compression should only be set for ascii log objects.");
+      compression = LOG_FILE_COMPRESSION_NONE;
+    }
+  }
+  if (node["compression_level"]) {
+    compression_level = node["compression_level"].as<int>();
+  }
+
+  // adaptive sampling while the object cannot keep up
+  int sampling_max_rate  = 0;
+  int sampling_occupancy = 50;
+  int sampling_lag_ms    = 1000;
+  if (node["sampling_max_rate"]) {
+    sampling_max_rate = node["sampling_max_rate"].as<int>();
+  }
+  if (node["sampling_occupancy"]) {
+    sampling_occupancy = node["sampling_occupancy"].as<int>();
+    if (sampling_occupancy < 1 || sampling_occupancy > 100) {
+      throw YAML::ParserException(node["sampling_occupancy"].Mark(), "sampling_occupancy must be 1 to 100");
+    }
+  }
+  if (node["sampling_lag_ms"]) {
+    sampling_lag_ms = node["sampling_lag_ms"].as<int>();
+    if (sampling_lag_ms < 1) {
+      throw YAML::ParserException(node["sampling_lag_ms"].Mark(), "sampling_lag_ms must be positive");
+    }
+  }
+
   auto logObject = new LogObject(cfg, fmt, cfg->logfile_dir, filename.c_str(), file_type, header.c_str(),
                                  static_cast<Log::RollingEnabledValues>(obj_rolling_enabled), cfg->preproc_threads,
                                  obj_rolling_interval_sec, obj_rolling_offset_hr, obj_rolling_size_mb, /* auto_created */ false,
                                  /* rolling_max_count */ obj_rolling_max_count, /* rolling_min_count */ obj_rolling_min_count,
-                                 /* reopen_after_rolling */ obj_rolling_allow_empty > 0, pipe_buffer_size, fast);
+                                 /* reopen_after_rolling */ obj_rolling_allow_empty > 0, pipe_buffer_size, fast,
+                                 static_cast<LogFileCompression>(compression), compression_level);
+  logObject->set_sampling(sampling_max_rate, sampling_occupancy, sampling_lag_ms);
 
   // Generate LogDeletingInfo entry for later use
   std::string ext;
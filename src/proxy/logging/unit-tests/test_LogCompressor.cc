@@ -0,0 +1,120 @@
+/** @file
+
+  Catch-based tests for LogCompressor.h.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "proxy/logging/LogCompressor.h"
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+namespace
+{
+std::string
+make_lines(int first, int count)
+{
+  std::string lines;
+
+  for (int i = first; i < first + count; ++i) {
+    lines += "1700000000.000 " + std::to_string(i) + " 192.0.2.10 TCP_HIT/200 5120 GET http://www.example.com/ - NONE/- image/png\n";
+  }
+  return lines;
+}
+
+/// The contents of the gzip file @a path, of all its members.
+std::string
+gunzip(const char *path)
+{
+  std::string data;
+  char        buf[4096];
+  gzFile      gz = gzopen(path, "rb");
+  int         n;
+
+  REQUIRE(gz != nullptr);
+  while ((n = gzread(gz, buf, sizeof(buf))) > 0) {
+    data.append(buf, n);
+  }
+  REQUIRE(n == 0);
+  gzclose(gz);
+  return data;
+}
+
+struct TempFile {
+  char path[32] = "/tmp/logcompressorXXXXXX";
+  int  fd       = mkstemp(path);
+
+  ~TempFile()
+  {
+    close(fd);
+    unlink(path);
+  }
+};
+
+} // namespace
+
+TEST_CASE("LogCompressor gzip", "[LogCompressor]")
+{
+  TempFile                       file;
+  std::unique_ptr<LogCompressor> gzip{LogCompressor::create(LOG_FILE_COMPRESSION_GZIP, 0)};
+  std::string                    first  = make_lines(0, 1000);
+  std::string                    second = make_lines(1000, 10);
+
+  REQUIRE(file.fd >= 0);
+  REQUIRE(gzip);
+  CHECK(std::string(LogCompressor::extension(LOG_FILE_COMPRESSION_GZIP)) == ".gz");
+
+  SECTION("Each write can be read back before the stream is finished")
+  {
+    REQUIRE(gzip->write(file.fd, first.data(), first.size()) > 0);
+    CHECK(gunzip(file.path) == first);
+    REQUIRE(gzip->write(file.fd, second.data(), second.size()) > 0);
+    CHECK(gunzip(file.path) == first + second);
+
+    int bytes = gzip->write(file.fd, first.data(), first.size());
+    CHECK(bytes > 0);
+    CHECK(bytes < static_cast<int>(first.size()) / 4);
+  }
+
+  SECTION("A file appended to after it was finished is read as one")
+  {
+    REQUIRE(gzip->write(file.fd, first.data(), first.size()) > 0);
+    REQUIRE(gzip->finish(file.fd) > 0);
+    // Nothing was written since, so there is nothing to finish.
+    CHECK(gzip->finish(file.fd) == 0);
+    REQUIRE(gzip->write(file.fd, second.data(), second.size()) > 0);
+    REQUIRE(gzip->finish(file.fd) > 0);
+    CHECK(gunzip(file.path) == first + second);
+  }
+}
+
+TEST_CASE("LogCompressor none", "[LogCompressor]")
+{
+  CHECK(LogCompressor::create(LOG_FILE_COMPRESSION_NONE, 0) == nullptr);
+  CHECK(std::string(LogCompressor::extension(LOG_FILE_COMPRESSION_NONE)).empty());
+}
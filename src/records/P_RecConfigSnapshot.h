@@ -0,0 +1,95 @@
+/** @file
+
+  Immutable snapshot of the config records, for reads without locks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "P_RecDefs.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+/*-------------------------------------------------------------------------
+  RecConfigSnapshot
+
+  A copy of all the config records, published through an atomic pointer
+  when the config update callbacks have run, so that the readers of config
+  records take neither g_records_rwlock nor the record locks.
+
+  Each change to a config record advances the records generation, and a
+  snapshot is only used while its generation is the current one. Until the
+  next snapshot is published, readers fall back to the records table, so
+  they never see a value older than the last one set.
+
+  A snapshot that is replaced is freed no sooner than RETIRE_SECONDS later,
+  and readers must not keep one, or a record in it, for longer than that.
+  -------------------------------------------------------------------------*/
+
+class RecConfigSnapshot
+{
+public:
+  static constexpr int RETIRE_SECONDS = 60;
+
+  ~RecConfigSnapshot();
+
+  /// @return The current snapshot, or @c nullptr if config records changed since it was published.
+  static const RecConfigSnapshot *current();
+
+  /// Publish a new snapshot if config records changed since the last one.
+  static void publish();
+
+  /// Note a change to a config record. The caller holds the record, or g_records_rwlock.
+  static void invalidate();
+
+  /// @return The config record @a name, or @c nullptr if there is none.
+  const RecRecord *find(std::string_view name) const;
+
+  /// @return The number of records in the snapshot.
+  int
+  size() const
+  {
+    return _count;
+  }
+
+  /// @return The @a i th config record, in the order of the records table.
+  const RecRecord &
+  operator[](int i) const
+  {
+    return _records[i];
+  }
+
+  uint64_t
+  generation() const
+  {
+    return _generation;
+  }
+
+private:
+  explicit RecConfigSnapshot(uint64_t generation);
+
+  uint64_t                                  _generation;
+  int                                       _count = 0;
+  std::unique_ptr<RecRecord[]>              _records;
+  std::unordered_map<std::string_view, int> _index;
+};
@@ -30,6 +30,7 @@
 #include "P_RecUtils.h"
 #include "P_RecMessage.h"
 #include "P_RecCore.h"
+#include "P_RecConfigSnapshot.h"
 #include "records/RecYAMLDecoder.h"
 
 #include "swoc/bwf_std.h"
@@ -173,6 +174,7 @@ RecSetRecord(RecT rec_type, const char *name, RecDataT data_type, RecData *data,
           r1->stat_meta.data_raw = *data_raw;
         } else if (REC_TYPE_IS_CONFIG(r1->rec_type)) {
           r1->config_meta.source = source;
+          RecConfigSnapshot::invalidate();
         }
       }
       rec_mutex_release(&(r1->lock));
@@ -199,6 +201,9 @@ RecSetRecord(RecT rec_type, const char *name, RecDataT data_type, RecData *data,
     }
     // else, error if  from rec_type?
     g_records_ht.emplace(name, r1);
+    if (REC_TYPE_IS_CONFIG(r1->rec_type)) {
+      RecConfigSnapshot::invalidate();
+    }
   }
 
 Ldone:
@@ -441,6 +446,7 @@ RecExecConfigUpdateCbs(unsigned int update_required_type)
           cur_callback->update_cb(r->name, r->data_type, r->data, cur_callback->update_cookie);
         }
         r->config_meta.update_required = r->config_meta.update_required & ~update_required_type;
+        RecConfigSnapshot::invalidate();
       }
     }
     rec_mutex_release(&(r->lock));
@@ -448,6 +454,9 @@ RecExecConfigUpdateCbs(unsigned int update_required_type)
 
   ink_rwlock_unlock(&g_records_rwlock);
 
+  // The records have their updated values, for the readers of the snapshot.
+  RecConfigSnapshot::publish();
+
   return update_type;
 }
 
@@ -469,6 +478,7 @@ RecSetSyncRequired(char *name, bool lock)
       r1->sync_required = REC_PEER_SYNC_REQUIRED;
       if (REC_TYPE_IS_CONFIG(r1->rec_type)) {
         r1->config_meta.update_required = REC_UPDATE_REQUIRED;
+        RecConfigSnapshot::invalidate();
       }
       rec_mutex_release(&(r1->lock));
       err = REC_ERR_OKAY;
@@ -0,0 +1,153 @@
+/** @file
+
+  Immutable snapshot of the config records, for reads without locks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_RecConfigSnapshot.h"
+#include "P_RecCore.h"
+#include "P_RecUtils.h"
+
+#include "tscore/ink_hrtime.h"
+#include "tscore/ink_memory.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// The generation starts ahead of that of any snapshot, so none is current until one is published.
+std::atomic<uint64_t>                  g_generation{1};
+std::atomic<const RecConfigSnapshot *> g_snapshot{nullptr};
+
+// Publishing, and the snapshots replaced, with the time they were.
+std::mutex                                                    g_publish_mutex;
+std::vector<std::pair<ink_hrtime, const RecConfigSnapshot *>> g_retired;
+
+void
+copy_record(RecRecord *dst, const RecRecord *src)
+{
+  dst->rec_type      = src->rec_type;
+  dst->data_type     = src->data_type;
+  dst->name          = src->name; // Record names are never freed.
+  dst->sync_required = src->sync_required;
+  dst->registered    = src->registered;
+  dst->version       = src->version;
+  dst->order         = src->order;
+  dst->rsb_id        = src->rsb_id;
+  RecDataSet(src->data_type, &dst->data, const_cast<RecData *>(&src->data));
+  RecDataSet(src->data_type, &dst->data_default, const_cast<RecData *>(&src->data_default));
+
+  dst->config_meta                = src->config_meta;
+  dst->config_meta.update_cb_list = nullptr;
+  dst->config_meta.update_cookie  = nullptr;
+  dst->config_meta.check_expr     = ats_strdup(src->config_meta.check_expr);
+}
+} // end anonymous namespace
+
+RecConfigSnapshot::RecConfigSnapshot(uint64_t generation) : _generation(generation)
+{
+  int num_records = g_num_records;
+
+  _records = std::make_unique<RecRecord[]>(num_records);
+  for (int i = 0; i < num_records; ++i) {
+    RecRecord *r = &g_records[i];
+
+    if (!REC_TYPE_IS_CONFIG(r->rec_type)) {
+      continue;
+    }
+
+    RecRecord *dst = &_records[_count];
+
+    rec_mutex_acquire(&r->lock);
+    copy_record(dst, r);
+    rec_mutex_release(&r->lock);
+    _index.emplace(dst->name, _count++);
+  }
+}
+
+RecConfigSnapshot::~RecConfigSnapshot()
+{
+  for (int i = 0; i < _count; ++i) {
+    RecDataZero(_records[i].data_type, &_records[i].data);
+    RecDataZero(_records[i].data_type, &_records[i].data_default);
+    ats_free(_records[i].config_meta.check_expr);
+  }
+}
+
+const RecConfigSnapshot *
+RecConfigSnapshot::current()
+{
+  const RecConfigSnapshot *snapshot = g_snapshot.load(std::memory_order_acquire);
+
+  if (snapshot && snapshot->_generation == g_generation.load(std::memory_order_acquire)) {
+    return snapshot;
+  }
+  return nullptr;
+}
+
+void
+RecConfigSnapshot::invalidate()
+{
+  g_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void
+RecConfigSnapshot::publish()
+{
+  std::lock_guard<std::mutex> guard(g_publish_mutex);
+  const RecConfigSnapshot    *previous = g_snapshot.load(std::memory_order_relaxed);
+
+  // The generation is read before the records are, so a change made while
+  // they are copied leaves this snapshot out of date.
+  uint64_t generation = g_generation.load(std::memory_order_acquire);
+  if (previous && previous->_generation == generation) {
+    return;
+  }
+
+  ink_rwlock_rdlock(&g_records_rwlock);
+  auto *snapshot = new RecConfigSnapshot(generation);
+  ink_rwlock_unlock(&g_records_rwlock);
+
+  g_snapshot.store(snapshot, std::memory_order_release);
+
+  ink_hrtime now = ink_get_hrtime();
+  std::erase_if(g_retired, [now](auto const &retired) {
+    if (now - retired.first < HRTIME_SECONDS(RETIRE_SECONDS)) {
+      return false;
+    }
+    delete retired.second;
+    return true;
+  });
+  if (previous) {
+    g_retired.emplace_back(now, previous);
+  }
+}
+
+const RecRecord *
+RecConfigSnapshot::find(std::string_view name) const
+{
+  if (auto it = _index.find(name); it != _index.end()) {
+    return &_records[it->second];
+  }
+  return nullptr;
+}
@@ -34,6 +34,7 @@
 #include "records/RecordsConfig.h"
 #include "P_RecFile.h"
 #include "P_RecCore.h"
+#include "P_RecConfigSnapshot.h"
 #include "P_RecUtils.h"
 #include "tscore/Layout.h"
 #include "tsutil/ts_errata.h"
@@ -50,6 +51,20 @@ std::unordered_map<std::string, RecRecord *> g_records_ht;
 ink_rwlock                                   g_records_rwlock;
 int                                          g_num_records = 0;
 
+//-------------------------------------------------------------------------
+// snapshot_find
+//
+// The config record @a name in the current snapshot, read without locks,
+// or nullptr if it is to be found in the records table.
+//-------------------------------------------------------------------------
+static const RecRecord *
+snapshot_find(const char *name)
+{
+  const RecConfigSnapshot *snapshot = RecConfigSnapshot::current();
+
+  return snapshot ? snapshot->find(name) : nullptr;
+}
+
 //-------------------------------------------------------------------------
 // register_record
 //-------------------------------------------------------------------------
@@ -433,6 +448,18 @@ RecGetRecordString(const char *name, char *buf, int buf_len, bool lock)
 {
   RecErrT err = REC_ERR_OKAY;
 
+  if (const RecRecord *r = snapshot_find(name); r) {
+    if (!r->registered || (r->data_type != RECD_STRING)) {
+      return REC_ERR_FAIL;
+    }
+    if (r->data.rec_string == nullptr) {
+      buf[0] = '\0';
+    } else {
+      ink_strlcpy(buf, r->data.rec_string, buf_len);
+    }
+    return REC_ERR_OKAY;
+  }
+
   if (lock) {
     ink_rwlock_rdlock(&g_records_rwlock);
   }
@@ -519,7 +546,7 @@ RecLookupRecord(const char *name, void (*callback)(const RecRecord *, void *), v
   auto         it      = metrics.find(name);
 
   if (it != metrics.end()) {
-    RecRecord r;
+    RecRecord r{};
     auto &&[name, val] = *it;
 
     r.rec_type     = RECT_PLUGIN;
@@ -529,6 +556,9 @@ RecLookupRecord(const char *name, void (*callback)(const RecRecord *, void *), v
 
     callback(&r, data);
     err = REC_ERR_OKAY;
+  } else if (const RecRecord *r = snapshot_find(name); r) {
+    callback(r, data);
+    err = REC_ERR_OKAY;
   } else {
     if (lock) {
       ink_rwlock_rdlock(&g_records_rwlock);
@@ -555,23 +585,32 @@ RecErrT
 RecLookupMatchingRecords(unsigned rec_type, const char *match, void (*callback)(const RecRecord *, void *), void *data,
                          bool /* lock ATS_UNUSED */)
 {
-  int num_records;
   DFA regex;
 
   if (!regex.compile(match, RE_CASE_INSENSITIVE | RE_UNANCHORED)) {
     return REC_ERR_FAIL;
   }
 
+  return RecLookupMatchingRecords(
+    rec_type, [&regex](RecT, std::string_view name) { return regex.match(name) >= 0; }, callback, data);
+}
+
+RecErrT
+RecLookupMatchingRecords(unsigned rec_type, std::function<bool(RecT, std::string_view)> const &match, RecLookupCallback callback,
+                         void *data)
+{
+  int num_records;
+
   if ((rec_type & (RECT_PROCESS | RECT_NODE | RECT_PLUGIN))) {
     // First find the new metrics, this is a bit of a hack, because we still use the old
     // librecords callback with a "pseudo" record.
-    RecRecord tmp;
+    RecRecord tmp{};
 
     tmp.rec_type  = RECT_PROCESS;
     tmp.data_type = RECD_INT;
 
     for (auto &&[name, val] : ts::Metrics::instance()) {
-      if (regex.match(name.data()) >= 0) {
+      if (match(RECT_PROCESS, name)) {
         tmp.name         = name.data();
         tmp.data.rec_int = val;
         callback(&tmp, data);
@@ -580,6 +619,18 @@ RecLookupMatchingRecords(unsigned rec_type, const char *match, void (*callback)(
     // Fall through to return any matching string metrics
   }
 
+  // Only config records are in the snapshot.
+  if (const RecConfigSnapshot *snapshot = RecConfigSnapshot::current(); snapshot && !(rec_type & ~RECT_CONFIG & ~RECT_LOCAL)) {
+    for (int i = 0; i < snapshot->size(); i++) {
+      const RecRecord &r = (*snapshot)[i];
+
+      if ((r.rec_type & rec_type) != 0 && match(r.rec_type, r.name)) {
+        callback(&r, data);
+      }
+    }
+    return REC_ERR_OKAY;
+  }
+
   num_records = g_num_records;
   for (int i = 0; i < num_records; i++) {
     RecRecord *r = &(g_records[i]);
@@ -588,7 +639,7 @@ RecLookupMatchingRecords(unsigned rec_type, const char *match, void (*callback)(
       continue;
     }
 
-    if (regex.match(r->name) < 0) {
+    if (!match(r->rec_type, r->name)) {
       continue;
     }
 
@@ -762,6 +813,7 @@ RecRegisterConfig(RecT rec_type, const char *name, RecDataT data_type, RecData d
     if (!updated_p) {
       r->config_meta.source = source;
     }
+    RecConfigSnapshot::invalidate();
   }
   ink_rwlock_unlock(&g_records_rwlock);
 
@@ -776,6 +828,15 @@ RecGetRecord_Xmalloc(const char *name, RecDataT data_type, RecData *data, bool l
 {
   RecErrT err = REC_ERR_OKAY;
 
+  if (const RecRecord *r = snapshot_find(name); r) {
+    if (!r->registered || (r->data_type != data_type)) {
+      return REC_ERR_FAIL;
+    }
+    memset(data, 0, sizeof(RecData));
+    RecDataSet(data_type, data, const_cast<RecData *>(&r->data));
+    return REC_ERR_OKAY;
+  }
+
   if (lock) {
     ink_rwlock_rdlock(&g_records_rwlock);
   }
@@ -847,6 +908,7 @@ RecForceInsert(RecRecord *record)
     r->config_meta.check_expr  = ats_strdup(record->config_meta.check_expr);
     r->config_meta.access_type = record->config_meta.access_type;
     r->config_meta.source      = record->config_meta.source;
+    RecConfigSnapshot::invalidate();
   }
 
   if (r_is_a_new_record) {
@@ -0,0 +1,92 @@
+/** @file
+
+  Catch-based tests for the config records snapshot.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_RecConfigSnapshot.h"
+#include "../P_RecCore.h"
+
+#include <string>
+#include <vector>
+
+TEST_CASE("RecConfigSnapshot", "[librecords][RecConfigSnapshot]")
+{
+  RecInt value = 0;
+  char   buf[64];
+
+  REQUIRE(RecRegisterConfigInt(RECT_CONFIG, "proxy.config.test.snapshot.int", 1, RECU_DYNAMIC, RECC_NULL, nullptr,
+                               REC_SOURCE_DEFAULT) == REC_ERR_OKAY);
+  REQUIRE(RecRegisterConfigString(RECT_CONFIG, "proxy.config.test.snapshot.str", "one", RECU_DYNAMIC, RECC_NULL, nullptr,
+                                  REC_SOURCE_DEFAULT) == REC_ERR_OKAY);
+
+  // A registration leaves any snapshot out of date.
+  CHECK(RecConfigSnapshot::current() == nullptr);
+
+  RecConfigSnapshot::publish();
+  const RecConfigSnapshot *snapshot = RecConfigSnapshot::current();
+  REQUIRE(snapshot != nullptr);
+  REQUIRE(snapshot->find("proxy.config.test.snapshot.int") != nullptr);
+
+  SECTION("Reads are from the snapshot")
+  {
+    CHECK(RecGetRecordInt("proxy.config.test.snapshot.int", &value) == REC_ERR_OKAY);
+    CHECK(value == 1);
+    CHECK(RecGetRecordString("proxy.config.test.snapshot.str", buf, sizeof(buf)) == REC_ERR_OKAY);
+    CHECK(std::string(buf) == "one");
+    CHECK(RecGetRecordString("proxy.config.test.snapshot.int", buf, sizeof(buf)) == REC_ERR_FAIL);
+    CHECK(RecGetRecordInt("proxy.config.test.snapshot.missing", &value) == REC_ERR_FAIL);
+  }
+
+  SECTION("A value set is read before the next snapshot is published")
+  {
+    REQUIRE(RecSetRecordInt("proxy.config.test.snapshot.int", 2, REC_SOURCE_EXPLICIT) == REC_ERR_OKAY);
+    CHECK(RecConfigSnapshot::current() == nullptr);
+    CHECK(RecGetRecordInt("proxy.config.test.snapshot.int", &value) == REC_ERR_OKAY);
+    CHECK(value == 2);
+
+    RecConfigSnapshot::publish();
+    REQUIRE(RecConfigSnapshot::current() != nullptr);
+    CHECK(RecConfigSnapshot::current() != snapshot);
+    CHECK(RecConfigSnapshot::current()->generation() > snapshot->generation());
+    CHECK(RecGetRecordInt("proxy.config.test.snapshot.int", &value) == REC_ERR_OKAY);
+    CHECK(value == 2);
+  }
+
+  SECTION("Nothing is published if nothing changed")
+  {
+    RecConfigSnapshot::publish();
+    CHECK(RecConfigSnapshot::current() == snapshot);
+  }
+
+  SECTION("Matching config records are found in the snapshot")
+  {
+    std::vector<std::string> names;
+
+    RecLookupMatchingRecords(
+      RECT_CONFIG, "proxy\\.config\\.test\\.snapshot\\..*",
+      [](const RecRecord *r, void *data) { static_cast<std::vector<std::string> *>(data)->push_back(r->name); }, &names);
+    REQUIRE(names.size() == 2);
+    CHECK(names[0] == "proxy.config.test.snapshot.int");
+    CHECK(names[1] == "proxy.config.test.snapshot.str");
+  }
+}
@@ -25,6 +25,7 @@
 
 #include <iostream>
 #include <fcntl.h>
+#include <sys/mman.h>
 
 #include "tscore/ink_assert.h"
 
@@ -225,7 +226,7 @@ StripeSM::StripeSM(Span *span, const Bytes &start, const CacheStoreBlocks &len)
 {
   swoc::bwprint(hashText, "{} {}:{}", span->_path.view(), _start.count(), _len.count());
   CryptoContext().hash_immediate(hash_id, hashText.data(), static_cast<int>(hashText.size()));
-  printf("hash id of stripe is hash of %.*s\n", static_cast<int>(hashText.size()), hashText.data());
+  fprintf(stderr, "hash id of stripe is hash of %.*s\n", static_cast<int>(hashText.size()), hashText.data());
 }
 
 bool
@@ -631,6 +632,42 @@ StripeSM::loadDir()
   }
   return zret;
 }
+Errata
+StripeSM::mapDir()
+{
+  Errata  zret;
+  int64_t dirlen = this->vol_dirlen();
+  int64_t start  = this->_start.count();
+
+  // Map the copy the cache would use, the one synced last of those with matching header and footer.
+  auto valid = [this](Copy c) { return _meta[c][HEAD].sync_serial == _meta[c][FOOT].sync_serial; };
+  if (valid(B) && (!valid(A) || _meta[B][HEAD].sync_serial > _meta[A][HEAD].sync_serial)) {
+    start += dirlen;
+  }
+  // The mapping must start on a page, the stripe need only start on a store block.
+  int64_t skip = start % ats_pagesize();
+  void   *addr = mmap(nullptr, dirlen + skip, PROT_READ, MAP_SHARED, this->_span->_fd, start - skip);
+
+  if (addr == MAP_FAILED) {
+    return Errata(make_errno_code(), "Failed to map Dir from stripe @{}", this->hashText);
+  }
+  // The directory is walked once from start to end.
+  madvise(addr, dirlen + skip, MADV_SEQUENTIAL);
+  _dir_map.assign(addr, dirlen + skip);
+  dir = reinterpret_cast<CacheDirEntry *>(static_cast<char *>(addr) + skip + this->vol_headerlen());
+  return zret;
+}
+
+void
+StripeSM::unmapDir()
+{
+  if (_dir_map.data()) {
+    munmap(_dir_map.data(), _dir_map.size());
+    _dir_map = MemSpan<void>{};
+    dir = nullptr;
+  }
+}
+
 //
 // Cache Directory
 //
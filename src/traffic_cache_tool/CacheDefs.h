@@ -164,6 +164,8 @@ public:
   uint16_t      freelist[1];
 };
 
+constexpr uint32_t DOC_MAGIC = 0x5F129B13; ///< Magic of a valid @c Doc.
+
 struct Doc {
   uint32_t magic;     // DOC_MAGIC
   uint32_t len;       // length of this fragment (including hlen & sizeof(Doc), unrounded)
@@ -518,6 +520,10 @@ struct StripeSM {
   /// Load metadata for this stripe.
   Errata loadMeta();
   Errata loadDir();
+  /// Map the directory read only instead of reading it, see @c loadDir.
+  Errata mapDir();
+  /// Unmap the directory mapped by @c mapDir.
+  void   unmapDir();
   int    check_loop(int s);
   void   dir_check();
   bool   walk_bucket_chain(int s); // returns true if there is a loop
@@ -548,6 +554,7 @@ struct StripeSM {
   /// Directory.
   Chunk                _directory;
   CacheDirEntry const *dir      = nullptr; // the big buffer that will hold the whole directory of stripe header.
+  MemSpan<void>        _dir_map;           ///< Mapping of the directory, if it was mapped.
   uint16_t            *freelist = nullptr; // using this freelist instead of the one in StripeMeta.
                                            // This is because the freelist is not being copied to _metap[2][2] correctly.
   // need to do something about it .. hmmm :-?
@@ -27,12 +27,231 @@
 #include "proxy/hdrs/MIME.h"
 #include "proxy/hdrs/URL.h"
 
+#include <bit>
+#include <cstring>
+#include <ostream>
+
 // using namespace ct;
 
 constexpr HdrHeapMarshalBlocks HTTP_ALT_MARSHAL_SIZE = swoc::round_up(sizeof(HTTPCacheAlt));
 
+namespace
+{
+void
+write_json_string(std::ostream &out, std::string_view text)
+{
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      static constexpr char HEX[] = "0123456789abcdef";
+      out << "\\u00" << HEX[c >> 4] << HEX[c & 0xf];
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void
+write_json_histogram(std::ostream &out, ct::ScanReport::Histogram const &histogram)
+{
+  bool first = true;
+
+  out << '[';
+  for (int i = 0; i < ct::ScanReport::N_BUCKETS; ++i) {
+    if (histogram[i]) {
+      uint64_t min = i ? uint64_t{1} << (i - 1) : 0;
+      uint64_t max = i ? (uint64_t{1} << i) - 1 : 0;
+      out << (first ? "" : ", ") << R"({"min": )" << min << R"(, "max": )" << max << R"(, "count": )" << histogram[i] << '}';
+      first = false;
+    }
+  }
+  out << ']';
+}
+} // end anonymous namespace
+
 namespace ct
 {
+void
+ScanReport::count(Histogram &histogram, uint64_t value)
+{
+  ++histogram[std::min<int>(std::bit_width(value), N_BUCKETS - 1)];
+}
+
+void
+ScanReport::sample(std::string &&url)
+{
+  ++urls_seen;
+  if (urls.size() < URL_SAMPLE_SIZE) {
+    urls.push_back(std::move(url));
+  } else if (uint64_t i = std::uniform_int_distribution<uint64_t>(0, urls_seen - 1)(random); i < URL_SAMPLE_SIZE) {
+    urls[i] = std::move(url);
+  }
+}
+
+void
+ScanReport::merge(ScanReport &that)
+{
+  stripes    += that.stripes;
+  dir_used   += that.dir_used;
+  objects    += that.objects;
+  alternates += that.alternates;
+  errors     += that.errors;
+  for (int i = 0; i < N_BUCKETS; ++i) {
+    size[i]      += that.size[i];
+    age[i]       += that.age[i];
+    alternate[i] += that.alternate[i];
+  }
+
+  // Each URL of a sample stands for the URLs its report saw divided by its size, so the URLs are
+  // taken from either sample in proportion to those to keep the merged sample uniform.
+  std::vector<std::string> *from[2]   = {&urls, &that.urls};
+  double                    weight[2] = {urls.empty() ? 0.0 : static_cast<double>(urls_seen) / urls.size(),
+                                         that.urls.empty() ? 0.0 : static_cast<double>(that.urls_seen) / that.urls.size()};
+  std::vector<std::string>  merged;
+
+  while (merged.size() < URL_SAMPLE_SIZE && !(urls.empty() && that.urls.empty())) {
+    double left  = weight[0] * urls.size();
+    double total = left + weight[1] * that.urls.size();
+    auto  &side  = *from[std::uniform_real_distribution<double>(0, total)(random) < left ? 0 : 1];
+    size_t i     = std::uniform_int_distribution<size_t>(0, side.size() - 1)(random);
+
+    merged.push_back(std::move(side[i]));
+    side[i] = std::move(side.back());
+    side.pop_back();
+  }
+  urls       = std::move(merged);
+  urls_seen += that.urls_seen;
+}
+
+void
+ScanReport::write_json(std::ostream &out) const
+{
+  out << "{\n";
+  out << R"(  "stripes": )" << stripes << ",\n";
+  out << R"(  "dir_entries_used": )" << dir_used << ",\n";
+  out << R"(  "objects": )" << objects << ",\n";
+  out << R"(  "alternates": )" << alternates << ",\n";
+  out << R"(  "errors": )" << errors << ",\n";
+  out << R"(  "object_size_bytes": )";
+  write_json_histogram(out, size);
+  out << ",\n" << R"(  "age_seconds": )";
+  write_json_histogram(out, age);
+  out << ",\n" << R"(  "alternates_per_object": )";
+  write_json_histogram(out, alternate);
+  out << ",\n" << R"(  "urls_seen": )" << urls_seen << ",\n";
+  out << R"(  "url_sample": [)";
+  for (size_t i = 0; i < urls.size(); ++i) {
+    out << (i ? ",\n    " : "\n    ");
+    write_json_string(out, urls[i]);
+  }
+  out << (urls.empty() ? "]\n" : "\n  ]\n") << "}" << std::endl;
+}
+
+Errata
+CacheScan::Inspect(ScanReport &report, time_t now)
+{
+  int64_t            buff_size = 1048576; // 1M
+  Errata             zret;
+  std::bitset<65536> dir_bitset;
+  char              *buff = static_cast<char *>(ats_memalign(ats_pagesize(), buff_size));
+
+  ++report.stripes;
+  for (int s = 0; s < this->stripe->_segments; s++) {
+    CacheDirEntry *seg = this->stripe->dir_segment(s);
+    dir_bitset.reset();
+    for (int b = 0; b < this->stripe->_buckets; b++) {
+      CacheDirEntry *e = dir_bucket(b, seg);
+      if (!dir_offset(e)) {
+        continue;
+      }
+      do {
+        // loop detected
+        if (dir_bitset[dir_to_offset(e, seg)]) {
+          break;
+        }
+        dir_bitset[dir_to_offset(e, seg)] = true;
+        ++report.dir_used;
+
+        // Only the first fragment of an object has its alternates, the other fragments are not read.
+        if (dir_head(e)) {
+          int64_t size = dir_approx_size(e);
+          if (size > buff_size) {
+            ats_free(buff);
+            buff_size = size;
+            buff      = static_cast<char *>(ats_memalign(ats_pagesize(), buff_size));
+          }
+
+          ssize_t n   = pread(this->stripe->_span->_fd, buff, size, this->stripe->stripe_offset(e));
+          Doc    *doc = reinterpret_cast<Doc *>(buff);
+          if (n < static_cast<ssize_t>(sizeof(Doc)) || doc->magic != ts::DOC_MAGIC || doc->hlen > n - sizeof(Doc)) {
+            ++report.errors;
+          } else {
+            int n_alternates = this->inspect_alternates(report, doc->hdr(), doc->hlen, now);
+            if (n_alternates > 0) {
+              ++report.objects;
+              ScanReport::count(report.alternate, n_alternates);
+            } else if (n_alternates < 0) {
+              ++report.errors;
+            }
+          }
+        }
+        e = next_dir(e, seg);
+      } while (e);
+    }
+  }
+  ats_free(buff);
+
+  return zret;
+}
+
+int
+CacheScan::inspect_alternates(ScanReport &report, char *buf, int length, time_t now)
+{
+  char               *start        = buf;
+  int                 n_alternates = 0;
+  swoc::MemSpan<char> doc_mem(buf, length);
+
+  while (length - (buf - start) > static_cast<int>(sizeof(HTTPCacheAlt))) {
+    HTTPCacheAlt *a = reinterpret_cast<HTTPCacheAlt *>(buf);
+
+    if (a->m_magic != CACHE_ALT_MAGIC_MARSHALED) {
+      break;
+    }
+    if (this->unmarshal(buf, length - (buf - start), nullptr).length() || a->m_unmarshal_len <= 0 || !a->m_request_hdr.m_http ||
+        !doc_mem.contains(reinterpret_cast<char *>(a->m_request_hdr.m_http))) {
+      return -1;
+    }
+
+    int64_t object_size;
+    static_assert(sizeof(object_size) == sizeof(a->m_object_size));
+    memcpy(&object_size, a->m_object_size, sizeof(object_size));
+    ++n_alternates;
+    ++report.alternates;
+    ScanReport::count(report.size, object_size);
+    if (a->m_response_received_time > 0) {
+      ScanReport::count(report.age, now > a->m_response_received_time ? now - a->m_response_received_time : 0);
+    }
+
+    auto *url = a->m_request_hdr.m_http->u.req.m_url_impl;
+    if (check_url(doc_mem, url)) {
+      std::string str;
+      swoc::bwprint(str, "{}://{}{}{}/{}{}{}", std::string_view(url->m_ptr_scheme, url->m_len_scheme),
+                    std::string_view(url->m_ptr_host, url->m_len_host), url->m_len_port ? ":" : "",
+                    std::string_view(url->m_ptr_port, url->m_len_port), std::string_view(url->m_ptr_path, url->m_len_path),
+                    url->m_len_query ? "?" : "", std::string_view(url->m_ptr_query, url->m_len_query));
+      report.sample(std::move(str));
+    }
+    if (a->m_frag_offsets != a->m_integral_frag_offsets) {
+      ats_free(a->m_frag_offsets);
+    }
+
+    buf += a->m_unmarshal_len;
+  }
+  return n_alternates;
+}
 Errata
 CacheScan::Scan(bool search)
 {
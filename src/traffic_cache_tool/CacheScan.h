@@ -29,14 +29,55 @@
 
 #pragma once
 
+#include <array>
+#include <iosfwd>
+#include <random>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #include "CacheDefs.h"
 
 #include "../../include/proxy/hdrs/HTTP.h"
 // using namespace ct;
 namespace ct
 {
+/** Histograms of the objects in the stripes inspected, and a sample of their URLs.
+
+    Each scanning thread fills its own report, the reports are merged as the threads finish.
+ */
+struct ScanReport {
+  /// Buckets of the histograms, bucket @a i counts values in [2^(i-1), 2^i).
+  static constexpr int N_BUCKETS = 48;
+  /// Number of URLs sampled.
+  static constexpr size_t URL_SAMPLE_SIZE = 100;
+
+  using Histogram = std::array<uint64_t, N_BUCKETS>;
+
+  uint64_t  stripes    = 0; ///< Stripes inspected.
+  uint64_t  dir_used   = 0; ///< Directory entries in use, of all fragments.
+  uint64_t  objects    = 0; ///< First fragments of objects.
+  uint64_t  alternates = 0; ///< Alternates of those objects.
+  uint64_t  errors     = 0; ///< First fragments that could not be read or parsed.
+  Histogram size{};         ///< Alternates by object size in bytes.
+  Histogram age{};          ///< Alternates by seconds since the response was received, if it is known.
+  Histogram alternate{};    ///< Objects by number of alternates.
+
+  /// Reservoir sample of the URLs of the alternates seen.
+  std::vector<std::string> urls;
+  uint64_t                 urls_seen = 0;
+  std::minstd_rand         random{std::random_device{}()};
+
+  /// Add @a value to the bucket of @a histogram for it.
+  static void count(Histogram &histogram, uint64_t value);
+  /// Offer @a url to the sample.
+  void sample(std::string &&url);
+  /// Add the counts and sample of @a that.
+  void merge(ScanReport &that);
+  /// Write the report as a JSON object.
+  void write_json(std::ostream &out) const;
+};
+
 class CacheScan
 {
   StripeSM    *stripe    = nullptr;
@@ -52,7 +93,11 @@ public:
   CacheScan(StripeSM *str) : stripe(str) {}
   ~CacheScan() { delete u_matcher; }
   Errata Scan(bool search = false);
+  /// Add the objects of the stripe to @a report, the directory of the stripe must be loaded or mapped.
+  Errata Inspect(ScanReport &report, time_t now);
   Errata get_alternates(const char *buf, int length, bool search);
+  /// Add the alternates in @a buf to @a report, @return the number of them or -1 if they could not be parsed.
+  int    inspect_alternates(ScanReport &report, char *buf, int length, time_t now);
   int    unmarshal(HdrHeap *hh, int buf_length, int obj_type, HdrHeapObjImpl **found_obj, RefCountObj *block_ref);
   Errata unmarshal(char *buf, int len, RefCountObj *block_ref);
   Errata unmarshal(HTTPHdrImpl *obj, intptr_t offset);
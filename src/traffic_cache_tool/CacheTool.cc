@@ -35,6 +35,9 @@
 #include <ctime>
 #include <bitset>
 #include <cinttypes>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #include "tscore/ink_memory.h"
 #include "tscore/ink_file.h"
@@ -1364,11 +1367,60 @@ Scan_Cache(swoc::file::path const &regex_path)
   }
 }
 
+/* Scan the stripes of all the spans in @a n_threads threads, each taking the next stripe not
+   yet scanned, and print the merged report as JSON. The directories are mapped read only rather
+   than read, and only the first fragment of each object is read.
+ */
+void
+Inspect_Cache(unsigned n_threads)
+{
+  Cache                    cache;
+  std::vector<std::thread> threadPool;
+  std::vector<StripeSM *>  stripes;
+  std::atomic<size_t>      next{0};
+  std::mutex               report_mutex;
+  ScanReport               report;
+  time_t                   now = time(nullptr);
+
+  if (!(err = cache.loadSpan(SpanFile)) || err.length()) {
+    return;
+  }
+  for (auto sp : cache._spans) {
+    stripes.insert(stripes.end(), sp->_stripes.begin(), sp->_stripes.end());
+  }
+
+  auto scan_stripes = [&]() -> void {
+    ScanReport local;
+    for (size_t i = next++; i < stripes.size(); i = next++) {
+      StripeSM *strp = stripes[i];
+      strp->loadMeta();
+      if (strp->mapDir().is_ok()) {
+        CacheScan(strp).Inspect(local, now);
+        strp->unmapDir();
+      } else {
+        ++local.errors;
+      }
+    }
+    std::lock_guard<std::mutex> lock(report_mutex);
+    report.merge(local);
+  };
+
+  n_threads = std::max(1u, std::min<unsigned>(n_threads, stripes.size()));
+  for (unsigned i = 0; i < n_threads; ++i) {
+    threadPool.emplace_back(scan_stripes);
+  }
+  for (auto &th : threadPool) {
+    th.join();
+  }
+  report.write_json(std::cout);
+}
+
 int
 main([[maybe_unused]] int argc, const char *argv[])
 {
   swoc::file::path input_url_file;
   std::string      inputFile;
+  unsigned         n_threads = std::thread::hardware_concurrency();
 
   parser.add_global_usage(std::string(argv[0]) + " --spans <SPAN> --volume <FILE> <COMMAND> [<SUBCOMMAND> ...]\n");
   parser.require_commands()
@@ -1378,7 +1430,8 @@ main([[maybe_unused]] int argc, const char *argv[])
     .add_option("--write", "-w", "")
     .add_option("--input", "-i", "", "", 1)
     .add_option("--device", "-d", "", "", 1)
-    .add_option("--aos", "-o", "", "", 1);
+    .add_option("--aos", "-o", "", "", 1)
+    .add_option("--threads", "-t", "", "", 1);
 
   parser.add_command("list", "List elements of the cache", []() { List_Stripes(Cache::SpanDumpDepth::SPAN); })
     .add_command("stripes", "List the stripes", []() { List_Stripes(Cache::SpanDumpDepth::STRIPE); });
@@ -1399,6 +1452,8 @@ main([[maybe_unused]] int argc, const char *argv[])
   parser.add_command("init", " Initializes uninitialized span", [&]() { Init_disk(input_url_file); });
   parser.add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
                      [&]() { Scan_Cache(input_url_file); });
+  parser.add_command("inspect", " Scans the whole cache in parallel and reports the object sizes, ages and alternates as JSON",
+                     [&]() { Inspect_Cache(n_threads); });
 
   // parse the arguments
   auto arguments = parser.parse(argv);
@@ -1417,6 +1472,9 @@ main([[maybe_unused]] int argc, const char *argv[])
   if (auto data = arguments.get("device")) {
     inputFile = data.value();
   }
+  if (auto data = arguments.get("threads")) {
+    n_threads = std::stoi(data.value());
+  }
   if (auto data = arguments.get("write")) {
     OPEN_RW_FLAG = O_RDWR;
     std::cout << "NOTE: Writing to physical devices enabled" << std::endl;
@@ -21,6 +21,7 @@
 #include "mgmt/rpc/jsonrpc/JsonRPC.h"
 
 // Admin API Implementation headers.
+#include "mgmt/rpc/handlers/cache/Cache.h"
 #include "mgmt/rpc/handlers/config/Configuration.h"
 #include "mgmt/rpc/handlers/records/Records.h"
 #include "mgmt/rpc/handlers/storage/Storage.h"
@@ -41,8 +42,8 @@ register_admin_jsonrpc_handlers()
 
   // Records
   using namespace rpc::handlers::records;
-  rpc::add_method_handler("admin_lookup_records", &lookup_records, &core_ats_rpc_service_provider_handle,
-                          {{rpc::NON_RESTRICTED_API}});
+  rpc::add_streaming_method_handler("admin_lookup_records", &lookup_records, &core_ats_rpc_service_provider_handle,
+                                    {{rpc::NON_RESTRICTED_API}});
 
   // plugin
   using namespace rpc::handlers::plugins;
@@ -59,6 +60,8 @@ register_admin_jsonrpc_handlers()
                                 {{rpc::RESTRICTED_API}});
   rpc::add_notification_handler("admin_server_restart", &server_shutdown, &core_ats_rpc_service_provider_handle,
                                 {{rpc::RESTRICTED_API}});
+  rpc::add_method_handler("admin_server_get_lock_contention", &get_lock_contention, &core_ats_rpc_service_provider_handle,
+                          {{rpc::RESTRICTED_API}});
 
   // storage
   using namespace rpc::handlers::storage;
@@ -66,5 +69,9 @@ register_admin_jsonrpc_handlers()
                           {{rpc::RESTRICTED_API}});
   rpc::add_method_handler("admin_storage_get_device_status", &get_storage_status, &core_ats_rpc_service_provider_handle,
                           {{rpc::NON_RESTRICTED_API}});
+
+  // cache
+  using namespace rpc::handlers::cache;
+  rpc::add_method_handler("admin_cache_purge", &cache_purge, &core_ats_rpc_service_provider_handle, {{rpc::RESTRICTED_API}});
 }
 } // namespace rpc::admin
@@ -43,6 +43,7 @@
 #include "tscore/hugepages.h"
 #include "tscore/runroot.h"
 #include "tscore/Filenames.h"
+#include "tsutil/MetricsFile.h"
 
 #include "ts/ts.h" // This is sadly needed because of us using TSThreadInit() for some reason.
 
@@ -2040,6 +2041,11 @@ main(int /* argc ATS_UNUSED */, const char **argv)
   SET_INTERVAL(RecProcess, "proxy.config.raw_stat_sync_interval_ms", raw_stat_sync_interval_ms);
   SET_INTERVAL(RecProcess, "proxy.config.remote_sync_interval_ms", remote_sync_interval_ms);
 
+  RecInt metrics_file = 0;
+  if (RecGetRecordInt("proxy.config.admin.metrics_file", &metrics_file) == REC_ERR_OKAY && metrics_file) {
+    RecProcess_set_metrics_file(Layout::relative_to(RecConfigReadRuntimeDir(), ts::MetricsFile::FILENAME).c_str());
+  }
+
   num_of_net_threads = adjust_num_of_net_threads(num_of_net_threads);
 
   size_t stacksize;
@@ -24,6 +24,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -31,6 +32,8 @@
 #include <sys/time.h>
 
 #include "tscore/ink_assert.h"
+#include "tscore/Layout.h"
+#include "tsutil/MetricsFile.h"
 #include "shared/rpc/RPCRequests.h"
 #include "shared/rpc/RPCClient.h"
 #include "shared/rpc/yaml_codecs.h"
@@ -254,6 +257,8 @@ public:
     // ratio
     lookup_table.insert(make_pair("client_req_time", LookupItem("Resp (ms)", "total_time", "client_req", 3)));
     lookup_table.insert(make_pair("client_dyn_ka", LookupItem("Dynamic KA", "ka_total", "ka_count", 3)));
+
+    _metrics_file.open(Layout::get()->runtimedir + "/" + ts::MetricsFile::FILENAME);
   }
 
   bool
@@ -269,21 +274,55 @@ public:
     gettimeofday(&_time, nullptr);
     double now = _time.tv_sec + (double)_time.tv_usec / 1000000;
 
+    // Read the metrics from the file the server exports, if there is one, and only ask the RPC node
+    // for the records that are not in it.
+    bool from_file = _metrics_file.refresh();
+
+    if (from_file) {
+      // The rates are of the changes between two updates of the file.
+      now = _metrics_file.updated() / 1000.0;
+      if (_metrics_file.pid() != _not_in_file_pid) {
+        _not_in_file.clear();
+        _not_in_file_pid = _metrics_file.pid();
+      }
+    }
+
     // We will lookup for all the metrics on one single request.
     shared::rpc::RecordLookupRequest request;
+    std::vector<string>              requested;
 
     for (map<string, LookupItem>::const_iterator lookup_it = lookup_table.begin(); lookup_it != lookup_table.end(); ++lookup_it) {
       const LookupItem &item = lookup_it->second;
 
       if (item.type == 1 || item.type == 2 || item.type == 5 || item.type == 8) {
+        if (from_file) {
+          if (int64_t index = _metrics_file.find(item.name); index >= 0) {
+            (*_stats)[item.name] = std::to_string(_metrics_file.value(index));
+            continue;
+          }
+          if (auto it = _not_in_file.find(item.name); it != _not_in_file.end()) {
+            (*_stats)[item.name] = it->second;
+            continue;
+          }
+        }
         // Add records names to the rpc request.
         request.emplace_rec(detail::MetricParam{item.name});
+        requested.emplace_back(item.name);
       }
     }
     // query the rpc node.
-    if (auto const &error = fetch_and_fill_stats(request, _stats); !error.empty()) {
-      fprintf(stderr, "Error getting stats from the RPC node:\n%s", error.c_str());
-      return false;
+    if (!requested.empty()) {
+      if (auto const &error = fetch_and_fill_stats(request, _stats); !error.empty()) {
+        fprintf(stderr, "Error getting stats from the RPC node:\n%s", error.c_str());
+        return false;
+      }
+      // The records that are not in the file are not metrics, but strings such as the version, which
+      // do not change while the server runs, so they are asked for once.
+      if (from_file) {
+        for (auto const &name : requested) {
+          _not_in_file[name] = (*_stats)[name];
+        }
+      }
     }
     _old_time  = _now;
     _now       = now;
@@ -529,4 +568,7 @@ private:
   double                  _time_diff;
   struct timeval          _time;
   bool                    _absolute;
+  ts::MetricsFile::Reader _metrics_file;
+  map<string, string>     _not_in_file;
+  int64_t                 _not_in_file_pid = 0;
 };
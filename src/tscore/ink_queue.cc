@@ -98,6 +98,9 @@ static const ink_freelist_ops *default_ops  = &freelist_ops;
 static ink_freelist_list      *freelists           = nullptr;
 static const ink_freelist_ops *freelist_global_ops = default_ops;
 
+// Depot of the calling thread in every freelist, see ink_freelist_set_numa_node().
+static thread_local int freelist_depot = 0;
+
 inline void
 dummy_forced_read(void *mem)
 {
@@ -126,6 +129,12 @@ ink_freelist_init_ops(int nofl_class, int nofl_proxy)
   freelist_global_ops = (nofl_class || nofl_proxy) ? ink_freelist_malloc_ops() : ink_freelist_freelist_ops();
 }
 
+void
+ink_freelist_set_numa_node(int node)
+{
+  freelist_depot = node < 0 ? 0 : node % INK_FREELIST_NUMA_DEPOTS;
+}
+
 void
 ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32_t chunk_size, uint32_t alignment,
                   bool use_hugepages)
@@ -170,7 +179,9 @@ ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32
     f->chunk_size = INK_ALIGN(chunk_size * f->type_size, ats_pagesize()) / f->type_size;
   }
   Debug(DEBUG_TAG "_init", "<%s> Chunk Size request/actual (%" PRIu32 "/%" PRIu32 ")", name, chunk_size, f->chunk_size);
-  SET_FREELIST_POINTER_VERSION(f->head, FROM_PTR(0), 0);
+  for (auto &depot : f->depot) {
+    SET_FREELIST_POINTER_VERSION(depot.head, FROM_PTR(0), 0);
+  }
 
   *fl = f;
 }
@@ -209,12 +220,13 @@ ink_freelist_new(InkFreeList *f)
 static void *
 freelist_new(InkFreeList *f)
 {
-  head_p item;
-  head_p next;
-  int    result = 0;
+  head_p &head = f->depot[freelist_depot].head;
+  head_p  item;
+  head_p  next;
+  int     result = 0;
 
   do {
-    INK_QUEUE_LD(item, f->head);
+    INK_QUEUE_LD(item, head);
     if (TO_PTR(FREELIST_POINTER(item)) == nullptr) {
       uint32_t i;
       void    *newp       = nullptr;
@@ -255,7 +267,7 @@ freelist_new(InkFreeList *f)
 
     } else {
       SET_FREELIST_POINTER_VERSION(next, *ADDRESS_OF_NEXT(TO_PTR(FREELIST_POINTER(item)), 0), FREELIST_VERSION(item) + 1);
-      result = ink_atomic_cas(&f->head.data, item.data, next.data);
+      result = ink_atomic_cas(&head.data, item.data, next.data);
 
 #ifdef SANITY
       if (result) {
@@ -304,10 +316,11 @@ ink_freelist_free(InkFreeList *f, void *item)
 static void
 freelist_free(InkFreeList *f, void *item)
 {
-  void **adr_of_next = ADDRESS_OF_NEXT(item, 0);
-  head_p h;
-  head_p item_pair;
-  int    result = 0;
+  head_p &head        = f->depot[freelist_depot].head;
+  void  **adr_of_next = ADDRESS_OF_NEXT(item, 0);
+  head_p  h;
+  head_p  item_pair;
+  int     result = 0;
 
   // ink_assert(!((long)item&(f->alignment-1))); XXX - why is this no longer working? -bcall
 
@@ -323,7 +336,7 @@ freelist_free(InkFreeList *f, void *item)
 #endif /* DEADBEEF */
 
   while (!result) {
-    INK_QUEUE_LD(h, f->head);
+    INK_QUEUE_LD(h, head);
 #ifdef SANITY
     if (TO_PTR(FREELIST_POINTER(h)) == item) {
       ink_abort("ink_freelist_free: trying to free item twice");
@@ -338,7 +351,7 @@ freelist_free(InkFreeList *f, void *item)
     *adr_of_next = FREELIST_POINTER(h);
     SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(item), FREELIST_VERSION(h));
     INK_MEMORY_BARRIER;
-    result = ink_atomic_cas(&f->head.data, h.data, item_pair.data);
+    result = ink_atomic_cas(&head.data, h.data, item_pair.data);
   }
 }
 
@@ -364,10 +377,11 @@ ink_freelist_free_bulk(InkFreeList *f, void *head, void *tail, size_t num_item)
 static void
 freelist_bulkfree(InkFreeList *f, void *head, void *tail, [[maybe_unused]] size_t num_item)
 {
-  void **adr_of_next = ADDRESS_OF_NEXT(tail, 0);
-  head_p h;
-  head_p item_pair;
-  int    result = 0;
+  head_p &depot_head  = f->depot[freelist_depot].head;
+  void  **adr_of_next = ADDRESS_OF_NEXT(tail, 0);
+  head_p  h;
+  head_p  item_pair;
+  int     result = 0;
 
   // ink_assert(!((long)item&(f->alignment-1))); XXX - why is this no longer working? -bcall
 
@@ -388,7 +402,7 @@ freelist_bulkfree(InkFreeList *f, void *head, void *tail, [[maybe_unused]] size_
 #endif /* DEADBEEF */
 
   while (!result) {
-    INK_QUEUE_LD(h, f->head);
+    INK_QUEUE_LD(h, depot_head);
 #ifdef SANITY
     if (TO_PTR(FREELIST_POINTER(h)) == head) {
       ink_abort("ink_freelist_free: trying to free item twice");
@@ -403,7 +417,7 @@ freelist_bulkfree(InkFreeList *f, void *head, void *tail, [[maybe_unused]] size_
     *adr_of_next = FREELIST_POINTER(h);
     SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(head), FREELIST_VERSION(h));
     INK_MEMORY_BARRIER;
-    result = ink_atomic_cas(&f->head.data, h.data, item_pair.data);
+    result = ink_atomic_cas(&depot_head.data, h.data, item_pair.data);
   }
 }
 
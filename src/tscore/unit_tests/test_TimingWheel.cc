@@ -0,0 +1,112 @@
+/** @file
+
+  Unit tests for TimingWheel.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "tscore/TimingWheel.h"
+
+#include <vector>
+
+namespace
+{
+struct Timer {
+  uint64_t at    = 0;
+  uint64_t fired = 0;
+
+  TIMING_WHEEL_LINK(Timer, wheel_link);
+};
+
+using Wheel = TimingWheelOf(Timer, wheel_link);
+} // namespace
+
+TEST_CASE("TimingWheel fires each item at its tick", "[libts][TimingWheel]")
+{
+  Wheel wheel(1000);
+
+  // Cover every level, including items past the span of the wheel.
+  std::vector<uint64_t> const offsets = {1, 2, 63, 64, 65, 100, 4095, 4096, 4097, 70000, 262143, 262144, 262145, 1000000};
+  std::vector<Timer>          timers(offsets.size());
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    timers[i].at = 1000 + offsets[i];
+    wheel.schedule(&timers[i], timers[i].at);
+    REQUIRE(wheel.in(&timers[i]));
+  }
+  REQUIRE(wheel.size() == offsets.size());
+
+  // Advance in uneven steps to exercise cascading across step boundaries.
+  uint64_t now = 1000;
+  while (wheel.size() > 0) {
+    now += 7;
+    wheel.advance(now, [&](Timer *t) {
+      t->fired = wheel.now();
+      // Items beyond the span come back early and are filed again.
+      if (t->fired < t->at) {
+        wheel.schedule(t, t->at);
+      }
+    });
+  }
+
+  for (auto const &t : timers) {
+    CHECK(t.fired == t.at);
+    CHECK(!wheel.in(const_cast<Timer *>(&t)));
+  }
+}
+
+TEST_CASE("TimingWheel remove and reschedule", "[libts][TimingWheel]")
+{
+  Wheel wheel(0);
+  Timer a, b, c;
+
+  wheel.schedule(&a, 10);
+  wheel.schedule(&b, 10);
+  wheel.schedule(&c, 5000);
+  REQUIRE(wheel.size() == 3);
+
+  wheel.remove(&b);
+  CHECK(!wheel.in(&b));
+  CHECK(wheel.size() == 2);
+
+  // Move an item earlier.
+  wheel.schedule(&c, 20);
+  CHECK(wheel.size() == 2);
+
+  std::vector<Timer *> fired;
+  CHECK(wheel.advance(15, [&](Timer *t) { fired.push_back(t); }) == 1);
+  REQUIRE(fired.size() == 1);
+  CHECK(fired[0] == &a);
+
+  // Items due in the past are handed out by the next advance.
+  wheel.schedule(&a, 3);
+  fired.clear();
+  CHECK(wheel.advance(16, [&](Timer *t) { fired.push_back(t); }) == 1);
+  CHECK(fired[0] == &a);
+
+  fired.clear();
+  CHECK(wheel.advance(100, [&](Timer *t) { fired.push_back(t); }) == 1);
+  CHECK(fired[0] == &c);
+  CHECK(wheel.size() == 0);
+
+  // An empty wheel jumps straight to the new tick.
+  CHECK(wheel.advance(uint64_t{1} << 40, [&](Timer *) {}) == 0);
+  CHECK(wheel.now() == uint64_t{1} << 40);
+}
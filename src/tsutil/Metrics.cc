@@ -69,6 +69,7 @@ Metrics::Storage::create(std::string_view name)
 
   names[_cur_off] = std::make_tuple(std::string(name), id);
   _lookups.emplace(std::get<0>(names[_cur_off]), id);
+  ++_generation;
 
   if (++_cur_off >= MAX_SIZE) {
     addBlob(); // This resets _cur_off to 0 as well
@@ -163,6 +164,7 @@ Metrics::Storage::createSpan(size_t size, Metrics::IdType *id)
   }
 
   _cur_off += size;
+  ++_generation;
 
   return span;
 }
@@ -186,6 +188,7 @@ Metrics::Storage::rename(Metrics::IdType id, std::string_view name)
   }
   cur = name;
   _lookups.emplace(cur, id);
+  ++_generation;
 
   return true;
 }
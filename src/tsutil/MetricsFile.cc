@@ -0,0 +1,308 @@
+/** @file
+
+  The metrics file, a read-only memory mapped copy of the Metrics, for local agents.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tsutil/MetricsFile.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ts
+{
+namespace
+{
+  // The number of times a Reader tries for a copy that is not torn, before it gives up.
+  constexpr int READ_ATTEMPTS = 100;
+
+  constexpr uint64_t
+  align(uint64_t n, uint64_t alignment)
+  {
+    return (n + alignment - 1) / alignment * alignment;
+  }
+
+  template <typename T>
+  T *
+  at(const MetricsFile::Header *header, uint64_t offset)
+  {
+    return reinterpret_cast<T *>(reinterpret_cast<uintptr_t>(header) + offset);
+  }
+
+  void
+  copy_values(MetricsFile::Header *header, const Metrics &metrics)
+  {
+    auto *values = at<MetricsFile::ValueType>(header, header->values_offset);
+    auto  it     = metrics.begin();
+    auto  now    = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+
+    header->sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // The file has the metrics there were when it was created, and none of those go away.
+    for (uint64_t i = 0; i < header->count; ++i, ++it) {
+      values[i].store(std::get<1>(*it), std::memory_order_relaxed);
+    }
+    header->updated.store(now.count(), std::memory_order_relaxed);
+
+    header->sequence.fetch_add(1, std::memory_order_release);
+  }
+} // namespace
+
+//-------------------------------------------------------------------------
+// MetricsFile::Writer
+//-------------------------------------------------------------------------
+MetricsFile::Writer::~Writer()
+{
+  if (_header) {
+    _header->retired.store(1, std::memory_order_release);
+    munmap(_header, _header->size);
+    unlink(_path.c_str());
+  }
+}
+
+bool
+MetricsFile::Writer::update(const Metrics &metrics)
+{
+  uint64_t generation = metrics.generation();
+
+  if (!_header || generation != _generation) {
+    return create(metrics, generation);
+  }
+  copy_values(_header, metrics);
+
+  return true;
+}
+
+bool
+MetricsFile::Writer::create(const Metrics &metrics, uint64_t generation)
+{
+  std::vector<std::string_view> names;
+  uint64_t                      names_size = 0;
+  auto                          end        = metrics.end();
+
+  for (auto it = metrics.begin(); it != end; ++it) {
+    names.push_back(std::get<0>(*it));
+    names_size += names.back().size();
+  }
+
+  uint64_t names_offset  = align(sizeof(Header), alignof(NameEntry));
+  uint64_t values_offset = align(names_offset + names.size() * sizeof(NameEntry) + names_size, 64);
+  uint64_t size          = values_offset + names.size() * sizeof(ValueType);
+
+  // The new file is complete before it replaces the old one, so a Reader never maps one partly written.
+  std::string tmp = _path + ".tmp";
+  int         fd  = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  void *map = MAP_FAILED;
+
+  if (ftruncate(fd, size) == 0) {
+    map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  if (map == MAP_FAILED) {
+    int error = errno;
+
+    ::close(fd);
+    unlink(tmp.c_str());
+    errno = error;
+    return false;
+  }
+  ::close(fd);
+
+  // The file is zero filled, so the sequence count, and the values, start at 0.
+  auto *header = static_cast<Header *>(map);
+
+  memcpy(header->magic, MAGIC, sizeof(MAGIC));
+  header->version       = VERSION;
+  header->block_size    = Metrics::MAX_SIZE;
+  header->pid           = getpid();
+  header->count         = names.size();
+  header->names_offset  = names_offset;
+  header->values_offset = values_offset;
+  header->size          = size;
+
+  auto    *entries = at<NameEntry>(header, names_offset);
+  uint64_t offset  = names_offset + names.size() * sizeof(NameEntry);
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    entries[i].offset = offset;
+    entries[i].length = names[i].size();
+    memcpy(at<char>(header, offset), names[i].data(), names[i].size());
+    offset += names[i].size();
+  }
+  copy_values(header, metrics);
+
+  if (rename(tmp.c_str(), _path.c_str()) != 0) {
+    int error = errno;
+
+    munmap(map, size);
+    unlink(tmp.c_str());
+    errno = error;
+    return false;
+  }
+
+  if (_header) {
+    _header->retired.store(1, std::memory_order_release);
+    munmap(_header, _header->size);
+  }
+  _header     = header;
+  _generation = generation;
+
+  return true;
+}
+
+//-------------------------------------------------------------------------
+// MetricsFile::Reader
+//-------------------------------------------------------------------------
+MetricsFile::Reader::~Reader()
+{
+  close();
+}
+
+bool
+MetricsFile::Reader::open(std::string_view path)
+{
+  std::string file{path};
+
+  close();
+  _path = file;
+
+  int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  void       *map = MAP_FAILED;
+
+  if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header)) {
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  } else {
+    errno = EINVAL;
+  }
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  auto     header = static_cast<const Header *>(map);
+  uint64_t size   = st.st_size;
+
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION || header->size != size ||
+      header->names_offset + header->count * sizeof(NameEntry) > size ||
+      header->values_offset + header->count * sizeof(ValueType) > size) {
+    munmap(map, size);
+    errno = EINVAL;
+    return false;
+  }
+
+  auto entries = at<const NameEntry>(header, header->names_offset);
+
+  for (uint64_t i = 0; i < header->count; ++i) {
+    if (static_cast<uint64_t>(entries[i].offset) + entries[i].length > size) {
+      _names.clear();
+      _index.clear();
+      munmap(map, size);
+      errno = EINVAL;
+      return false;
+    }
+    _names.emplace_back(at<const char>(header, entries[i].offset), entries[i].length);
+    if (!_names.back().empty()) {
+      _index.emplace(_names.back(), i);
+    }
+  }
+  _values.assign(header->count, 0);
+  _header = header;
+
+  return true;
+}
+
+void
+MetricsFile::Reader::close()
+{
+  if (_header) {
+    munmap(const_cast<Header *>(_header), _header->size);
+    _header = nullptr;
+  }
+  _names.clear();
+  _index.clear();
+  _values.clear();
+  _updated = 0;
+}
+
+bool
+MetricsFile::Reader::refresh()
+{
+  if ((!_header || _header->retired.load(std::memory_order_acquire)) && !open(_path)) {
+    return false;
+  }
+  if (kill(_header->pid, 0) != 0 && errno == ESRCH) {
+    return false;
+  }
+
+  auto values = at<const ValueType>(_header, _header->values_offset);
+
+  for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+    uint64_t sequence = _header->sequence.load(std::memory_order_acquire);
+
+    if (sequence & 1) {
+      sched_yield();
+      continue;
+    }
+    for (size_t i = 0; i < _values.size(); ++i) {
+      _values[i] = values[i].load(std::memory_order_relaxed);
+    }
+
+    int64_t updated = _header->updated.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_header->sequence.load(std::memory_order_relaxed) == sequence) {
+      _updated = updated;
+      return true;
+    }
+  }
+  errno = EAGAIN;
+
+  return false;
+}
+
+int64_t
+MetricsFile::Reader::find(std::string_view name) const
+{
+  if (auto it = _index.find(name); it != _index.end()) {
+    return it->second;
+  }
+  return -1;
+}
+
+} // namespace ts
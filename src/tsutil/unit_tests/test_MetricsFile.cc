@@ -0,0 +1,88 @@
+/** @file
+
+    MetricsFile unit tests.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "catch.hpp"
+
+#include "tsutil/MetricsFile.h"
+
+#include <string>
+#include <unistd.h>
+
+using ts::Metrics;
+using ts::MetricsFile;
+
+TEST_CASE("MetricsFile", "[libtsutil][MetricsFile]")
+{
+  auto               &m    = Metrics::instance();
+  std::string         path = "/tmp/metrics_file_test." + std::to_string(getpid());
+  MetricsFile::Writer writer(path);
+  MetricsFile::Reader reader;
+  Metrics::IdType     one = Metrics::Counter::create("test.metrics_file.one");
+
+  m[one].store(3);
+  REQUIRE(writer.update());
+  REQUIRE(reader.open(path));
+  REQUIRE(reader.refresh());
+  CHECK(reader.pid() == getpid());
+  CHECK(reader.updated() > 0);
+
+  int64_t index = reader.find("test.metrics_file.one");
+  REQUIRE(index >= 0);
+  CHECK(reader.name(index) == "test.metrics_file.one");
+  CHECK(reader.value(index) == 3);
+  CHECK(reader.find("test.metrics_file.missing") == -1);
+
+  SECTION("Values are as of the last update")
+  {
+    m[one].store(5);
+    REQUIRE(reader.refresh());
+    CHECK(reader.value(index) == 3);
+
+    REQUIRE(writer.update());
+    REQUIRE(reader.refresh());
+    CHECK(reader.value(index) == 5);
+  }
+
+  SECTION("A new metric replaces the file")
+  {
+    size_t          size = reader.size();
+    Metrics::IdType two  = Metrics::Counter::create("test.metrics_file.two");
+
+    m[two].store(7);
+    REQUIRE(writer.update());
+    REQUIRE(reader.refresh());
+    CHECK(reader.size() > size);
+    REQUIRE(reader.find("test.metrics_file.two") >= 0);
+    CHECK(reader.value(reader.find("test.metrics_file.two")) == 7);
+    CHECK(reader.value(reader.find("test.metrics_file.one")) == 3);
+  }
+
+  SECTION("Only a metrics file is read")
+  {
+    MetricsFile::Reader other;
+
+    CHECK_FALSE(other.open("/dev/null"));
+    CHECK_FALSE(other.open(path + ".missing"));
+    CHECK_FALSE(other.refresh());
+  }
+}
@@ -0,0 +1,146 @@
+/** @file
+
+  Micro Benchmark tool for the cache purge index - requires Catch2 v2.9.0+
+
+  Measures indexing objects as their writes close, and the index side of a purge of every object
+  with a surrogate key or under a URL prefix. The directory deletes of a purge are not included,
+  proxy.process.cache.purge.time has the whole of a purge.
+
+  Each sample of a purge builds a new index, so keep the number of samples down.
+
+  - e.g. a purge of a surrogate key on 1 million objects
+  ```
+  $ ./benchmark_CachePurgeIndex --ts-objects 1000000 --benchmark-samples 10
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "../../src/iocore/cache/CachePurgeIndex.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+struct Conf {
+  int objects = 1000000;
+  int hosts   = 100;
+};
+
+Conf conf;
+
+struct Object {
+  CryptoHash  key;
+  std::string url;
+};
+
+std::vector<Object>
+make_objects()
+{
+  std::vector<Object> objects(conf.objects);
+  std::mt19937_64     rng{13};
+
+  for (int i = 0; i < conf.objects; ++i) {
+    objects[i].key.u64[0] = rng();
+    objects[i].key.u64[1] = rng();
+    objects[i].url        = "www.example" + std::to_string(i % conf.hosts) + ".com/assets/" + std::to_string(i) + ".js";
+  }
+  return objects;
+}
+
+// Every object has the surrogate key "all", and one of "a" or "b".
+std::unique_ptr<CachePurgeIndex>
+make_index(std::vector<Object> const &objects)
+{
+  auto index = std::make_unique<CachePurgeIndex>(conf.objects);
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    index->insert(objects[i].key, objects[i].url, i % 2 ? "all a" : "all b");
+  }
+  return index;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the cache purge index", "")
+{
+  auto const objects = make_objects();
+
+  BENCHMARK_ADVANCED("insert")(Catch::Benchmark::Chronometer meter)
+  {
+    CachePurgeIndex index{conf.objects};
+    size_t          i = 0;
+
+    meter.measure([&] {
+      Object const &object = objects[i++ % objects.size()];
+      index.insert(object.key, object.url, "all a");
+    });
+  };
+
+  BENCHMARK_ADVANCED("purge surrogate key on every object")(Catch::Benchmark::Chronometer meter)
+  {
+    auto                               index = make_index(objects);
+    std::vector<CachePurgeIndex::Item> items;
+
+    meter.measure([&] { return index->remove_tag("all", items); });
+  };
+
+  BENCHMARK_ADVANCED("purge url prefix of one host")(Catch::Benchmark::Chronometer meter)
+  {
+    auto                               index = make_index(objects);
+    std::vector<CachePurgeIndex::Item> items;
+    std::vector<std::string>           prefixes;
+
+    for (int i = 0; i < conf.hosts; ++i) {
+      prefixes.push_back("www.example" + std::to_string(i) + ".com/");
+    }
+    // Each run purges another host.
+    meter.measure([&](int i) { return index->remove_prefix(prefixes[i % conf.hosts], items); });
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.objects, "")["--ts-objects"]("number of objects indexed (default: 1000000)") |
+    Opt(conf.hosts, "")["--ts-hosts"]("number of hosts the objects are spread over (default: 100)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,183 @@
+/** @file
+
+  Micro Benchmark tool for the JSONRPC record lookups - requires Catch2 v2.9.0+
+
+  Measures fetching records with their metadata through admin_lookup_records, the way the handler streams them, against building
+  the whole response node first and encoding it, as it used to be done.
+
+  - e.g. example of fetching 20000 metrics, matched by 10 patterns
+  ```
+  $ ./benchmark_JsonRPCRecords --ts-nrecords 20000 --ts-npatterns 10
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/Layout.h"
+#include "tsutil/Metrics.h"
+#include "records/RecordsConfig.h"
+#include "records/RecProcess.h"
+
+#include "mgmt/rpc/jsonrpc/JsonRPC.h"
+#include "mgmt/rpc/jsonrpc/json/YAMLCodec.h"
+#include "mgmt/rpc/handlers/records/Records.h"
+#include "../../src/mgmt/rpc/handlers/common/RecordsUtils.h"
+
+#include "iocore/utils/diags.i"
+
+#include <string>
+
+namespace
+{
+// Args
+struct Conf {
+  int nrecords  = 20000;
+  int npatterns = 10;
+};
+
+Conf conf;
+
+// Only counts what it is given, as the response would be written to the socket.
+struct CountingWriter : rpc::ResponseWriter {
+  using rpc::ResponseWriter::write;
+  void
+  write(std::string_view data) override
+  {
+    size += data.size();
+  }
+  size_t size = 0;
+};
+
+std::string
+pattern(int n)
+{
+  return "bench.metric.g" + std::to_string(n) + ".";
+}
+
+// The request, with the patterns by regex or by prefix.
+std::string
+request(int npatterns, bool prefix)
+{
+  std::string params;
+
+  for (int i = 0; i < npatterns; ++i) {
+    std::string p = pattern(i);
+    params += i > 0 ? ", " : "";
+    if (prefix) {
+      params += R"({"record_name_prefix": ")" + p + R"("})";
+    } else {
+      params += R"({"record_name_regex": "^)" + p + R"("})";
+    }
+  }
+  return R"({"jsonrpc": "2.0", "method": "admin_lookup_records", "params": [)" + params + R"(], "id": "bench"})";
+}
+
+// The records, fetched as they were before the lookups were streamed, one pass per regex and into a node.
+size_t
+lookup_node(int npatterns)
+{
+  namespace utils = rpc::handlers::records::utils;
+
+  YAML::Node recordList{YAML::NodeType::Sequence}, errorList{YAML::NodeType::Sequence};
+
+  for (int i = 0; i < npatterns; ++i) {
+    auto &&[records, ec] = utils::get_yaml_record_regex("^" + pattern(i), RECT_ALL);
+    for (auto &&n : records) {
+      recordList.push_back(n);
+    }
+  }
+
+  rpc::specs::RPCResponseInfo resp{"bench"};
+  resp.callResult.result["recordList"] = recordList;
+  resp.callResult.result["errorList"]  = errorList;
+
+  return rpc::json_codecs::yamlcpp_json_encoder::encode(resp).size();
+}
+
+size_t
+lookup_streaming(std::string const &json)
+{
+  CountingWriter out;
+  rpc::JsonRPCManager::instance().handle_call(rpc::Context{}, json, out);
+  return out.size;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of fetching records through JSONRPC", "")
+{
+  std::string by_regex  = request(conf.npatterns, false);
+  std::string by_prefix = request(conf.npatterns, true);
+
+  // All ways get the same records.
+  REQUIRE(lookup_streaming(by_regex) == lookup_streaming(by_prefix));
+  REQUIRE(lookup_node(conf.npatterns) == lookup_streaming(by_regex));
+
+  BENCHMARK("node, a pass per regex")
+  {
+    return lookup_node(conf.npatterns);
+  };
+
+  BENCHMARK("streaming, regexes")
+  {
+    return lookup_streaming(by_regex);
+  };
+
+  BENCHMARK("streaming, prefixes")
+  {
+    return lookup_streaming(by_prefix);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.nrecords, "")["--ts-nrecords"]("number of records (default: 20000)") |
+    Opt(conf.npatterns, "")["--ts-npatterns"]("number of patterns the records are fetched by (default: 10)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  LibRecordsConfigInit();
+
+  for (int i = 0; i < conf.nrecords; ++i) {
+    ts::Metrics::Counter::create(pattern(i % conf.npatterns) + std::to_string(i));
+  }
+  rpc::add_streaming_method_handler("admin_lookup_records", &rpc::handlers::records::lookup_records,
+                                    &rpc::core_ats_rpc_service_provider_handle, {{rpc::NON_RESTRICTED_API}});
+
+  return session.run();
+}
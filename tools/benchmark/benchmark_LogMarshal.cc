@@ -0,0 +1,231 @@
+/** @file
+
+  Micro Benchmark tool for marshalling a transaction for several log formats - requires Catch2 v2.9.0+
+
+  Measures marshalling the fields of one transaction for each of a set of log formats that have
+  most of their fields in common, as LogObjectManager::log does for its log objects, with and
+  without the marshal cache of LogAccess. Writing to the log buffers is not included.
+
+  - e.g. with the first 3 formats only
+  ```
+  $ ./benchmark_LogMarshal --ts-formats 3
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/Layout.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "records/RecordsConfig.h"
+#include "proxy/http/HttpSM.h"
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogFormat.h"
+
+#include "iocore/utils/diags.i"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// Args
+struct Conf {
+  int formats = 6;
+};
+
+Conf conf;
+
+// Formats like those of a deployment with several logs, most of the fields shared.
+constexpr const char *FORMATS[] = {
+  "%<cqts> %<ttms> %<chi> %<crc>/%<pssc> %<pscl> %<cqhm> %<cquc>",
+  "%<chi> - - [%<cqts>] \"%<cqhm> %<cqu> %<cqpv>\" %<pssc> %<pscl> \"%<{User-Agent}cqh>\"",
+  "%<cqts> %<chi> %<cqhm> %<cqup> %<{Host}cqh> %<pssc> %<sssc> %<ttms>",
+  "%<cqts> %<cquc> %<pssc> %<pscl> %<pshl> %<{Content-Type}psh>",
+  "%<chi> %<cqhm> %<cquc> %<{User-Agent}cqh> %<crc> %<ttms>",
+  "%<cqts> %<chi> %<cqu> %<pssc> %<sssc> %<pscl> %<ttms> %<{Host}cqh>",
+};
+
+constexpr std::string_view REQUEST = "GET http://www.example.com/assets/images/logo.png?v=1234567890 HTTP/1.1\r\n"
+                                     "Host: www.example.com\r\n"
+                                     "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:120.0) Gecko/20100101 Firefox/120.0\r\n"
+                                     "Accept: image/avif,image/webp,*/*\r\n"
+                                     "\r\n";
+
+constexpr std::string_view RESPONSE = "HTTP/1.1 200 OK\r\n"
+                                      "Content-Type: image/png\r\n"
+                                      "Content-Length: 5120\r\n"
+                                      "Cache-Control: max-age=86400\r\n"
+                                      "\r\n";
+
+void
+parse_request(HTTPHdr &req, std::string_view text)
+{
+  HTTPParser  parser;
+  const char *start = text.data();
+
+  req.create(HTTP_TYPE_REQUEST);
+  http_parser_init(&parser);
+  req.parse_req(&parser, &start, text.data() + text.size(), true);
+  http_parser_clear(&parser);
+}
+
+void
+parse_response(HTTPHdr &resp, std::string_view text)
+{
+  HTTPParser  parser;
+  const char *start = text.data();
+
+  resp.create(HTTP_TYPE_RESPONSE);
+  http_parser_init(&parser);
+  resp.parse_resp(&parser, &start, text.data() + text.size(), true);
+  http_parser_clear(&parser);
+}
+
+/// A transaction that is done, as it is logged.
+HttpSM *
+make_transaction()
+{
+  HttpSM *sm = new HttpSM;
+
+  parse_request(sm->t_state.hdr_info.client_request, REQUEST);
+  parse_response(sm->t_state.hdr_info.client_response, RESPONSE);
+  parse_response(sm->t_state.hdr_info.server_response, RESPONSE);
+  ats_ip_pton("192.0.2.10:40000", &sm->t_state.client_info.src_addr);
+  sm->client_response_body_bytes         = 5120;
+  sm->client_response_hdr_bytes          = RESPONSE.size();
+  sm->milestones[TS_MILESTONE_UA_BEGIN]  = ink_get_hrtime();
+  sm->milestones[TS_MILESTONE_SM_START]  = sm->milestones[TS_MILESTONE_UA_BEGIN];
+  sm->milestones[TS_MILESTONE_SM_FINISH] = sm->milestones[TS_MILESTONE_SM_START] + HRTIME_MSECONDS(12);
+  sm->t_state.squid_codes.log_code       = SQUID_LOG_TCP_HIT;
+  return sm;
+}
+
+std::vector<LogFormat *>
+make_formats()
+{
+  std::vector<LogFormat *> formats;
+
+  for (int i = 0; i < conf.formats; ++i) {
+    formats.push_back(new LogFormat(("format" + std::to_string(i)).c_str(), FORMATS[i % std::size(FORMATS)]));
+  }
+  return formats;
+}
+
+/// Marshal @a sm for each of @a formats into @a buf, @return the bytes marshalled.
+size_t
+marshal(HttpSM *sm, std::vector<LogFormat *> const &formats, std::vector<char> &buf, bool cache)
+{
+  LogAccess lad(sm);
+  size_t    bytes = 0;
+
+  lad.init();
+  if (cache) {
+    lad.marshal_cache_init(LogField::marshal_slots());
+  }
+  for (LogFormat *format : formats) {
+    unsigned len = format->m_field_list.marshal_len(&lad);
+    if (buf.size() < bytes + len) {
+      buf.resize(bytes + len);
+    }
+    bytes += format->m_field_list.marshal(&lad, buf.data() + bytes);
+  }
+  return bytes;
+}
+
+/// The text of the fields of @a formats marshalled in @a buf, as they are logged.
+std::string
+unmarshal(std::vector<LogFormat *> const &formats, std::vector<char> &buf)
+{
+  std::string text;
+  char       *ptr = buf.data();
+  char        field[4096];
+
+  for (LogFormat *format : formats) {
+    for (LogField *f = format->m_field_list.first(); f; f = format->m_field_list.next(f)) {
+      text.append(field, f->unmarshal(&ptr, field, sizeof(field)));
+      text += ' ';
+    }
+  }
+  return text;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of marshalling a transaction for several log formats", "")
+{
+  HttpSM                  *sm      = make_transaction();
+  std::vector<LogFormat *> formats = make_formats();
+  std::vector<char>        uncached;
+  std::vector<char>        cached;
+
+  // The formats log the same fields either way.
+  size_t bytes = marshal(sm, formats, uncached, false);
+  REQUIRE(marshal(sm, formats, cached, true) == bytes);
+  REQUIRE(unmarshal(formats, cached) == unmarshal(formats, uncached));
+
+  BENCHMARK("marshal each format")
+  {
+    return marshal(sm, formats, uncached, false);
+  };
+
+  BENCHMARK("marshal once for all formats")
+  {
+    return marshal(sm, formats, cached, true);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.formats, "")["--ts-formats"]("number of log formats (default: 6)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  LibRecordsConfigInit();
+  ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+  eventProcessor.start(1);
+  EThread *main_thread = new EThread;
+  main_thread->set_specific();
+  url_init();
+  mime_init();
+  http_init();
+  Log::init_fields();
+
+  return session.run();
+}
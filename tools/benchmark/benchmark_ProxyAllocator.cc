@@ -28,6 +28,10 @@ limitations under the License.
 #include "iocore/eventsystem/Thread.h"
 #include "tscore/Allocator.h"
 
+#include <barrier>
+#include <thread>
+#include <vector>
+
 namespace
 {
 class BThread : public Thread
@@ -109,3 +113,116 @@ TEST_CASE("ProxyAllocator", "[iocore]")
 
   delete bench_thread;
 }
+
+namespace
+{
+// Return everything cached by @a t to the global freelist so repeated runs don't leak.
+void
+drain(Thread *t)
+{
+  while (t->ioAllocator.freelist) {
+    void *item              = t->ioAllocator.freelist;
+    t->ioAllocator.freelist = *static_cast<void **>(item);
+    t->ioAllocator.allocated--;
+    ioAllocator.raw().free_void(item);
+  }
+}
+
+/** Run @a thread_count threads, each allocating a batch and then freeing the batch of its neighbor.
+
+    Thread @c i uses the freelist depot for NUMA node @c i % @a nodes. With more than one node every free is a
+    cross node free, which is the pattern of connections whose buffers are released on another socket.
+*/
+int
+run_threads(int thread_count, int nodes, int batch, int rounds)
+{
+  std::vector<std::vector<BItem *>> batches(thread_count);
+  std::barrier                      sync(thread_count);
+  std::vector<std::thread>          threads;
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&, i]() {
+      BThread t;
+      t.set_specific();
+      ink_freelist_set_numa_node(i % nodes);
+
+      for (int r = 0; r < rounds; ++r) {
+        batches[i].reserve(batch);
+        for (int n = 0; n < batch; ++n) {
+          batches[i].push_back(THREAD_ALLOC(ioAllocator, this_thread()));
+        }
+        sync.arrive_and_wait();
+        for (auto item : batches[(i + 1) % thread_count]) {
+          THREAD_FREE(item, ioAllocator, this_thread());
+        }
+        sync.arrive_and_wait();
+        batches[i].clear();
+      }
+      drain(&t);
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  return thread_count;
+}
+} // namespace
+
+TEST_CASE("ProxyAllocator adaptive", "[iocore]")
+{
+  Thread *bench_thread = new BThread();
+  bench_thread->set_specific();
+  int burst = 2048;
+
+  thread_freelist_high_watermark = 512;
+  thread_freelist_low_watermark  = 32;
+
+  // Bursts larger than the thread cache: a fixed cache drains to the low watermark and refills from the
+  // global freelist every time, an adaptive one grows until the burst fits.
+  for (int adaptive : {0, 1}) {
+    thread_freelist_adaptive        = adaptive;
+    bench_thread->ioAllocator.limit = 0;
+
+    BENCHMARK(adaptive ? "burst adaptive" : "burst fixed")
+    {
+      auto items = std::vector<BItem *>();
+      items.reserve(burst);
+      for (int i = 0; i < burst; i++) {
+        items.push_back(THREAD_ALLOC(ioAllocator, this_thread()));
+      }
+      for (auto item : items) {
+        THREAD_FREE(item, ioAllocator, this_thread());
+      }
+      return bench_thread->ioAllocator.allocated;
+    };
+  }
+  thread_freelist_adaptive = 0;
+
+  drain(bench_thread);
+  delete bench_thread;
+}
+
+TEST_CASE("ProxyAllocator NUMA depots", "[iocore]")
+{
+  int threads = 4;
+  int batch   = 1024;
+  int rounds  = 16;
+
+  thread_freelist_high_watermark = 512;
+  thread_freelist_low_watermark  = 32;
+
+  BENCHMARK("single depot, cross thread frees")
+  {
+    return run_threads(threads, 1, batch, rounds);
+  };
+
+  BENCHMARK("two depots, cross node frees")
+  {
+    return run_threads(threads, 2, batch, rounds);
+  };
+
+  BENCHMARK("one depot per thread, cross node frees")
+  {
+    return run_threads(threads, threads, batch, rounds);
+  };
+}
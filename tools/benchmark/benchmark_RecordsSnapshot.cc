@@ -0,0 +1,135 @@
+/** @file
+
+  Micro Benchmark tool for reading config records - requires Catch2 v2.9.0+
+
+  Measures reading a config record from many threads at once, as plugins do per transaction, from
+  the records table under its locks and from the config records snapshot.
+
+  - e.g. example of running 64 threads, each reading 10000 times
+  ```
+  $ taskset -c 0-63 ./benchmark_RecordsSnapshot --ts-nthreads 64 --ts-nloop 10000
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/Layout.h"
+#include "records/RecordsConfig.h"
+#include "records/RecProcess.h"
+#include "../../src/records/P_RecConfigSnapshot.h"
+
+#include "iocore/utils/diags.i"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Args
+struct Conf {
+  int nloop    = 1000;
+  int nthreads = 64;
+};
+
+Conf conf;
+
+constexpr const char *RECORD = "proxy.config.http.keep_alive_no_activity_timeout_in";
+
+RecInt
+run()
+{
+  std::vector<std::thread> threads;
+  std::atomic<RecInt>      sum{0};
+
+  for (int i = 0; i < conf.nthreads; i++) {
+    threads.emplace_back([&sum]() {
+      RecInt value = 0;
+      RecInt total = 0;
+      for (int j = 0; j < conf.nloop; ++j) {
+        RecGetRecordInt(RECORD, &value);
+        total += value;
+      }
+      sum += total;
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  return sum;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of reading a config record", "")
+{
+  SECTION("records table")
+  {
+    RecConfigSnapshot::invalidate();
+    REQUIRE(RecConfigSnapshot::current() == nullptr);
+
+    BENCHMARK("RecGetRecordInt")
+    {
+      return run();
+    };
+  }
+
+  SECTION("snapshot")
+  {
+    RecConfigSnapshot::publish();
+    REQUIRE(RecConfigSnapshot::current() != nullptr);
+
+    BENCHMARK("RecGetRecordInt")
+    {
+      return run();
+    };
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.nthreads, "")["--ts-nthreads"]("number of threads (default: 64)") |
+    Opt(conf.nloop, "")["--ts-nloop"]("number of reads per thread (default: 1000)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  LibRecordsConfigInit();
+
+  return session.run();
+}
@@ -0,0 +1,145 @@
+/** @file
+
+  Micro Benchmark tool for the cost of a timeout check pass - requires Catch2 v2.9.0+
+
+  Compares walking every connection, as the InactivityCop does, with advancing a TimingWheel by one
+  tick. Each connection has a timeout spread over @c --ts-timeout ticks and is given a new one when
+  it expires.
+
+  - e.g. 1 million connections with a 300 tick timeout
+  ```
+  $ ./benchmark_TimingWheel --ts-nconn 1000000 --ts-timeout 300
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/List.h"
+#include "tscore/TimingWheel.h"
+
+#include <memory>
+#include <random>
+
+namespace
+{
+// Args
+struct Conf {
+  int nconn   = 100000;
+  int timeout = 300;
+};
+
+Conf conf;
+
+struct Conn {
+  uint64_t timeout_at = 0;
+  // Stand in for the rest of a connection, so that walking them touches as many cache lines.
+  char pad[512] = {};
+
+  LINK(Conn, open_link);
+  TIMING_WHEEL_LINK(Conn, timeout_link);
+};
+
+std::unique_ptr<Conn[]>
+make_conns(uint64_t now)
+{
+  std::unique_ptr<Conn[]> conns{new Conn[conf.nconn]};
+  std::minstd_rand        rng{13};
+
+  for (int i = 0; i < conf.nconn; ++i) {
+    conns[i].timeout_at = now + 1 + rng() % conf.timeout;
+  }
+  return conns;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of timeout check pass", "")
+{
+  SECTION("sweep of every connection")
+  {
+    auto     conns = make_conns(0);
+    uint64_t now   = 0;
+    Que(Conn, open_link) open_list;
+
+    for (int i = 0; i < conf.nconn; ++i) {
+      open_list.enqueue(&conns[i]);
+    }
+
+    BENCHMARK("sweep")
+    {
+      size_t n = 0;
+
+      ++now;
+      forl_LL(Conn, c, open_list)
+      {
+        if (c->timeout_at <= now) {
+          c->timeout_at = now + conf.timeout;
+          ++n;
+        }
+      }
+      return n;
+    };
+  }
+
+  SECTION("timing wheel advance")
+  {
+    auto                              conns = make_conns(0);
+    TimingWheelOf(Conn, timeout_link) wheel;
+
+    for (int i = 0; i < conf.nconn; ++i) {
+      wheel.schedule(&conns[i], conns[i].timeout_at);
+    }
+
+    BENCHMARK("wheel")
+    {
+      uint64_t now = wheel.now() + 1;
+
+      return wheel.advance(now, [&wheel, now](Conn *c) {
+        c->timeout_at = now + conf.timeout;
+        wheel.schedule(c, c->timeout_at);
+      });
+    };
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.nconn, "")["--ts-nconn"]("number of connections (default: 100000)") |
+    Opt(conf.timeout, "")["--ts-timeout"]("timeout in ticks (default: 300)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}